@@ -0,0 +1,635 @@
+#include "CommandList.h"
+
+#include <cstring>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        // Every packet starts with header, payload follows it and inline data follows payload.
+        // Packets are padded to 8 bytes, so payloads are always aligned
+        struct CommandHeader
+        {
+            CommandTypes Type;
+            Uint64 Size;
+        };
+
+        struct TargetCommand
+        {
+            RenderTarget* Target;
+        };
+
+        struct ClearCommand
+        {
+            Float32 Color[3];
+        };
+
+        struct UniformDataCommand
+        {
+            UniformBuffer* Buffer;
+            Uint64 Size;
+        };
+
+        struct IndirectDataCommand
+        {
+            IndirectBuffer* Buffer;
+            Uint64 CommandCount;
+        };
+
+        struct ShaderCommand
+        {
+            Shader* Program;
+        };
+
+        struct PipelineCommand
+        {
+            PipelineState* State;
+        };
+
+        // Names of bindings are hashed while recording, so they aren't kept in the list
+        struct UniformBindingCommand
+        {
+            Shader* Program;
+            ShaderBindingID Binding;
+            const UniformBuffer* Buffer;
+            Uint64 Offset;
+            Uint64 Size;
+            bool Whole;
+        };
+
+        struct TextureBindingCommand
+        {
+            Shader* Program;
+            ShaderBindingID Binding;
+            const void* Texture;
+        };
+
+        struct DrawCommand
+        {
+            PrimitiveToplogies Topology;
+            VertexBuffer* Vertices;
+            IndexBuffer* Indices;
+            VertexBuffer* Instances;
+            Uint64 InstanceCount;
+        };
+
+        struct IndirectDrawCommand
+        {
+            PrimitiveToplogies Topology;
+            VertexBuffer* Vertices;
+            IndexBuffer* Indices;
+            IndirectBuffer* Commands;
+            Uint64 FirstCommand;
+            Uint64 CommandCount;
+        };
+
+        struct CulledDrawCommand
+        {
+            PrimitiveToplogies Topology;
+            VertexBuffer* Vertices;
+            IndexBuffer* Indices;
+            CullingBatch* Batch;
+        };
+
+        struct CullCommand
+        {
+            CullingBatch* Batch;
+            Frustum Planes;
+        };
+
+        struct RangesDrawCommand
+        {
+            PrimitiveToplogies Topology;
+            VertexBuffer* Vertices;
+            IndexBuffer* Indices;
+            Uint64 RangesCount;
+        };
+
+        inline Uint64 AlignPacketSize(Uint64 size)
+        {
+            return (size + 7) & ~7ull;
+        }
+
+        template <typename t>
+        const t* GetPayload(const CommandHeader* header)
+        {
+            return reinterpret_cast<const t*>(header + 1);
+        }
+
+        template <typename t>
+        const void* GetInlineData(const CommandHeader* header)
+        {
+            return reinterpret_cast<const Uint8*>(header + 1) + AlignPacketSize(sizeof(t));
+        }
+    }
+
+    CommandList::CommandList(Allocator* allocator, Uint64 capacity)
+    {
+        m_allocator = allocator;
+
+        m_capacity = AlignPacketSize(MAX(capacity, sizeof(CommandHeader)));
+        m_size = 0;
+        m_commandCount = 0;
+        m_memory = reinterpret_cast<Uint8*>(m_allocator->AllocateMemory(m_capacity));
+    }
+
+    CommandList::~CommandList()
+    {
+        if (m_allocator != nullptr && m_memory != nullptr)
+            m_allocator->FreeMemory(m_memory);
+    }
+
+    void CommandList::Grow(Uint64 requiredSize)
+    {
+        Uint64 newCapacity = m_capacity * 2;
+
+        while (newCapacity < requiredSize)
+            newCapacity *= 2;
+
+        // Packets keep no pointers into the list, so they can be moved as they are
+        auto newMemory = reinterpret_cast<Uint8*>(m_allocator->AllocateMemory(newCapacity));
+
+        CopyMemory(newMemory, m_memory, m_size);
+        m_allocator->FreeMemory(m_memory);
+
+        m_memory = newMemory;
+        m_capacity = newCapacity;
+    }
+
+    void* CommandList::AddCommand(CommandTypes type, Uint64 payloadSize, Uint64 extraSize)
+    {
+        Uint64 packetSize = sizeof(CommandHeader) + AlignPacketSize(payloadSize) + AlignPacketSize(extraSize);
+
+        if (m_size + packetSize > m_capacity)
+            Grow(m_size + packetSize);
+
+        auto header = reinterpret_cast<CommandHeader*>(m_memory + m_size);
+        header->Type = type;
+        header->Size = packetSize;
+
+        m_size += packetSize;
+        m_commandCount++;
+
+        ZeroMemory(header + 1, packetSize - sizeof(CommandHeader));
+
+        return header + 1;
+    }
+
+    void CommandList::SetTarget(RenderTarget* renderTarget)
+    {
+        auto command = reinterpret_cast<TargetCommand*>(
+            AddCommand(CommandTypes::SetTarget, sizeof(TargetCommand)));
+
+        command->Target = renderTarget;
+    }
+
+    void CommandList::EnableDepthTest()
+    {
+        AddCommand(CommandTypes::EnableDepthTest, 0);
+    }
+
+    void CommandList::DisableDepthTest()
+    {
+        AddCommand(CommandTypes::DisableDepthTest, 0);
+    }
+
+    void CommandList::EnableStencilTest()
+    {
+        AddCommand(CommandTypes::EnableStencilTest, 0);
+    }
+
+    void CommandList::DisableStencilTest()
+    {
+        AddCommand(CommandTypes::DisableStencilTest, 0);
+    }
+
+    void CommandList::ClearTarget(Float32 red, Float32 green, Float32 blue)
+    {
+        auto command = reinterpret_cast<ClearCommand*>(
+            AddCommand(CommandTypes::ClearTarget, sizeof(ClearCommand)));
+
+        command->Color[0] = red;
+        command->Color[1] = green;
+        command->Color[2] = blue;
+    }
+
+    void CommandList::OverwriteBuffer(UniformBuffer* ubo, const void* newData, Uint64 newSize)
+    {
+        if (ubo == nullptr || newData == nullptr || newSize == 0)
+            return;
+
+        auto command = reinterpret_cast<UniformDataCommand*>(
+            AddCommand(CommandTypes::OverwriteUniformBuffer, sizeof(UniformDataCommand), newSize));
+
+        command->Buffer = ubo;
+        command->Size = newSize;
+
+        CopyMemory(reinterpret_cast<Uint8*>(command) + AlignPacketSize(sizeof(UniformDataCommand)),
+                   newData, newSize);
+    }
+
+    void CommandList::OverwriteBuffer(IndirectBuffer* buffer, const DrawIndexedCommand* commands,
+                                      Uint64 commandCount)
+    {
+        if (buffer == nullptr || commands == nullptr || commandCount == 0)
+            return;
+
+        Uint64 dataSize = commandCount * sizeof(DrawIndexedCommand);
+
+        auto command = reinterpret_cast<IndirectDataCommand*>(
+            AddCommand(CommandTypes::OverwriteIndirectBuffer, sizeof(IndirectDataCommand), dataSize));
+
+        command->Buffer = buffer;
+        command->CommandCount = commandCount;
+
+        CopyMemory(reinterpret_cast<Uint8*>(command) + AlignPacketSize(sizeof(IndirectDataCommand)),
+                   commands, dataSize);
+    }
+
+    void CommandList::BindShader(Shader* shader)
+    {
+        auto command = reinterpret_cast<ShaderCommand*>(
+            AddCommand(CommandTypes::BindShader, sizeof(ShaderCommand)));
+
+        command->Program = shader;
+    }
+
+    void CommandList::BindPipelineState(PipelineState* state)
+    {
+        auto command = reinterpret_cast<PipelineCommand*>(
+            AddCommand(CommandTypes::BindPipelineState, sizeof(PipelineCommand)));
+
+        command->State = state;
+    }
+
+    void CommandList::AddUniformBinding(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                                        Uint64 offset, Uint64 size, bool whole)
+    {
+        auto command = reinterpret_cast<UniformBindingCommand*>(
+            AddCommand(CommandTypes::BindShaderUniformBuffer, sizeof(UniformBindingCommand)));
+
+        command->Program = shader;
+        command->Binding = binding;
+        command->Buffer = ubo;
+        command->Offset = offset;
+        command->Size = size;
+        command->Whole = whole;
+    }
+
+    void CommandList::AddTextureBinding(CommandTypes type, Shader* shader, ShaderBindingID binding,
+                                        const void* texture)
+    {
+        auto command = reinterpret_cast<TextureBindingCommand*>(AddCommand(type, sizeof(TextureBindingCommand)));
+
+        command->Program = shader;
+        command->Binding = binding;
+        command->Texture = texture;
+    }
+
+    void CommandList::BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo)
+    {
+        AddUniformBinding(shader, MakeShaderBindingID(name), ubo, 0, 0, true);
+    }
+
+    void CommandList::BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo,
+                                              Uint64 offset, Uint64 size)
+    {
+        AddUniformBinding(shader, MakeShaderBindingID(name), ubo, offset, size, false);
+    }
+
+    void CommandList::BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo)
+    {
+        AddUniformBinding(shader, binding, ubo, 0, 0, true);
+    }
+
+    void CommandList::BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                                              Uint64 offset, Uint64 size)
+    {
+        AddUniformBinding(shader, binding, ubo, offset, size, false);
+    }
+
+    void CommandList::BindShaderTexture(Shader* shader, const char* name, const Texture1D* texture)
+    {
+        AddTextureBinding(CommandTypes::BindShaderTexture1D, shader, MakeShaderBindingID(name), texture);
+    }
+
+    void CommandList::BindShaderTexture(Shader* shader, const char* name, const Texture2D* texture)
+    {
+        AddTextureBinding(CommandTypes::BindShaderTexture2D, shader, MakeShaderBindingID(name), texture);
+    }
+
+    void CommandList::BindShaderTexture(Shader* shader, const char* name, const Texture3D* texture)
+    {
+        AddTextureBinding(CommandTypes::BindShaderTexture3D, shader, MakeShaderBindingID(name), texture);
+    }
+
+    void CommandList::BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture1D* texture)
+    {
+        AddTextureBinding(CommandTypes::BindShaderTexture1D, shader, binding, texture);
+    }
+
+    void CommandList::BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture2D* texture)
+    {
+        AddTextureBinding(CommandTypes::BindShaderTexture2D, shader, binding, texture);
+    }
+
+    void CommandList::BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture3D* texture)
+    {
+        AddTextureBinding(CommandTypes::BindShaderTexture3D, shader, binding, texture);
+    }
+
+    void CommandList::Draw(PrimitiveToplogies topology, VertexBuffer* vbo)
+    {
+        auto command = reinterpret_cast<DrawCommand*>(AddCommand(CommandTypes::Draw, sizeof(DrawCommand)));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+    }
+
+    void CommandList::DrawIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo)
+    {
+        auto command = reinterpret_cast<DrawCommand*>(
+            AddCommand(CommandTypes::DrawIndexed, sizeof(DrawCommand)));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+        command->Indices = ibo;
+    }
+
+    void CommandList::DrawInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, VertexBuffer* instances,
+                                    Uint64 instanceCount)
+    {
+        auto command = reinterpret_cast<DrawCommand*>(
+            AddCommand(CommandTypes::DrawInstanced, sizeof(DrawCommand)));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+        command->Instances = instances;
+        command->InstanceCount = instanceCount;
+    }
+
+    void CommandList::DrawIndexedInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                           VertexBuffer* instances, Uint64 instanceCount)
+    {
+        auto command = reinterpret_cast<DrawCommand*>(
+            AddCommand(CommandTypes::DrawIndexedInstanced, sizeof(DrawCommand)));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+        command->Indices = ibo;
+        command->Instances = instances;
+        command->InstanceCount = instanceCount;
+    }
+
+    void CommandList::DrawIndexedIndirect(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                          IndirectBuffer* commands, Uint64 firstCommand, Uint64 commandCount)
+    {
+        auto command = reinterpret_cast<IndirectDrawCommand*>(
+            AddCommand(CommandTypes::DrawIndexedIndirect, sizeof(IndirectDrawCommand)));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+        command->Indices = ibo;
+        command->Commands = commands;
+        command->FirstCommand = firstCommand;
+        command->CommandCount = commandCount;
+    }
+
+    void CommandList::CullBatch(CullingBatch* batch, const Frustum& frustum)
+    {
+        auto command = reinterpret_cast<CullCommand*>(AddCommand(CommandTypes::CullBatch, sizeof(CullCommand)));
+
+        command->Batch = batch;
+        command->Planes = frustum;
+    }
+
+    void CommandList::DrawCulledIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                        CullingBatch* batch)
+    {
+        auto command = reinterpret_cast<CulledDrawCommand*>(
+            AddCommand(CommandTypes::DrawCulledIndexed, sizeof(CulledDrawCommand)));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+        command->Indices = ibo;
+        command->Batch = batch;
+    }
+
+    void CommandList::DrawIndexedRanges(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                        const IndexBuffer::Range* ranges, Uint64 rangesCount)
+    {
+        if (ranges == nullptr || rangesCount == 0)
+            return;
+
+        Uint64 dataSize = rangesCount * sizeof(IndexBuffer::Range);
+
+        auto command = reinterpret_cast<RangesDrawCommand*>(
+            AddCommand(CommandTypes::DrawIndexedRanges, sizeof(RangesDrawCommand), dataSize));
+
+        command->Topology = topology;
+        command->Vertices = vbo;
+        command->Indices = ibo;
+        command->RangesCount = rangesCount;
+
+        CopyMemory(reinterpret_cast<Uint8*>(command) + AlignPacketSize(sizeof(RangesDrawCommand)),
+                   ranges, dataSize);
+    }
+
+    void CommandList::Execute(GraphicsContext* context) const
+    {
+        if (context == nullptr)
+            return;
+
+        Uint64 position = 0;
+
+        while (position < m_size)
+        {
+            auto header = reinterpret_cast<const CommandHeader*>(m_memory + position);
+            position += header->Size;
+
+            switch (header->Type)
+            {
+                case CommandTypes::SetTarget:
+                {
+                    RenderTarget* target = GetPayload<TargetCommand>(header)->Target;
+
+                    if (target == nullptr)
+                        context->SetTarget();
+                    else
+                        context->SetTarget(target);
+
+                    break;
+                }
+
+                case CommandTypes::EnableDepthTest:
+                    context->EnableDepthTest();
+                    break;
+
+                case CommandTypes::DisableDepthTest:
+                    context->DisableDepthTest();
+                    break;
+
+                case CommandTypes::EnableStencilTest:
+                    context->EnableStencilTest();
+                    break;
+
+                case CommandTypes::DisableStencilTest:
+                    context->DisableStencilTest();
+                    break;
+
+                case CommandTypes::ClearTarget:
+                {
+                    auto command = GetPayload<ClearCommand>(header);
+                    context->ClearTarget(command->Color[0], command->Color[1], command->Color[2]);
+                    break;
+                }
+
+                case CommandTypes::OverwriteUniformBuffer:
+                {
+                    auto command = GetPayload<UniformDataCommand>(header);
+                    context->OverwriteBuffer(command->Buffer, GetInlineData<UniformDataCommand>(header),
+                                             command->Size);
+                    break;
+                }
+
+                case CommandTypes::OverwriteIndirectBuffer:
+                {
+                    auto command = GetPayload<IndirectDataCommand>(header);
+                    auto commands = reinterpret_cast<const DrawIndexedCommand*>(
+                        GetInlineData<IndirectDataCommand>(header));
+
+                    context->OverwriteBuffer(command->Buffer, commands, command->CommandCount);
+                    break;
+                }
+
+                case CommandTypes::BindShader:
+                    context->BindShader(GetPayload<ShaderCommand>(header)->Program);
+                    break;
+
+                case CommandTypes::BindPipelineState:
+                    context->BindPipelineState(GetPayload<PipelineCommand>(header)->State);
+                    break;
+
+                case CommandTypes::BindShaderUniformBuffer:
+                {
+                    auto command = GetPayload<UniformBindingCommand>(header);
+
+                    if (command->Whole)
+                        context->BindShaderUniformBuffer(command->Program, command->Binding, command->Buffer);
+                    else
+                        context->BindShaderUniformBuffer(command->Program, command->Binding, command->Buffer,
+                                                         command->Offset, command->Size);
+
+                    break;
+                }
+
+                case CommandTypes::BindShaderTexture1D:
+                {
+                    auto command = GetPayload<TextureBindingCommand>(header);
+
+                    context->BindShaderTexture(command->Program, command->Binding,
+                                               reinterpret_cast<const Texture1D*>(command->Texture));
+                    break;
+                }
+
+                case CommandTypes::BindShaderTexture2D:
+                {
+                    auto command = GetPayload<TextureBindingCommand>(header);
+
+                    context->BindShaderTexture(command->Program, command->Binding,
+                                               reinterpret_cast<const Texture2D*>(command->Texture));
+                    break;
+                }
+
+                case CommandTypes::BindShaderTexture3D:
+                {
+                    auto command = GetPayload<TextureBindingCommand>(header);
+
+                    context->BindShaderTexture(command->Program, command->Binding,
+                                               reinterpret_cast<const Texture3D*>(command->Texture));
+                    break;
+                }
+
+                case CommandTypes::Draw:
+                {
+                    auto command = GetPayload<DrawCommand>(header);
+                    context->Draw(command->Topology, command->Vertices);
+                    break;
+                }
+
+                case CommandTypes::DrawIndexed:
+                {
+                    auto command = GetPayload<DrawCommand>(header);
+                    context->DrawIndexed(command->Topology, command->Vertices, command->Indices);
+                    break;
+                }
+
+                case CommandTypes::DrawInstanced:
+                {
+                    auto command = GetPayload<DrawCommand>(header);
+                    context->DrawInstanced(command->Topology, command->Vertices, command->Instances,
+                                           command->InstanceCount);
+                    break;
+                }
+
+                case CommandTypes::DrawIndexedInstanced:
+                {
+                    auto command = GetPayload<DrawCommand>(header);
+                    context->DrawIndexedInstanced(command->Topology, command->Vertices, command->Indices,
+                                                  command->Instances, command->InstanceCount);
+                    break;
+                }
+
+                case CommandTypes::DrawIndexedIndirect:
+                {
+                    auto command = GetPayload<IndirectDrawCommand>(header);
+                    context->DrawIndexedIndirect(command->Topology, command->Vertices, command->Indices,
+                                                 command->Commands, command->FirstCommand, command->CommandCount);
+                    break;
+                }
+
+                case CommandTypes::DrawCulledIndexed:
+                {
+                    auto command = GetPayload<CulledDrawCommand>(header);
+                    context->DrawCulledIndexed(command->Topology, command->Vertices, command->Indices,
+                                               command->Batch);
+                    break;
+                }
+
+                case CommandTypes::DrawIndexedRanges:
+                {
+                    auto command = GetPayload<RangesDrawCommand>(header);
+                    auto ranges = reinterpret_cast<const IndexBuffer::Range*>(
+                        GetInlineData<RangesDrawCommand>(header));
+
+                    context->DrawIndexedRanges(command->Topology, command->Vertices, command->Indices,
+                                               ranges, command->RangesCount);
+                    break;
+                }
+
+                case CommandTypes::CullBatch:
+                {
+                    auto command = GetPayload<CullCommand>(header);
+                    context->CullBatch(command->Batch, command->Planes);
+                    break;
+                }
+            }
+        }
+    }
+
+    void CommandList::Reset()
+    {
+        m_size = 0;
+        m_commandCount = 0;
+    }
+
+    Uint64 CommandList::GetCommandCount() const
+    {
+        return m_commandCount;
+    }
+
+    Uint64 CommandList::GetSize() const
+    {
+        return m_size;
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    enum class CommandTypes : Uint64
+    {
+        SetTarget,
+        EnableDepthTest,
+        DisableDepthTest,
+        EnableStencilTest,
+        DisableStencilTest,
+        ClearTarget,
+
+        OverwriteUniformBuffer,
+        OverwriteIndirectBuffer,
+
+        BindShader,
+        BindPipelineState,
+        BindShaderUniformBuffer,
+        BindShaderTexture1D,
+        BindShaderTexture2D,
+        BindShaderTexture3D,
+
+        Draw,
+        DrawIndexed,
+        DrawInstanced,
+        DrawIndexedInstanced,
+        DrawIndexedIndirect,
+        DrawCulledIndexed,
+        DrawIndexedRanges,
+
+        CullBatch,
+    };
+
+    // Records calls of graphics context into one linear block of memory, so it can be filled on any thread
+    // (one list is recorded by one thread at a time) and replayed later by GraphicsContext::Submit.
+    // Recording doesn't touch the context at all. Data which is given by pointer (uniform data, draw commands,
+    // ranges) is copied into the list, graphics objects are kept by pointer and have to live
+    // until the list is submitted
+    class CommandList
+    {
+    private:
+        Uint8* m_memory;
+        Uint64 m_size;
+        Uint64 m_capacity;
+        Uint64 m_commandCount;
+
+        Allocator* m_allocator;
+
+        // Returns zeroed payload of packet with extraSize bytes of inline data right after it
+        void* AddCommand(CommandTypes type, Uint64 payloadSize, Uint64 extraSize = 0);
+
+        void AddTextureBinding(CommandTypes type, Shader* shader, ShaderBindingID binding, const void* texture);
+        void AddUniformBinding(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                               Uint64 offset, Uint64 size, bool whole);
+
+        void Grow(Uint64 requiredSize);
+
+    public:
+        CommandList(Allocator* allocator, Uint64 capacity = 4096);
+        ~CommandList();
+
+        CommandList(const CommandList&) = delete;
+        CommandList& operator=(const CommandList&) = delete;
+
+        // Nullptr means default target
+        void SetTarget(RenderTarget* renderTarget);
+
+        void EnableDepthTest();
+        void DisableDepthTest();
+
+        void EnableStencilTest();
+        void DisableStencilTest();
+
+        void ClearTarget(Float32 red, Float32 green, Float32 blue);
+
+        void OverwriteBuffer(UniformBuffer* ubo, const void* newData, Uint64 newSize);
+        void OverwriteBuffer(IndirectBuffer* buffer, const DrawIndexedCommand* commands, Uint64 commandCount);
+
+        void BindShader(Shader* shader);
+        void BindPipelineState(PipelineState* state);
+        void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo);
+        void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo,
+                                     Uint64 offset, Uint64 size);
+
+        void BindShaderTexture(Shader* shader, const char* name, const Texture1D* texture);
+        void BindShaderTexture(Shader* shader, const char* name, const Texture2D* texture);
+        void BindShaderTexture(Shader* shader, const char* name, const Texture3D* texture);
+
+        void BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo);
+        void BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                                     Uint64 offset, Uint64 size);
+
+        void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture1D* texture);
+        void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture2D* texture);
+        void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture3D* texture);
+
+        void Draw(PrimitiveToplogies topology, VertexBuffer* vbo);
+        void DrawIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo);
+
+        void DrawInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, VertexBuffer* instances,
+                           Uint64 instanceCount);
+        void DrawIndexedInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                  VertexBuffer* instances, Uint64 instanceCount);
+
+        void DrawIndexedIndirect(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                 IndirectBuffer* commands, Uint64 firstCommand, Uint64 commandCount);
+
+        void CullBatch(CullingBatch* batch, const Frustum& frustum);
+        void DrawCulledIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                               CullingBatch* batch);
+
+        void DrawIndexedRanges(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                               const IndexBuffer::Range* ranges, Uint64 rangesCount);
+
+        // Calls recorded commands on context in the same order (it has to be called on context's thread)
+        void Execute(GraphicsContext* context) const;
+
+        // Drops recorded commands, memory is kept for the next frame
+        void Reset();
+
+        Uint64 GetCommandCount() const;
+        Uint64 GetSize() const;
+    };
+}
@@ -0,0 +1,237 @@
+#include "Culling.h"
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        static const Uint64 CullingStreamsCount = 7;
+
+        // For every 8-bit mask of visible lanes: permutation which moves visible lanes to the front and their count
+        struct CompactionTable
+        {
+            Int32 Permutations[256][8];
+            Uint32 Counts[256];
+        };
+
+        const CompactionTable& GetCompactionTable()
+        {
+            static const CompactionTable table = []()
+            {
+                CompactionTable result;
+
+                for (Uint32 mask = 0; mask < 256; mask++)
+                {
+                    Uint32 count = 0;
+
+                    for (Int32 lane = 0; lane < 8; lane++)
+                    {
+                        if (mask & (1 << lane))
+                            result.Permutations[mask][count++] = lane;
+                    }
+
+                    for (Uint32 lane = count; lane < 8; lane++)
+                        result.Permutations[mask][lane] = 0;
+
+                    result.Counts[mask] = count;
+                }
+
+                return result;
+            }();
+
+            return table;
+        }
+    }
+
+    bool CreateCullingBounds(CullingBounds& bounds, Uint64 capacity, Allocator* allocator)
+    {
+        if (capacity == 0 || allocator == nullptr)
+            return false;
+
+        Uint64 paddedCapacity = (capacity + 7) & ~7ull;
+
+        auto streams = reinterpret_cast<Float32*>(
+            allocator->AllocateMemory(paddedCapacity * CullingStreamsCount * sizeof(Float32)));
+
+        // Padding objects are empty spheres at zero which are never written into visible indices
+        memset(streams, 0, paddedCapacity * CullingStreamsCount * sizeof(Float32));
+
+        bounds.CenterX = streams;
+        bounds.CenterY = streams + paddedCapacity;
+        bounds.CenterZ = streams + paddedCapacity * 2;
+        bounds.ExtentX = streams + paddedCapacity * 3;
+        bounds.ExtentY = streams + paddedCapacity * 4;
+        bounds.ExtentZ = streams + paddedCapacity * 5;
+        bounds.Radius = streams + paddedCapacity * 6;
+
+        bounds.Count = 0;
+        bounds.Capacity = capacity;
+
+        return true;
+    }
+
+    void ReleaseCullingBounds(CullingBounds& bounds, Allocator* allocator)
+    {
+        // All of the streams are in one block which starts with centers
+        if (bounds.CenterX != nullptr)
+            allocator->FreeMemory(bounds.CenterX);
+
+        bounds = CullingBounds{};
+    }
+
+    Uint64 AddBoxBounds(CullingBounds& bounds, const Float32* center, const Float32* extent)
+    {
+        if (bounds.Count == bounds.Capacity)
+            return InvalidCullingIndex;
+
+        Uint64 index = bounds.Count++;
+        SetBoxBounds(bounds, index, center, extent);
+
+        return index;
+    }
+
+    Uint64 AddSphereBounds(CullingBounds& bounds, const Float32* center, Float32 radius)
+    {
+        if (bounds.Count == bounds.Capacity)
+            return InvalidCullingIndex;
+
+        Uint64 index = bounds.Count++;
+        SetSphereBounds(bounds, index, center, radius);
+
+        return index;
+    }
+
+    void SetBoxBounds(CullingBounds& bounds, Uint64 index, const Float32* center, const Float32* extent)
+    {
+        bounds.CenterX[index] = center[0];
+        bounds.CenterY[index] = center[1];
+        bounds.CenterZ[index] = center[2];
+        bounds.ExtentX[index] = extent[0];
+        bounds.ExtentY[index] = extent[1];
+        bounds.ExtentZ[index] = extent[2];
+        bounds.Radius[index] = 0.0f;
+    }
+
+    void SetSphereBounds(CullingBounds& bounds, Uint64 index, const Float32* center, Float32 radius)
+    {
+        bounds.CenterX[index] = center[0];
+        bounds.CenterY[index] = center[1];
+        bounds.CenterZ[index] = center[2];
+        bounds.ExtentX[index] = 0.0f;
+        bounds.ExtentY[index] = 0.0f;
+        bounds.ExtentZ[index] = 0.0f;
+        bounds.Radius[index] = radius;
+    }
+
+    Uint64 RemoveBounds(CullingBounds& bounds, Uint64 index)
+    {
+        if (bounds.Count == 0 || index >= bounds.Count)
+            return index;
+
+        Uint64 last = bounds.Count - 1;
+
+        bounds.CenterX[index] = bounds.CenterX[last];
+        bounds.CenterY[index] = bounds.CenterY[last];
+        bounds.CenterZ[index] = bounds.CenterZ[last];
+        bounds.ExtentX[index] = bounds.ExtentX[last];
+        bounds.ExtentY[index] = bounds.ExtentY[last];
+        bounds.ExtentZ[index] = bounds.ExtentZ[last];
+        bounds.Radius[index] = bounds.Radius[last];
+
+        bounds.Count--;
+
+        return last;
+    }
+
+    Uint64 CullBounds(Uint32* visible, const CullingBounds& bounds, const Frustum& frustum, Uint64 begin, Uint64 end)
+    {
+        end = MIN(end, bounds.Count);
+
+        if (visible == nullptr || begin >= end)
+            return 0;
+
+        const CompactionTable& table = GetCompactionTable();
+
+        __m256 normalX[Frustum::PlanesCount];
+        __m256 normalY[Frustum::PlanesCount];
+        __m256 normalZ[Frustum::PlanesCount];
+        __m256 absoluteX[Frustum::PlanesCount];
+        __m256 absoluteY[Frustum::PlanesCount];
+        __m256 absoluteZ[Frustum::PlanesCount];
+        __m256 distance[Frustum::PlanesCount];
+
+        for (Uint64 i = 0; i < Frustum::PlanesCount; i++)
+        {
+            const Plane& plane = frustum.Planes[i];
+
+            normalX[i] = _mm256_set1_ps(plane.Normal[0]);
+            normalY[i] = _mm256_set1_ps(plane.Normal[1]);
+            normalZ[i] = _mm256_set1_ps(plane.Normal[2]);
+            absoluteX[i] = _mm256_set1_ps(std::fabs(plane.Normal[0]));
+            absoluteY[i] = _mm256_set1_ps(std::fabs(plane.Normal[1]));
+            absoluteZ[i] = _mm256_set1_ps(std::fabs(plane.Normal[2]));
+            distance[i] = _mm256_set1_ps(plane.Distance);
+        }
+
+        Uint64 visibleCount = 0;
+
+        // Blocks start at multiple of 8, lanes out of the slice are masked
+        Uint64 first = begin & ~7ull;
+
+        __m256i laneIndices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        for (Uint64 i = first; i < end; i += 8)
+        {
+            __m256 centerX = _mm256_loadu_ps(bounds.CenterX + i);
+            __m256 centerY = _mm256_loadu_ps(bounds.CenterY + i);
+            __m256 centerZ = _mm256_loadu_ps(bounds.CenterZ + i);
+            __m256 extentX = _mm256_loadu_ps(bounds.ExtentX + i);
+            __m256 extentY = _mm256_loadu_ps(bounds.ExtentY + i);
+            __m256 extentZ = _mm256_loadu_ps(bounds.ExtentZ + i);
+            __m256 radius = _mm256_loadu_ps(bounds.Radius + i);
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (Uint64 j = 0; j < Frustum::PlanesCount; j++)
+            {
+                // Signed distance from center plus projection of the box and the sphere on plane's normal
+                __m256 d = _mm256_add_ps(_mm256_mul_ps(centerX, normalX[j]), _mm256_mul_ps(centerY, normalY[j]));
+                d = _mm256_add_ps(d, _mm256_mul_ps(centerZ, normalZ[j]));
+                d = _mm256_add_ps(d, distance[j]);
+
+                __m256 r = _mm256_add_ps(_mm256_mul_ps(extentX, absoluteX[j]), _mm256_mul_ps(extentY, absoluteY[j]));
+                r = _mm256_add_ps(r, _mm256_mul_ps(extentZ, absoluteZ[j]));
+                r = _mm256_add_ps(r, radius);
+
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+
+            Uint32 mask = static_cast<Uint32>(_mm256_movemask_ps(inside));
+
+            if (i < begin)
+                mask &= ~0u << (begin - i);
+
+            if (i + 8 > end)
+                mask &= (1u << (end - i)) - 1;
+
+            __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.Permutations[mask]));
+            __m256i indices = _mm256_add_epi32(_mm256_set1_epi32(static_cast<Int32>(i)), laneIndices);
+
+            // All of 8 lanes are written, only the visible ones are kept
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(visible + visibleCount),
+                                _mm256_permutevar8x32_epi32(indices, permutation));
+
+            visibleCount += table.Counts[mask];
+        }
+
+        return visibleCount;
+    }
+
+    Uint64 CullBounds(Uint32* visible, const CullingBounds& bounds, const Frustum& frustum)
+    {
+        return CullBounds(visible, bounds, frustum, 0, bounds.Count);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Memory.h"
+#include "Frustum.h"
+
+namespace Tiny3D
+{
+    // Bounds of objects in SoA layout. Every object has a box and a sphere around the same center,
+    // boxes have zero radius and spheres have zero extent, so both of them are tested in the same way.
+    // Arrays are padded to 8 elements for AVX2
+
+    static const Uint64 InvalidCullingIndex = ~0ull;
+
+    struct CullingBounds
+    {
+        Float32* CenterX;
+        Float32* CenterY;
+        Float32* CenterZ;
+
+        Float32* ExtentX;
+        Float32* ExtentY;
+        Float32* ExtentZ;
+
+        Float32* Radius;
+
+        Uint64 Count;
+        Uint64 Capacity;
+    };
+
+    bool CreateCullingBounds(CullingBounds& bounds, Uint64 capacity, Allocator* allocator);
+    void ReleaseCullingBounds(CullingBounds& bounds, Allocator* allocator);
+
+    // Return index of added object or InvalidCullingIndex if there is no space
+    Uint64 AddBoxBounds(CullingBounds& bounds, const Float32* center, const Float32* extent);
+    Uint64 AddSphereBounds(CullingBounds& bounds, const Float32* center, Float32 radius);
+
+    void SetBoxBounds(CullingBounds& bounds, Uint64 index, const Float32* center, const Float32* extent);
+    void SetSphereBounds(CullingBounds& bounds, Uint64 index, const Float32* center, Float32 radius);
+
+    // The last object is moved into the place of removed one, returns its old index (or given index
+    // when there is nothing to remove)
+    Uint64 RemoveBounds(CullingBounds& bounds, Uint64 index);
+
+    // Tests objects from begin to end (not including) and writes indices of visible ones into visible,
+    // which must have space for (end - begin + 8) indices. Returns the count of visible objects.
+    // Slices of the same bounds can be culled by different threads into different arrays
+    Uint64 CullBounds(Uint32* visible, const CullingBounds& bounds, const Frustum& frustum, Uint64 begin, Uint64 end);
+
+    Uint64 CullBounds(Uint32* visible, const CullingBounds& bounds, const Frustum& frustum);
+}
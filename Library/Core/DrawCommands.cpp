@@ -0,0 +1,71 @@
+#include "DrawCommands.h"
+
+namespace Tiny3D
+{
+    DrawCommandBuilder::DrawCommandBuilder(Allocator* allocator, Uint64 capacity)
+    {
+        m_allocator = allocator;
+
+        m_capacity = MAX(capacity, 1);
+        m_commandCount = 0;
+        m_commands = reinterpret_cast<DrawIndexedCommand*>(
+            m_allocator->AllocateMemory(m_capacity * sizeof(DrawIndexedCommand)));
+    }
+
+    DrawCommandBuilder::~DrawCommandBuilder()
+    {
+        if (m_allocator != nullptr && m_commands != nullptr)
+            m_allocator->FreeMemory(m_commands);
+    }
+
+    void DrawCommandBuilder::Grow()
+    {
+        Uint64 newCapacity = m_capacity * 2;
+
+        auto newCommands = reinterpret_cast<DrawIndexedCommand*>(
+            m_allocator->AllocateMemory(newCapacity * sizeof(DrawIndexedCommand)));
+
+        CopyMemory(newCommands, m_commands, m_commandCount * sizeof(DrawIndexedCommand));
+        m_allocator->FreeMemory(m_commands);
+
+        m_commands = newCommands;
+        m_capacity = newCapacity;
+    }
+
+    void DrawCommandBuilder::Append(const IndexBuffer* ibo, Uint32 instanceCount, Uint32 firstIndex,
+                                    Int32 baseVertex, Uint32 baseInstance)
+    {
+        if (ibo == nullptr)
+            return;
+
+        if (ibo->GetRangesCount() == 0)
+        {
+            Append(static_cast<Uint32>(ibo->GetIndexCount()), instanceCount, firstIndex, baseVertex, baseInstance);
+            return;
+        }
+
+        for (Uint64 i = 0; i < ibo->GetRangesCount(); i++)
+        {
+            const IndexBuffer::Range& range = ibo->GetRanges()[i];
+
+            Append(static_cast<Uint32>(range.IndexCount), instanceCount,
+                   firstIndex + static_cast<Uint32>(range.FirstIndex),
+                   baseVertex + static_cast<Int32>(range.BaseVertex), baseInstance);
+        }
+    }
+
+    void DrawCommandBuilder::Clear()
+    {
+        m_commandCount = 0;
+    }
+
+    const DrawIndexedCommand* DrawCommandBuilder::GetCommands() const
+    {
+        return m_commands;
+    }
+
+    Uint64 DrawCommandBuilder::GetCommandCount() const
+    {
+        return m_commandCount;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    // Collects draw commands on CPU side before they are written into IndirectBuffer.
+    // Appending is inline and doesn't call graphics context, so it costs as much as writing 20 bytes
+    class DrawCommandBuilder
+    {
+    private:
+        DrawIndexedCommand* m_commands;
+        Uint64 m_commandCount;
+        Uint64 m_capacity;
+
+        Allocator* m_allocator;
+
+        void Grow();
+
+    public:
+        DrawCommandBuilder(Allocator* allocator, Uint64 capacity = 256);
+        ~DrawCommandBuilder();
+
+        DrawCommandBuilder(const DrawCommandBuilder&) = delete;
+        DrawCommandBuilder& operator=(const DrawCommandBuilder&) = delete;
+
+        void Append(Uint32 indexCount, Uint32 instanceCount, Uint32 firstIndex, Int32 baseVertex, Uint32 baseInstance)
+        {
+            if (m_commandCount == m_capacity)
+                Grow();
+
+            DrawIndexedCommand& command = m_commands[m_commandCount++];
+
+            command.IndexCount = indexCount;
+            command.InstanceCount = instanceCount;
+            command.FirstIndex = firstIndex;
+            command.BaseVertex = baseVertex;
+            command.BaseInstance = baseInstance;
+        }
+
+        void Append(const DrawIndexedCommand& command)
+        {
+            if (m_commandCount == m_capacity)
+                Grow();
+
+            m_commands[m_commandCount++] = command;
+        }
+
+        // Appends the whole index buffer (one command per range of narrowed buffer) placed at
+        // firstIndex and baseVertex of shared buffers. Indirect buffer with commands of split buffer
+        // is created with IndirectBuffer::Desc::SplitRanges
+        void Append(const IndexBuffer* ibo, Uint32 instanceCount, Uint32 firstIndex, Int32 baseVertex,
+                    Uint32 baseInstance);
+
+        void Clear();
+
+        const DrawIndexedCommand* GetCommands() const;
+        Uint64 GetCommandCount() const;
+    };
+}
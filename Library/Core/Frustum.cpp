@@ -0,0 +1,71 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+namespace Tiny3D
+{
+    Frustum MakeFrustum(const Float32* matrix)
+    {
+        Frustum frustum;
+
+        // Plane is a sum or a difference of the fourth row and one of the others
+        static const Uint64 rows[Frustum::PlanesCount] = {0, 0, 1, 1, 2, 2};
+        static const Float32 signs[Frustum::PlanesCount] = {1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f};
+
+        for (Uint64 i = 0; i < Frustum::PlanesCount; i++)
+        {
+            Float32 coefficients[4];
+
+            for (Uint64 j = 0; j < 4; j++)
+                coefficients[j] = matrix[j * 4 + 3] + signs[i] * matrix[j * 4 + rows[i]];
+
+            Float32 length = std::sqrt(coefficients[0] * coefficients[0] + coefficients[1] * coefficients[1] +
+                                       coefficients[2] * coefficients[2]);
+
+            Float32 scale = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+            frustum.Planes[i].Normal[0] = coefficients[0] * scale;
+            frustum.Planes[i].Normal[1] = coefficients[1] * scale;
+            frustum.Planes[i].Normal[2] = coefficients[2] * scale;
+            frustum.Planes[i].Distance = coefficients[3] * scale;
+        }
+
+        return frustum;
+    }
+
+    bool IsSphereInFrustum(const Frustum& frustum, const Float32* center, Float32 radius)
+    {
+        for (Uint64 i = 0; i < Frustum::PlanesCount; i++)
+        {
+            const Plane& plane = frustum.Planes[i];
+
+            Float32 distance = plane.Normal[0] * center[0] + plane.Normal[1] * center[1] +
+                               plane.Normal[2] * center[2] + plane.Distance;
+
+            if (distance < -radius)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool IsBoxInFrustum(const Frustum& frustum, const Float32* center, const Float32* extent)
+    {
+        for (Uint64 i = 0; i < Frustum::PlanesCount; i++)
+        {
+            const Plane& plane = frustum.Planes[i];
+
+            Float32 distance = plane.Normal[0] * center[0] + plane.Normal[1] * center[1] +
+                               plane.Normal[2] * center[2] + plane.Distance;
+
+            // Projection of the box on plane's normal
+            Float32 radius = std::fabs(plane.Normal[0]) * extent[0] + std::fabs(plane.Normal[1]) * extent[1] +
+                             std::fabs(plane.Normal[2]) * extent[2];
+
+            if (distance < -radius)
+                return false;
+        }
+
+        return true;
+    }
+}
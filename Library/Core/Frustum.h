@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Utils.h"
+
+namespace Tiny3D
+{
+    // Points with Dot(Normal, point) + Distance >= 0 are on the inner side of plane
+    struct Plane
+    {
+        Float32 Normal[3];
+        Float32 Distance;
+    };
+
+    // Order of planes in Frustum::Planes
+    enum class FrustumPlanes : Uint64
+    {
+        LeftPlane = 0,
+        RightPlane,
+        BottomPlane,
+        TopPlane,
+        NearPlane,
+        FarPlane,
+    };
+
+    struct Frustum
+    {
+        static const Uint64 PlanesCount = 6;
+
+        Plane Planes[PlanesCount];
+    };
+
+    // Extracts normalized planes from column-major matrix (OpenGL convention, depth from -1 to 1).
+    // View-projection matrix gives world-space frustum, model-view-projection matrix gives object-space one
+    Frustum MakeFrustum(const Float32* matrix);
+
+    bool IsSphereInFrustum(const Frustum& frustum, const Float32* center, Float32 radius);
+    bool IsBoxInFrustum(const Frustum& frustum, const Float32* center, const Float32* extent);
+}
@@ -0,0 +1,786 @@
+#include "GeometryPool.h"
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Tiny3D
+{
+    namespace
+    {
+        template <typename t>
+        t* AllocateArray(Allocator* allocator, Uint64 count)
+        {
+            return reinterpret_cast<t*>(allocator->AllocateMemory(MAX(count, 1) * sizeof(t)));
+        }
+
+        GeometryID MakeGeometryID(Uint64 index, Uint32 generation)
+        {
+            return (static_cast<Uint64>(generation) << 32) | index;
+        }
+
+        // Index of the highest set bit (value isn't zero)
+        Uint64 FindLastBit(Uint64 value)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return index;
+#else
+            return 63 - __builtin_clzll(value);
+#endif
+        }
+
+        // Index of the lowest set bit (value isn't zero)
+        Uint64 FindFirstBit(Uint64 value)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return index;
+#else
+            return __builtin_ctzll(value);
+#endif
+        }
+    }
+
+    RangeAllocator::RangeAllocator(Allocator* allocator, Uint64 capacity)
+    {
+        m_allocator = allocator;
+
+        m_capacity = capacity;
+        m_usedSize = 0;
+        m_freeBlockCount = 0;
+
+        m_firstLevelMap = 0;
+        SetMemory(m_secondLevelMaps, sizeof(m_secondLevelMaps), 0);
+        SetMemory(m_freeLists, sizeof(m_freeLists), 0xFF);
+
+        m_blockCapacity = 64;
+        m_blocks = AllocateArray<Block>(m_allocator, m_blockCapacity);
+
+        for (Uint32 i = 0; i < m_blockCapacity; i++)
+            m_blocks[i].NextFree = (i + 1 < m_blockCapacity) ? i + 1 : InvalidBlock;
+
+        m_unusedBlock = 0;
+        m_firstBlock = InvalidBlock;
+
+        if (capacity == 0)
+            return;
+
+        // The whole range is one free block at the start
+        Uint32 block = AcquireBlock();
+
+        m_blocks[block].Offset = 0;
+        m_blocks[block].Size = capacity;
+        m_blocks[block].UserData = 0;
+        m_blocks[block].PreviousPhysical = InvalidBlock;
+        m_blocks[block].NextPhysical = InvalidBlock;
+
+        m_firstBlock = block;
+
+        InsertFreeBlock(block);
+    }
+
+    RangeAllocator::~RangeAllocator()
+    {
+        if (m_allocator != nullptr)
+            m_allocator->FreeMemory(m_blocks);
+    }
+
+    void RangeAllocator::MapSize(Uint64 size, Uint64& firstLevel, Uint64& secondLevel)
+    {
+        // Small sizes have classes of their own, bigger ones are split into SecondLevelCount classes per power of two
+        if (size < SecondLevelCount)
+        {
+            firstLevel = 0;
+            secondLevel = size;
+            return;
+        }
+
+        Uint64 bit = FindLastBit(size);
+
+        firstLevel = bit - SecondLevelLog2 + 1;
+        secondLevel = (size >> (bit - SecondLevelLog2)) - SecondLevelCount;
+    }
+
+    Uint32 RangeAllocator::AcquireBlock()
+    {
+        if (m_unusedBlock == InvalidBlock)
+        {
+            Uint32 newCapacity = m_blockCapacity * 2;
+
+            auto newBlocks = AllocateArray<Block>(m_allocator, newCapacity);
+            CopyMemory(newBlocks, m_blocks, m_blockCapacity * sizeof(Block));
+
+            m_allocator->FreeMemory(m_blocks);
+
+            for (Uint32 i = m_blockCapacity; i < newCapacity; i++)
+                newBlocks[i].NextFree = (i + 1 < newCapacity) ? i + 1 : InvalidBlock;
+
+            m_unusedBlock = m_blockCapacity;
+
+            m_blocks = newBlocks;
+            m_blockCapacity = newCapacity;
+        }
+
+        Uint32 block = m_unusedBlock;
+        m_unusedBlock = m_blocks[block].NextFree;
+
+        return block;
+    }
+
+    void RangeAllocator::ReleaseBlock(Uint32 block)
+    {
+        m_blocks[block].NextFree = m_unusedBlock;
+        m_unusedBlock = block;
+    }
+
+    void RangeAllocator::InsertFreeBlock(Uint32 block)
+    {
+        Uint64 firstLevel, secondLevel;
+        MapSize(m_blocks[block].Size, firstLevel, secondLevel);
+
+        Uint32 head = m_freeLists[firstLevel][secondLevel];
+
+        m_blocks[block].Free = true;
+        m_blocks[block].PreviousFree = InvalidBlock;
+        m_blocks[block].NextFree = head;
+
+        if (head != InvalidBlock)
+            m_blocks[head].PreviousFree = block;
+
+        m_freeLists[firstLevel][secondLevel] = block;
+
+        m_firstLevelMap |= 1ull << firstLevel;
+        m_secondLevelMaps[firstLevel] |= 1u << secondLevel;
+
+        m_freeBlockCount++;
+    }
+
+    void RangeAllocator::RemoveFreeBlock(Uint32 block)
+    {
+        Uint64 firstLevel, secondLevel;
+        MapSize(m_blocks[block].Size, firstLevel, secondLevel);
+
+        Uint32 previous = m_blocks[block].PreviousFree;
+        Uint32 next = m_blocks[block].NextFree;
+
+        if (previous != InvalidBlock)
+            m_blocks[previous].NextFree = next;
+        else
+            m_freeLists[firstLevel][secondLevel] = next;
+
+        if (next != InvalidBlock)
+            m_blocks[next].PreviousFree = previous;
+
+        if (m_freeLists[firstLevel][secondLevel] == InvalidBlock)
+        {
+            m_secondLevelMaps[firstLevel] &= ~(1u << secondLevel);
+
+            if (m_secondLevelMaps[firstLevel] == 0)
+                m_firstLevelMap &= ~(1ull << firstLevel);
+        }
+
+        m_blocks[block].Free = false;
+        m_freeBlockCount--;
+    }
+
+    Uint32 RangeAllocator::FindFreeBlock(Uint64 size) const
+    {
+        Uint64 firstLevel, secondLevel;
+
+        // Size is rounded up to the next class, so any block of the found class fits
+        Uint64 roundedSize = size;
+
+        if (size >= SecondLevelCount)
+            roundedSize += (1ull << (FindLastBit(size) - SecondLevelLog2)) - 1;
+
+        MapSize(roundedSize, firstLevel, secondLevel);
+
+        Uint64 secondLevelMap = m_secondLevelMaps[firstLevel] & (~0u << secondLevel);
+
+        if (secondLevelMap == 0)
+        {
+            Uint64 firstLevelMap = (firstLevel + 1 < FirstLevelCount) ? m_firstLevelMap & (~0ull << (firstLevel + 1))
+                                                                        : 0;
+
+            if (firstLevelMap != 0)
+            {
+                firstLevel = FindFirstBit(firstLevelMap);
+                secondLevelMap = m_secondLevelMaps[firstLevel];
+            }
+        }
+
+        if (secondLevelMap != 0)
+            return m_freeLists[firstLevel][FindFirstBit(secondLevelMap)];
+
+        // Blocks of the class of size itself may fit too, they are checked one by one
+        MapSize(size, firstLevel, secondLevel);
+
+        for (Uint32 block = m_freeLists[firstLevel][secondLevel]; block != InvalidBlock;
+             block = m_blocks[block].NextFree)
+        {
+            if (m_blocks[block].Size >= size)
+                return block;
+        }
+
+        return InvalidBlock;
+    }
+
+    void RangeAllocator::MergeWithNext(Uint32 block)
+    {
+        Uint32 next = m_blocks[block].NextPhysical;
+
+        m_blocks[block].Size += m_blocks[next].Size;
+        m_blocks[block].NextPhysical = m_blocks[next].NextPhysical;
+
+        if (m_blocks[next].NextPhysical != InvalidBlock)
+            m_blocks[m_blocks[next].NextPhysical].PreviousPhysical = block;
+
+        ReleaseBlock(next);
+    }
+
+    Uint32 RangeAllocator::Allocate(Uint64 size)
+    {
+        if (size == 0)
+            return InvalidBlock;
+
+        Uint32 block = FindFreeBlock(size);
+
+        if (block == InvalidBlock)
+            return InvalidBlock;
+
+        RemoveFreeBlock(block);
+
+        // The rest of block stays free right after it
+        if (m_blocks[block].Size > size)
+        {
+            Uint32 rest = AcquireBlock();
+            Uint32 next = m_blocks[block].NextPhysical;
+
+            m_blocks[rest].Offset = m_blocks[block].Offset + size;
+            m_blocks[rest].Size = m_blocks[block].Size - size;
+            m_blocks[rest].UserData = 0;
+            m_blocks[rest].PreviousPhysical = block;
+            m_blocks[rest].NextPhysical = next;
+
+            if (next != InvalidBlock)
+                m_blocks[next].PreviousPhysical = rest;
+
+            m_blocks[block].NextPhysical = rest;
+            m_blocks[block].Size = size;
+
+            InsertFreeBlock(rest);
+        }
+
+        m_blocks[block].UserData = 0;
+        m_usedSize += size;
+
+        return block;
+    }
+
+    void RangeAllocator::Free(Uint32 block)
+    {
+        if (block >= m_blockCapacity || m_blocks[block].Free)
+            return;
+
+        m_usedSize -= m_blocks[block].Size;
+
+        Uint32 previous = m_blocks[block].PreviousPhysical;
+
+        if (previous != InvalidBlock && m_blocks[previous].Free)
+        {
+            RemoveFreeBlock(previous);
+            MergeWithNext(previous);
+
+            block = previous;
+        }
+
+        Uint32 next = m_blocks[block].NextPhysical;
+
+        if (next != InvalidBlock && m_blocks[next].Free)
+        {
+            RemoveFreeBlock(next);
+            MergeWithNext(block);
+        }
+
+        InsertFreeBlock(block);
+    }
+
+    bool RangeAllocator::MoveDown(Uint32 block)
+    {
+        if (block >= m_blockCapacity || m_blocks[block].Free)
+            return false;
+
+        Uint32 free = m_blocks[block].PreviousPhysical;
+
+        if (free == InvalidBlock || !m_blocks[free].Free)
+            return false;
+
+        RemoveFreeBlock(free);
+
+        Uint32 previous = m_blocks[free].PreviousPhysical;
+        Uint32 next = m_blocks[block].NextPhysical;
+
+        // Order previous, free, block, next becomes previous, block, free, next
+        m_blocks[block].Offset = m_blocks[free].Offset;
+        m_blocks[free].Offset = m_blocks[block].Offset + m_blocks[block].Size;
+
+        if (previous != InvalidBlock)
+            m_blocks[previous].NextPhysical = block;
+        else
+            m_firstBlock = block;
+
+        m_blocks[block].PreviousPhysical = previous;
+        m_blocks[block].NextPhysical = free;
+
+        m_blocks[free].PreviousPhysical = block;
+        m_blocks[free].NextPhysical = next;
+
+        if (next != InvalidBlock)
+            m_blocks[next].PreviousPhysical = free;
+
+        if (next != InvalidBlock && m_blocks[next].Free)
+        {
+            RemoveFreeBlock(next);
+            MergeWithNext(free);
+        }
+
+        InsertFreeBlock(free);
+
+        return true;
+    }
+
+    Uint64 RangeAllocator::GetOffset(Uint32 block) const
+    {
+        return m_blocks[block].Offset;
+    }
+
+    Uint64 RangeAllocator::GetSize(Uint32 block) const
+    {
+        return m_blocks[block].Size;
+    }
+
+    void RangeAllocator::SetUserData(Uint32 block, Uint64 userData)
+    {
+        m_blocks[block].UserData = userData;
+    }
+
+    Uint64 RangeAllocator::GetUserData(Uint32 block) const
+    {
+        return m_blocks[block].UserData;
+    }
+
+    Uint32 RangeAllocator::GetFirstBlock() const
+    {
+        return m_firstBlock;
+    }
+
+    Uint32 RangeAllocator::GetNextBlock(Uint32 block) const
+    {
+        return m_blocks[block].NextPhysical;
+    }
+
+    bool RangeAllocator::IsFree(Uint32 block) const
+    {
+        return m_blocks[block].Free;
+    }
+
+    Uint64 RangeAllocator::GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    Uint64 RangeAllocator::GetUsedSize() const
+    {
+        return m_usedSize;
+    }
+
+    Uint64 RangeAllocator::GetFreeBlockCount() const
+    {
+        return m_freeBlockCount;
+    }
+
+    Uint64 RangeAllocator::GetLargestFreeSize() const
+    {
+        if (m_firstLevelMap == 0)
+            return 0;
+
+        // The largest block is in the highest class which isn't empty
+        Uint64 firstLevel = FindLastBit(m_firstLevelMap);
+        Uint64 secondLevel = FindLastBit(m_secondLevelMaps[firstLevel]);
+
+        Uint64 largestSize = 0;
+
+        for (Uint32 block = m_freeLists[firstLevel][secondLevel]; block != InvalidBlock;
+             block = m_blocks[block].NextFree)
+        {
+            largestSize = MAX(largestSize, m_blocks[block].Size);
+        }
+
+        return largestSize;
+    }
+
+    GeometryPool::GeometryPool(GraphicsContext* context, Allocator* allocator, const Desc& description)
+        : m_vertexRanges(allocator, description.VertexCapacity), m_indexRanges(allocator, description.IndexCapacity)
+    {
+        m_context = context;
+        m_allocator = allocator;
+
+        VertexBuffer::Desc vertexDescription = {nullptr, description.VertexSize, description.VertexCapacity,
+                                                description.Layout, description.Usage, description.VertexPulling};
+
+        IndexBuffer::Desc indexDescription = {nullptr, description.IndexType, description.IndexCapacity,
+                                              description.Usage};
+
+        m_vertexBuffer = m_context->CreateVertexBuffer(vertexDescription);
+        m_indexBuffer = m_context->CreateIndexBuffer(indexDescription);
+
+        m_meshCapacity = 64;
+        m_meshCount = 0;
+        m_meshEntriesGiven = 0;
+        m_meshes = AllocateArray<MeshEntry>(m_allocator, m_meshCapacity);
+        m_freeMesh = InvalidMesh;
+
+        for (Uint64 i = 0; i < m_meshCapacity; i++)
+        {
+            m_meshes[i].Used = false;
+            m_meshes[i].Generation = 0;
+        }
+
+        m_compactionThreshold = description.CompactionThreshold;
+        m_compactionBudget = MAX(description.CompactionBudget, 1);
+        m_compacting = false;
+
+        m_revision = 0;
+        m_movedBytes = 0;
+    }
+
+    GeometryPool::~GeometryPool()
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (m_vertexBuffer != nullptr)
+            m_context->ReleaseBuffer(m_vertexBuffer);
+
+        if (m_indexBuffer != nullptr)
+            m_context->ReleaseBuffer(m_indexBuffer);
+
+        m_allocator->FreeMemory(m_meshes);
+    }
+
+    Uint64 GeometryPool::AcquireMesh()
+    {
+        if (m_freeMesh != InvalidMesh)
+        {
+            Uint64 mesh = m_freeMesh;
+            m_freeMesh = m_meshes[mesh].NextFree;
+
+            return mesh;
+        }
+
+        // Released entries are reused first, so a new one is taken only when all of the given ones are used
+        Uint64 mesh = m_meshEntriesGiven++;
+
+        if (mesh == m_meshCapacity)
+        {
+            Uint64 newCapacity = m_meshCapacity * 2;
+
+            auto newMeshes = AllocateArray<MeshEntry>(m_allocator, newCapacity);
+            CopyMemory(newMeshes, m_meshes, m_meshCapacity * sizeof(MeshEntry));
+
+            for (Uint64 i = m_meshCapacity; i < newCapacity; i++)
+            {
+                newMeshes[i].Used = false;
+                newMeshes[i].Generation = 0;
+            }
+
+            m_allocator->FreeMemory(m_meshes);
+
+            m_meshes = newMeshes;
+            m_meshCapacity = newCapacity;
+        }
+
+        return mesh;
+    }
+
+    Uint64 GeometryPool::FindMesh(GeometryID mesh) const
+    {
+        Uint64 index = mesh & 0xFFFFFFFF;
+
+        if (index >= m_meshEntriesGiven || !m_meshes[index].Used || m_meshes[index].Generation != (mesh >> 32))
+            return InvalidMesh;
+
+        return index;
+    }
+
+    GeometryID GeometryPool::AddMesh(const void* vertices, Uint64 vertexCount, const void* indices,
+                                     Uint64 indexCount)
+    {
+        if (m_vertexBuffer == nullptr || m_indexBuffer == nullptr)
+            return InvalidGeometry;
+
+        if (vertices == nullptr || indices == nullptr || vertexCount == 0 || indexCount == 0)
+            return InvalidGeometry;
+
+        Uint32 vertexBlock = m_vertexRanges.Allocate(vertexCount);
+        Uint32 indexBlock = m_indexRanges.Allocate(indexCount);
+
+        // Free space may be enough but split into holes, then the whole pool is compacted
+        if (vertexBlock == RangeAllocator::InvalidBlock || indexBlock == RangeAllocator::InvalidBlock)
+        {
+            m_vertexRanges.Free(vertexBlock);
+            m_indexRanges.Free(indexBlock);
+
+            bool verticesFit = m_vertexRanges.GetCapacity() - m_vertexRanges.GetUsedSize() >= vertexCount;
+            bool indicesFit = m_indexRanges.GetCapacity() - m_indexRanges.GetUsedSize() >= indexCount;
+
+            if (!verticesFit || !indicesFit)
+                return InvalidGeometry;
+
+            Compact();
+
+            vertexBlock = m_vertexRanges.Allocate(vertexCount);
+            indexBlock = m_indexRanges.Allocate(indexCount);
+
+            // Allocator takes only the blocks which fit the size for sure, so even one free block may not be taken
+            if (vertexBlock == RangeAllocator::InvalidBlock || indexBlock == RangeAllocator::InvalidBlock)
+            {
+                m_vertexRanges.Free(vertexBlock);
+                m_indexRanges.Free(indexBlock);
+
+                return InvalidGeometry;
+            }
+        }
+
+        Uint64 mesh = AcquireMesh();
+        MeshEntry& entry = m_meshes[mesh];
+
+        entry.VertexBlock = vertexBlock;
+        entry.IndexBlock = indexBlock;
+        entry.VertexCount = vertexCount;
+        entry.IndexCount = indexCount;
+        entry.Used = true;
+
+        m_vertexRanges.SetUserData(vertexBlock, mesh);
+        m_indexRanges.SetUserData(indexBlock, mesh);
+
+        m_context->OverwriteBuffer(m_vertexBuffer, vertices, m_vertexRanges.GetOffset(vertexBlock), vertexCount);
+        m_context->OverwriteBuffer(m_indexBuffer, indices, m_indexRanges.GetOffset(indexBlock), indexCount);
+
+        m_meshCount++;
+
+        return MakeGeometryID(mesh, entry.Generation);
+    }
+
+    void GeometryPool::ReleaseMesh(GeometryID mesh)
+    {
+        Uint64 index = FindMesh(mesh);
+
+        if (index == InvalidMesh)
+            return;
+
+        MeshEntry& entry = m_meshes[index];
+
+        m_vertexRanges.Free(entry.VertexBlock);
+        m_indexRanges.Free(entry.IndexBlock);
+
+        entry.Used = false;
+        entry.Generation++;
+        entry.NextFree = m_freeMesh;
+
+        m_freeMesh = index;
+        m_meshCount--;
+    }
+
+    Uint64 GeometryPool::CompactVertices(Uint64 budget)
+    {
+        Uint64 vertexSize = m_vertexBuffer->GetVertexSize();
+        auto vertices = reinterpret_cast<Uint8*>(m_vertexBuffer->GetVertices());
+
+        Uint64 movedBytes = 0;
+
+        // Moved block is followed by the free one, so one pass moves everything down
+        Uint32 block = m_vertexRanges.GetFirstBlock();
+
+        for (; block != RangeAllocator::InvalidBlock && movedBytes < budget; block = m_vertexRanges.GetNextBlock(block))
+        {
+            Uint64 oldOffset = m_vertexRanges.GetOffset(block);
+
+            if (m_vertexRanges.IsFree(block) || !m_vertexRanges.MoveDown(block))
+                continue;
+
+            Uint64 newOffset = m_vertexRanges.GetOffset(block);
+            Uint64 count = m_vertexRanges.GetSize(block);
+
+            // Copy of buffer on CPU side is the source of data, ranges may overlap
+            memmove(vertices + newOffset * vertexSize, vertices + oldOffset * vertexSize, count * vertexSize);
+            m_context->OverwriteBuffer(m_vertexBuffer, vertices + newOffset * vertexSize, newOffset, count);
+
+            movedBytes += count * vertexSize;
+        }
+
+        return movedBytes;
+    }
+
+    Uint64 GeometryPool::CompactIndices(Uint64 budget)
+    {
+        Uint64 indexSize = IndexBuffer::GetIndexSize(m_indexBuffer->GetIndexType());
+        auto indices = reinterpret_cast<Uint8*>(m_indexBuffer->GetIndices());
+
+        Uint64 movedBytes = 0;
+
+        Uint32 block = m_indexRanges.GetFirstBlock();
+
+        for (; block != RangeAllocator::InvalidBlock && movedBytes < budget; block = m_indexRanges.GetNextBlock(block))
+        {
+            Uint64 oldOffset = m_indexRanges.GetOffset(block);
+
+            if (m_indexRanges.IsFree(block) || !m_indexRanges.MoveDown(block))
+                continue;
+
+            Uint64 newOffset = m_indexRanges.GetOffset(block);
+            Uint64 count = m_indexRanges.GetSize(block);
+
+            memmove(indices + newOffset * indexSize, indices + oldOffset * indexSize, count * indexSize);
+            m_context->OverwriteBuffer(m_indexBuffer, indices + newOffset * indexSize, newOffset, count);
+
+            movedBytes += count * indexSize;
+        }
+
+        return movedBytes;
+    }
+
+    void GeometryPool::Update()
+    {
+        if (m_vertexBuffer == nullptr || m_indexBuffer == nullptr)
+            return;
+
+        if (!m_compacting)
+        {
+            Float32 fragmentation = MAX(GetFragmentation(m_vertexRanges), GetFragmentation(m_indexRanges));
+            m_compacting = fragmentation > m_compactionThreshold;
+        }
+
+        if (!m_compacting)
+            return;
+
+        Uint64 movedBytes = CompactVertices(m_compactionBudget);
+
+        if (movedBytes < m_compactionBudget)
+            movedBytes += CompactIndices(m_compactionBudget - movedBytes);
+
+        if (movedBytes != 0)
+            m_revision++;
+
+        m_movedBytes += movedBytes;
+
+        // Compaction is over when free space of both buffers is one block at the end
+        m_compacting = m_vertexRanges.GetFreeBlockCount() > 1 || m_indexRanges.GetFreeBlockCount() > 1;
+    }
+
+    void GeometryPool::Compact()
+    {
+        if (m_vertexBuffer == nullptr || m_indexBuffer == nullptr)
+            return;
+
+        Uint64 movedBytes = CompactVertices(~0ull) + CompactIndices(~0ull);
+
+        if (movedBytes != 0)
+            m_revision++;
+
+        m_movedBytes += movedBytes;
+        m_compacting = false;
+    }
+
+    Float32 GeometryPool::GetFragmentation(const RangeAllocator& ranges)
+    {
+        Uint64 freeSize = ranges.GetCapacity() - ranges.GetUsedSize();
+
+        if (freeSize == 0)
+            return 0.0f;
+
+        return 1.0f - static_cast<Float32>(ranges.GetLargestFreeSize()) / static_cast<Float32>(freeSize);
+    }
+
+    DrawIndexedCommand GeometryPool::GetDrawCommand(GeometryID mesh, Uint32 instanceCount, Uint32 baseInstance) const
+    {
+        Uint64 index = FindMesh(mesh);
+
+        if (index == InvalidMesh)
+            return {0, 0, 0, 0, 0};
+
+        const MeshEntry& entry = m_meshes[index];
+
+        DrawIndexedCommand command;
+
+        command.IndexCount = static_cast<Uint32>(entry.IndexCount);
+        command.InstanceCount = instanceCount;
+        command.FirstIndex = static_cast<Uint32>(m_indexRanges.GetOffset(entry.IndexBlock));
+        command.BaseVertex = static_cast<Int32>(m_vertexRanges.GetOffset(entry.VertexBlock));
+        command.BaseInstance = baseInstance;
+
+        return command;
+    }
+
+    IndexBuffer::Range GeometryPool::GetRange(GeometryID mesh) const
+    {
+        Uint64 index = FindMesh(mesh);
+
+        if (index == InvalidMesh)
+            return {0, 0, 0};
+
+        const MeshEntry& entry = m_meshes[index];
+
+        IndexBuffer::Range range;
+
+        range.FirstIndex = m_indexRanges.GetOffset(entry.IndexBlock);
+        range.IndexCount = entry.IndexCount;
+        range.BaseVertex = static_cast<Int64>(m_vertexRanges.GetOffset(entry.VertexBlock));
+
+        return range;
+    }
+
+    Uint64 GeometryPool::GetRevision() const
+    {
+        return m_revision;
+    }
+
+    VertexBuffer* GeometryPool::GetVertexBuffer() const
+    {
+        return m_vertexBuffer;
+    }
+
+    IndexBuffer* GeometryPool::GetIndexBuffer() const
+    {
+        return m_indexBuffer;
+    }
+
+    GeometryPool::Report GeometryPool::GetReport() const
+    {
+        Report report;
+
+        report.MeshCount = m_meshCount;
+
+        report.VertexCapacity = m_vertexRanges.GetCapacity();
+        report.UsedVertices = m_vertexRanges.GetUsedSize();
+        report.FreeVertexBlocks = m_vertexRanges.GetFreeBlockCount();
+        report.LargestFreeVertices = m_vertexRanges.GetLargestFreeSize();
+
+        report.IndexCapacity = m_indexRanges.GetCapacity();
+        report.UsedIndices = m_indexRanges.GetUsedSize();
+        report.FreeIndexBlocks = m_indexRanges.GetFreeBlockCount();
+        report.LargestFreeIndices = m_indexRanges.GetLargestFreeSize();
+
+        report.VertexFragmentation = GetFragmentation(m_vertexRanges);
+        report.IndexFragmentation = GetFragmentation(m_indexRanges);
+
+        report.MovedBytes = m_movedBytes;
+
+        return report;
+    }
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    // Two-level segregated fit allocator of ranges [0, capacity) in abstract units (vertices, indices).
+    // It doesn't own any memory, blocks are told by ids which stay the same while they are alive
+    // (even if block is moved by MoveDown). Allocation and freeing take constant time
+    class RangeAllocator
+    {
+    private:
+        static constexpr Uint64 SecondLevelLog2 = 4;
+        static constexpr Uint64 SecondLevelCount = 1ull << SecondLevelLog2;
+        static constexpr Uint64 FirstLevelCount = 64 - SecondLevelLog2 + 1;
+
+        struct Block
+        {
+            Uint64 Offset;
+            Uint64 Size;
+            Uint64 UserData;
+
+            // Neighbours in address order
+            Uint32 PreviousPhysical;
+            Uint32 NextPhysical;
+
+            // Neighbours in free list of the same size class (unused entries of the table are chained by NextFree)
+            Uint32 PreviousFree;
+            Uint32 NextFree;
+
+            bool Free;
+        };
+
+        Block* m_blocks;
+        Uint32 m_blockCapacity;
+        Uint32 m_unusedBlock;
+
+        Uint32 m_firstBlock;
+
+        Uint64 m_firstLevelMap;
+        Uint32 m_secondLevelMaps[FirstLevelCount];
+        Uint32 m_freeLists[FirstLevelCount][SecondLevelCount];
+
+        Uint64 m_capacity;
+        Uint64 m_usedSize;
+        Uint64 m_freeBlockCount;
+
+        Allocator* m_allocator;
+
+        static void MapSize(Uint64 size, Uint64& firstLevel, Uint64& secondLevel);
+
+        Uint32 AcquireBlock();
+        void ReleaseBlock(Uint32 block);
+
+        void InsertFreeBlock(Uint32 block);
+        void RemoveFreeBlock(Uint32 block);
+
+        // Free block which fits size for sure, or InvalidBlock
+        Uint32 FindFreeBlock(Uint64 size) const;
+
+        // Merges block with its next physical neighbour (both of them are free and out of free lists)
+        void MergeWithNext(Uint32 block);
+
+    public:
+        static constexpr Uint32 InvalidBlock = ~0u;
+
+        RangeAllocator(Allocator* allocator, Uint64 capacity);
+        ~RangeAllocator();
+
+        RangeAllocator(const RangeAllocator&) = delete;
+        RangeAllocator& operator=(const RangeAllocator&) = delete;
+
+        Uint32 Allocate(Uint64 size);
+        void Free(Uint32 block);
+
+        // Swaps used block with free block right before it, so the free space goes up by addresses.
+        // Returns false when there is no free block before it
+        bool MoveDown(Uint32 block);
+
+        Uint64 GetOffset(Uint32 block) const;
+        Uint64 GetSize(Uint32 block) const;
+
+        // Value kept with used block (for example, id of its owner)
+        void SetUserData(Uint32 block, Uint64 userData);
+        Uint64 GetUserData(Uint32 block) const;
+
+        // Blocks in address order (both used and free ones), InvalidBlock ends them
+        Uint32 GetFirstBlock() const;
+        Uint32 GetNextBlock(Uint32 block) const;
+        bool IsFree(Uint32 block) const;
+
+        Uint64 GetCapacity() const;
+        Uint64 GetUsedSize() const;
+        Uint64 GetFreeBlockCount() const;
+        Uint64 GetLargestFreeSize() const;
+    };
+
+    // Index of mesh entry in the low half and generation of the entry in the high one, so id of released mesh
+    // doesn't refer to the mesh which took its entry later
+    typedef Uint64 GeometryID;
+
+    static constexpr GeometryID InvalidGeometry = ~0ull;
+
+    // Keeps many meshes of one vertex format in one vertex buffer and one index buffer, so they can be drawn
+    // together (by DrawIndexedIndirect or DrawIndexedRanges) without switching buffers. Ranges of both buffers
+    // are sub-allocated by RangeAllocator, indices of mesh stay relative to its first vertex (base vertex of
+    // draw adds it). Freed ranges leave holes, Update moves meshes down over the holes a few at a time
+    // when fragmentation passes the threshold, so draw commands of pool have to be taken again after
+    // revision of pool changes
+    class GeometryPool
+    {
+    public:
+        struct Desc
+        {
+            Uint64 VertexSize;
+            Uint64 VertexCapacity;
+            VertexLayout Layout;
+
+            IndexType IndexType;
+            Uint64 IndexCapacity;
+
+            BufferUsage Usage;
+
+            // Vertex buffer is read by vertex shader (see VertexBuffer::Desc)
+            bool VertexPulling = false;
+
+            // Part of free space which is not in the largest free block (from 0 to 1)
+            Float32 CompactionThreshold = 0.5f;
+
+            // Bytes which Update may move in one call
+            Uint64 CompactionBudget = 256 * 1024;
+        };
+
+        struct Report
+        {
+            Uint64 MeshCount;
+
+            Uint64 VertexCapacity;
+            Uint64 UsedVertices;
+            Uint64 FreeVertexBlocks;
+            Uint64 LargestFreeVertices;
+
+            Uint64 IndexCapacity;
+            Uint64 UsedIndices;
+            Uint64 FreeIndexBlocks;
+            Uint64 LargestFreeIndices;
+
+            // Part of free space which can't be given to one allocation (0 when free space is one block)
+            Float32 VertexFragmentation;
+            Float32 IndexFragmentation;
+
+            // Bytes which were moved by compaction since the pool was created
+            Uint64 MovedBytes;
+        };
+
+    private:
+        struct MeshEntry
+        {
+            Uint32 VertexBlock;
+            Uint32 IndexBlock;
+
+            Uint64 VertexCount;
+            Uint64 IndexCount;
+
+            // Next free entry when the mesh was released
+            Uint64 NextFree;
+            bool Used;
+
+            // Changes every time the mesh is released
+            Uint32 Generation;
+        };
+
+        static constexpr Uint64 InvalidMesh = ~0ull;
+
+        GraphicsContext* m_context;
+
+        VertexBuffer* m_vertexBuffer;
+        IndexBuffer* m_indexBuffer;
+
+        // User data of block is index of its mesh entry
+        RangeAllocator m_vertexRanges;
+        RangeAllocator m_indexRanges;
+
+        MeshEntry* m_meshes;
+        Uint64 m_meshCount;
+        Uint64 m_meshCapacity;
+        Uint64 m_meshEntriesGiven;
+        Uint64 m_freeMesh;
+
+        Float32 m_compactionThreshold;
+        Uint64 m_compactionBudget;
+        bool m_compacting;
+
+        Uint64 m_revision;
+        Uint64 m_movedBytes;
+
+        Allocator* m_allocator;
+
+        // Returns index of free mesh entry
+        Uint64 AcquireMesh();
+
+        // Index of entry of the alive mesh, or InvalidMesh
+        Uint64 FindMesh(GeometryID mesh) const;
+
+        // Moves used blocks down over the free ones until budget is spent, returns moved bytes
+        Uint64 CompactVertices(Uint64 budget);
+        Uint64 CompactIndices(Uint64 budget);
+
+        static Float32 GetFragmentation(const RangeAllocator& ranges);
+
+    public:
+        GeometryPool(GraphicsContext* context, Allocator* allocator, const Desc& description);
+        ~GeometryPool();
+
+        GeometryPool(const GeometryPool&) = delete;
+        GeometryPool& operator=(const GeometryPool&) = delete;
+
+        // Copies mesh into the pool. Indices are relative to the first of the given vertices and have
+        // index type of pool. Returns InvalidGeometry when there is no place for it
+        GeometryID AddMesh(const void* vertices, Uint64 vertexCount, const void* indices, Uint64 indexCount);
+        void ReleaseMesh(GeometryID mesh);
+
+        // Compacts the pool by steps of CompactionBudget bytes (once in a frame), compaction goes on
+        // until free space becomes one block
+        void Update();
+
+        // Compacts the whole pool at once
+        void Compact();
+
+        DrawIndexedCommand GetDrawCommand(GeometryID mesh, Uint32 instanceCount = 1, Uint32 baseInstance = 0) const;
+        IndexBuffer::Range GetRange(GeometryID mesh) const;
+
+        // Changes every time meshes are moved
+        Uint64 GetRevision() const;
+
+        VertexBuffer* GetVertexBuffer() const;
+        IndexBuffer* GetIndexBuffer() const;
+
+        Report GetReport() const;
+    };
+}
@@ -1,425 +1,764 @@
-#include "Graphics.h"
-
-namespace Tiny3D
-{
-    GraphicsComponent::~GraphicsComponent()
-    {
-        if (m_graphicsHandle != nullptr && m_allocator != nullptr)
-            m_allocator->FreeMemory(m_graphicsHandle);
-    }
-
-    void Shader::AddBufferBinding()
-    {
-        m_bindedBuffers++;
-    }
-
-    void Shader::AddTextureBinding()
-    {
-        m_bindedTextures++;
-    }
-
-    void Shader::ClearBindings()
-    {
-        m_bindedBuffers = 0;
-        m_bindedTextures = 0;
-    }
-
-    Uint64 Shader::GetBufferBindings() const
-    {
-        return m_bindedBuffers;
-    }
-
-    Uint64 Shader::GetTextureBindings() const
-    {
-        return m_bindedTextures;
-    }
-
-    VertexBuffer::VertexBuffer(Uint64 vertexSize, Allocator *allocator)
-    {
-        m_allocator = allocator;
-        m_vertexSize = vertexSize;
-
-        m_vertices = nullptr;
-        m_vertexCount = 0;
-    }
-
-    VertexBuffer::~VertexBuffer()
-    {
-        if (m_allocator != nullptr && m_vertices != nullptr)
-            m_allocator->FreeMemory(m_vertices);
-    }
-
-    void VertexBuffer::SetVertices(const void *data, Uint64 count)
-    {
-        if (m_allocator == nullptr)
-            return;
-
-        if (m_vertices != nullptr)
-            m_allocator->FreeMemory(m_vertices);
-
-        Uint64 bufferSize = count * m_vertexSize;
-        m_vertices = m_allocator->AllocateMemory(bufferSize);
-        CopyMemory(m_vertices, data, bufferSize);
-
-        m_vertexCount = count;
-    }
-
-    void* VertexBuffer::GetVertices() const
-    {
-        return m_vertices;
-    }
-
-    Uint64 VertexBuffer::GetVertexCount() const
-    {
-        return m_vertexCount;
-    }
-
-    Uint64 VertexBuffer::GetVertexSize() const
-    {
-        return m_vertexSize;
-    }
-
-    Uint64 VertexBuffer::GetBufferSize() const
-    {
-        return m_vertexCount * m_vertexSize;
-    }
-
-    IndexBuffer::IndexBuffer(IndexType type, Allocator *allocator)
-    {
-        m_allocator = allocator;
-        m_indexType = type;
-
-        m_indices = nullptr;
-        m_indexCount = 0;
-    }
-
-    IndexBuffer::~IndexBuffer()
-    {
-        if (m_allocator != nullptr && m_indices != nullptr)
-            m_allocator->FreeMemory(m_indices);
-    }
-
-    void IndexBuffer::SetIndices(const void *data, Uint64 count)
-    {
-        if (m_allocator == nullptr)
-            return;
-
-        if (m_indices != nullptr)
-            m_allocator->FreeMemory(m_indices);
-
-        Uint64 bufferSize = count * IndexSizes[ENUM_VALUE(m_indexType)];
-        m_indices = m_allocator->AllocateMemory(bufferSize);
-        CopyMemory(m_indices, data, bufferSize);
-
-        m_indexCount = count;
-    }
-
-    void* IndexBuffer::GetIndices() const
-    {
-        return m_indices;
-    }
-
-    IndexType IndexBuffer::GetIndexType() const
-    {
-        return m_indexType;
-    }
-
-    Uint64 IndexBuffer::GetIndexCount() const
-    {
-        return m_indexCount;
-    }
-
-    Uint64 IndexBuffer::GetBufferSize() const
-    {
-        return IndexSizes[ENUM_VALUE(m_indexType)] * m_indexCount;
-    }
-
-    UniformBuffer::UniformBuffer(Allocator *allocator)
-    {
-        m_allocator = allocator;
-
-        m_data = nullptr;
-        m_size = 0;
-    }
-
-    UniformBuffer::~UniformBuffer()
-    {
-        if (m_allocator != nullptr && m_data != nullptr)
-            m_allocator->FreeMemory(m_data);
-    }
-
-    void UniformBuffer::SetData(const void *data, Uint64 size)
-    {
-        if (m_allocator == nullptr)
-            return;
-
-        if (m_data != nullptr)
-            m_allocator->FreeMemory(m_data);
-
-        m_data = m_allocator->AllocateMemory(size);
-        CopyMemory(m_data, data, size);
-
-        m_size = size;
-    }
-
-    void* UniformBuffer::GetData() const
-    {
-        return m_data;
-    }
-
-    Uint64 UniformBuffer::GetSize() const
-    {
-        return m_size;
-    }
-
-    Texture1D::Texture1D(Allocator *allocator)
-    {
-        m_allocator = allocator;
-
-        m_pixels = nullptr;
-        m_width = 0;
-        m_pixelFormat = PixelFormats::PixelRGBUint8;
-    }
-
-    Texture1D::~Texture1D()
-    {
-        if (m_allocator != nullptr && m_pixels != nullptr)
-            m_allocator->FreeMemory(m_pixels);
-    }
-
-    void Texture1D::SetPixelFormat(PixelFormats pixelFormat)
-    {
-        m_pixelFormat = pixelFormat;
-    }
-
-    PixelFormats Texture1D::GetPixelFormat() const
-    {
-        return m_pixelFormat;
-    }
-
-    void Texture1D::SetPixels(const void *pixels, Uint64 width)
-    {
-        if (m_allocator == nullptr)
-            return;
-
-        if (width == 0)
-            return;
-
-        if (m_pixels != nullptr)
-            m_allocator->FreeMemory(m_pixels);
-
-        Uint64 textureSize = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width;
-        m_pixels = m_allocator->AllocateMemory(textureSize);
-        CopyMemory(m_pixels, pixels, textureSize);
-
-        m_width = width;
-    }
-
-    void* Texture1D::GetPixels() const
-    {
-        return m_pixels;
-    }
-
-    Uint64 Texture1D::Width() const
-    {
-        return m_width;
-    }
-
-    Texture2D::Texture2D(Allocator *allocator)
-    {
-        m_allocator = allocator;
-
-        m_pixels = nullptr;
-        m_width = 0;
-        m_height = 0;
-        m_rowPitch = 0;
-        m_pixelFormat = PixelFormats::PixelRGBUint8;
-    }
-
-    Texture2D::~Texture2D()
-    {
-        if (m_allocator != nullptr && m_pixels != nullptr)
-            m_allocator->FreeMemory(m_pixels);
-    }
-
-    void Texture2D::SetPixelFormat(PixelFormats pixelFormat)
-    {
-        m_pixelFormat = pixelFormat;
-    }
-
-    PixelFormats Texture2D::GetPixelFormat() const
-    {
-        return m_pixelFormat;
-    }
-
-    void Texture2D::SetPixels(const void *pixels, Uint64 width, Uint64 height)
-    {
-        if (m_allocator == nullptr)
-            return;
-
-        if (width == 0 || height == 0)
-            return;
-
-        if (m_pixels != nullptr)
-            m_allocator->FreeMemory(m_pixels);
-
-        Uint64 textureSize = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width * height;
-        m_pixels = m_allocator->AllocateMemory(textureSize);
-        CopyMemory(m_pixels, pixels, textureSize);
-
-        m_width = width;
-        m_height = height;
-        m_rowPitch = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width;
-    }
-
-    void* Texture2D::GetPixels() const
-    {
-        return m_pixels;
-    }
-
-    Uint64 Texture2D::Width() const
-    {
-        return m_width;
-    }
-
-    Uint64 Texture2D::Height() const
-    {
-        return m_height;
-    }
-
-    Texture3D::Texture3D(Allocator *allocator)
-    {
-        m_allocator = allocator;
-
-        m_pixels = nullptr;
-        m_width = 0;
-        m_height = 0;
-        m_depth = 0;
-
-        m_rowPitch = 0;
-        m_pixelFormat = PixelFormats::PixelRGBUint8;
-    }
-
-    Texture3D::~Texture3D()
-    {
-        if (m_allocator != nullptr && m_pixels != nullptr)
-            m_allocator->FreeMemory(m_pixels);
-    }
-
-    void Texture3D::SetPixelFormat(PixelFormats pixelFormat)
-    {
-        m_pixelFormat = pixelFormat;
-    }
-
-    PixelFormats Texture3D::GetPixelFormat() const
-    {
-        return m_pixelFormat;
-    }
-
-    void Texture3D::SetPixels(const void *pixels, Uint64 width, Uint64 height, Uint64 depth)
-    {
-        if (m_allocator == nullptr)
-            return;
-
-        if (width == 0 || height == 0 || depth == 0)
-            return;
-
-        if (m_pixels != nullptr)
-            m_allocator->FreeMemory(m_pixels);
-
-        Uint64 textureSize = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width * height * depth;
-
-        m_pixels = m_allocator->AllocateMemory(textureSize);
-        CopyMemory(m_pixels, pixels, textureSize);
-
-        m_width = width;
-        m_height = height;
-        m_depth = depth;
-        m_rowPitch = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width;
-        m_rowColumnPitch = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width * height;
-    }
-
-    void* Texture3D::GetPixels() const
-    {
-        return m_pixels;
-    }
-
-    Uint64 Texture3D::Width() const
-    {
-        return m_width;
-    }
-
-    Uint64 Texture3D::Height() const
-    {
-        return m_height;
-    }
-
-    Uint64 Texture3D::Depth() const
-    {
-        return m_depth;
-    }
-
-    RenderTarget::RenderTarget(Uint32 width, Uint32 height)
-    {
-        m_width = width;
-        m_height = height;
-
-        for (Texture2D* m_colorTexture : m_colorTextures)
-            m_colorTexture = nullptr;
-        m_colorTexturesUsed = 0;
-
-        m_depthTexture = nullptr;
-        m_stencilTexture = nullptr;
-    }
-
-    void RenderTarget::AttachColorTexture(Texture2D* texture)
-    {
-        if (texture->Width() != m_width || texture->Height() != m_height)
-            return;
-
-        if (m_colorTexturesUsed == MaxColorAttachments)
-            return;
-
-        m_colorTextures[m_colorTexturesUsed] = texture;
-        m_colorTexturesUsed++;
-    }
-
-    void RenderTarget::AttachDepthTexture(Texture2D* texture)
-    {
-        if (texture->Width() != m_width || texture->Height() != m_height)
-            return;
-
-        m_depthTexture = texture;
-    }
-
-    void RenderTarget::AttachStencilTexture(Texture2D* texture)
-    {
-        if (texture->Width() != m_width || texture->Height() != m_height)
-            return;
-
-        m_stencilTexture = texture;
-    }
-
-    Texture2D* RenderTarget::GetColorTexture(Uint64 index) const
-    {
-        if (index >= MaxColorAttachments)
-            return nullptr;
-
-        return m_colorTextures[index];
-    }
-
-    Uint64 RenderTarget::GetUsedColorTextures() const
-    {
-        return m_colorTexturesUsed;
-    }
-
-    Texture2D* RenderTarget::GetDepthTexture() const
-    {
-        return m_depthTexture;
-    }
-
-    Texture2D* RenderTarget::GetStencilTexture() const
-    {
-        return m_stencilTexture;
-    }
-}
+#include "Graphics.h"
+#include "CommandList.h"
+
+#include <cstring>
+
+namespace Tiny3D
+{
+    GraphicsComponent::~GraphicsComponent()
+    {
+        if (m_graphicsHandle != nullptr && m_allocator != nullptr)
+            m_allocator->FreeMemory(m_graphicsHandle);
+    }
+
+    ShaderBindingID MakeShaderBindingID(const char* name)
+    {
+        return {HashString(name)};
+    }
+
+    Uint64 HashShaderDesc(const Shader::Desc& description)
+    {
+        const ShaderData& data = description.Data;
+
+        const char* stages[3] = {data.VertexShaderCode, data.GeometryShaderCode, data.PixelShaderCode};
+        const ShaderBinary* binaries[3] = {&data.VertexShaderBinary, &data.GeometryShaderBinary,
+                                           &data.PixelShaderBinary};
+
+        Uint64 hash = HashMemory(&description.Layout.Count, sizeof(description.Layout.Count));
+
+        // Missing stage and empty one are hashed differently
+        for (Uint64 i = 0; i < 3; i++)
+        {
+            bool present = stages[i] != nullptr;
+            hash = HashMemory(&present, sizeof(present), hash);
+
+            if (present)
+            {
+                hash = HashString(stages[i], hash);
+                continue;
+            }
+
+            const ShaderBinary& binary = *binaries[i];
+
+            hash = HashMemory(binary.Code, binary.Size, hash);
+            hash = HashString(binary.EntryPoint, hash);
+            hash = HashMemory(binary.ConstantIDs, binary.ConstantsCount * sizeof(Uint32), hash);
+            hash = HashMemory(binary.ConstantValues, binary.ConstantsCount * sizeof(Uint32), hash);
+        }
+
+        for (Uint64 i = 0; i < description.Layout.Count; i++)
+        {
+            const VertexInputElement& input = description.Layout.Inputs[i];
+
+            hash = HashString(input.Name, hash);
+            hash = HashMemory(&input.Type, sizeof(input.Type), hash);
+            hash = HashMemory(&input.Count, sizeof(input.Count), hash);
+            hash = HashMemory(&input.Normalized, sizeof(input.Normalized), hash);
+        }
+
+        return hash;
+    }
+
+    void Shader::AddBufferBinding()
+    {
+        m_bindedBuffers++;
+    }
+
+    void Shader::AddTextureBinding()
+    {
+        m_bindedTextures++;
+    }
+
+    void Shader::ClearBindings()
+    {
+        m_bindedBuffers = 0;
+        m_bindedTextures = 0;
+    }
+
+    Uint64 Shader::GetBufferBindings() const
+    {
+        return m_bindedBuffers;
+    }
+
+    Uint64 Shader::GetTextureBindings() const
+    {
+        return m_bindedTextures;
+    }
+
+    VertexBuffer::VertexBuffer(Uint64 vertexSize, Allocator *allocator)
+    {
+        m_allocator = allocator;
+        m_vertexSize = vertexSize;
+
+        m_vertices = nullptr;
+        m_vertexCount = 0;
+    }
+
+    VertexBuffer::~VertexBuffer()
+    {
+        if (m_allocator != nullptr && m_vertices != nullptr)
+            m_allocator->FreeMemory(m_vertices);
+    }
+
+    void VertexBuffer::SetVertices(const void *data, Uint64 count)
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (m_vertices != nullptr)
+            m_allocator->FreeMemory(m_vertices);
+
+        Uint64 bufferSize = count * m_vertexSize;
+        m_vertices = m_allocator->AllocateMemory(bufferSize);
+        CopyMemory(m_vertices, data, bufferSize);
+
+        m_vertexCount = count;
+    }
+
+    void* VertexBuffer::GetVertices() const
+    {
+        return m_vertices;
+    }
+
+    Uint64 VertexBuffer::GetVertexCount() const
+    {
+        return m_vertexCount;
+    }
+
+    Uint64 VertexBuffer::GetVertexSize() const
+    {
+        return m_vertexSize;
+    }
+
+    Uint64 VertexBuffer::GetBufferSize() const
+    {
+        return m_vertexCount * m_vertexSize;
+    }
+
+    IndexBuffer::IndexBuffer(IndexType type, Allocator *allocator)
+    {
+        m_allocator = allocator;
+        m_indexType = type;
+        m_sourceIndexType = type;
+
+        m_indices = nullptr;
+        m_indexCount = 0;
+
+        m_rangesUsed = 0;
+    }
+
+    IndexBuffer::~IndexBuffer()
+    {
+        if (m_allocator != nullptr && m_indices != nullptr)
+            m_allocator->FreeMemory(m_indices);
+    }
+
+    Uint64 IndexBuffer::GetIndexSize(IndexType type)
+    {
+        return IndexSizes[ENUM_VALUE(type)];
+    }
+
+    Uint32 IndexBuffer::ReadIndex(const void* indices, IndexType type, Uint64 position)
+    {
+        switch (type)
+        {
+            case IndexType::UnsignedByteIndex:
+                return reinterpret_cast<const Uint8*>(indices)[position];
+
+            case IndexType::UnsignedShortIndex:
+                return reinterpret_cast<const Uint16*>(indices)[position];
+
+            default:
+                return reinterpret_cast<const Uint32*>(indices)[position];
+        }
+    }
+
+    void IndexBuffer::WriteIndex(void* indices, IndexType type, Uint64 position, Uint32 value)
+    {
+        switch (type)
+        {
+            case IndexType::UnsignedByteIndex:
+                reinterpret_cast<Uint8*>(indices)[position] = static_cast<Uint8>(value);
+                break;
+
+            case IndexType::UnsignedShortIndex:
+                reinterpret_cast<Uint16*>(indices)[position] = static_cast<Uint16>(value);
+                break;
+
+            default:
+                reinterpret_cast<Uint32*>(indices)[position] = value;
+                break;
+        }
+    }
+
+    void IndexBuffer::SetIndices(const void *data, Uint64 count)
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (m_indices != nullptr)
+            m_allocator->FreeMemory(m_indices);
+
+        Uint64 bufferSize = count * IndexSizes[ENUM_VALUE(m_indexType)];
+        m_indices = m_allocator->AllocateMemory(bufferSize);
+        CopyMemory(m_indices, data, bufferSize);
+
+        m_indexCount = count;
+    }
+
+    void* IndexBuffer::GetIndices() const
+    {
+        return m_indices;
+    }
+
+    IndexType IndexBuffer::GetIndexType() const
+    {
+        return m_indexType;
+    }
+
+    Uint64 IndexBuffer::GetIndexCount() const
+    {
+        return m_indexCount;
+    }
+
+    void IndexBuffer::SetSourceIndexType(IndexType type)
+    {
+        m_sourceIndexType = type;
+    }
+
+    IndexType IndexBuffer::GetSourceIndexType() const
+    {
+        return m_sourceIndexType;
+    }
+
+    void IndexBuffer::SetRanges(const Range* ranges, Uint64 count)
+    {
+        if (count > MaxRanges || (ranges == nullptr && count != 0))
+            return;
+
+        for (Uint64 i = 0; i < count; i++)
+            m_ranges[i] = ranges[i];
+
+        m_rangesUsed = count;
+    }
+
+    const IndexBuffer::Range* IndexBuffer::GetRanges() const
+    {
+        return m_ranges;
+    }
+
+    Uint64 IndexBuffer::GetRangesCount() const
+    {
+        return m_rangesUsed;
+    }
+
+    Uint64 IndexBuffer::GetBufferSize() const
+    {
+        return IndexSizes[ENUM_VALUE(m_indexType)] * m_indexCount;
+    }
+
+    UniformBuffer::UniformBuffer(Allocator *allocator)
+    {
+        m_allocator = allocator;
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    UniformBuffer::~UniformBuffer()
+    {
+        if (m_allocator != nullptr && m_data != nullptr)
+            m_allocator->FreeMemory(m_data);
+    }
+
+    void UniformBuffer::SetData(const void *data, Uint64 size)
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (m_data != nullptr)
+            m_allocator->FreeMemory(m_data);
+
+        m_data = m_allocator->AllocateMemory(size);
+        CopyMemory(m_data, data, size);
+
+        m_size = size;
+    }
+
+    void* UniformBuffer::GetData() const
+    {
+        return m_data;
+    }
+
+    Uint64 UniformBuffer::GetSize() const
+    {
+        return m_size;
+    }
+
+    IndirectBuffer::IndirectBuffer(Uint64 commandCount, BufferUsage usage)
+    {
+        m_commandCount = commandCount;
+        m_usage = usage;
+        m_splitRanges = false;
+    }
+
+    void IndirectBuffer::SetCommandCount(Uint64 count)
+    {
+        m_commandCount = count;
+    }
+
+    Uint64 IndirectBuffer::GetCommandCount() const
+    {
+        return m_commandCount;
+    }
+
+    BufferUsage IndirectBuffer::GetUsage() const
+    {
+        return m_usage;
+    }
+
+    void IndirectBuffer::SetSplitRanges(bool splitRanges)
+    {
+        m_splitRanges = splitRanges;
+    }
+
+    bool IndirectBuffer::HasSplitRanges() const
+    {
+        return m_splitRanges;
+    }
+
+    PipelineState::PipelineState(const Desc& description, Uint64 hash)
+    {
+        m_description = description;
+        m_hash = hash;
+    }
+
+    const PipelineState::Desc& PipelineState::GetDescription() const
+    {
+        return m_description;
+    }
+
+    Uint64 PipelineState::GetHash() const
+    {
+        return m_hash;
+    }
+
+    static constexpr Uint64 PipelineFieldsCount = 23;
+
+    // Every field but depth biases is widened to 8 bytes, so neither hash nor comparison depends on padding
+    static void GetPipelineFields(const PipelineState::Desc& description, Uint64* result)
+    {
+        const DepthStencilState& depthStencil = description.DepthStencil;
+        const BlendState& blend = description.Blend;
+        const RasterState& raster = description.Raster;
+
+        Uint64 fields[PipelineFieldsCount] = {
+                reinterpret_cast<Uint64>(description.Shader),
+
+                depthStencil.DepthTest, depthStencil.DepthWrite, ENUM_VALUE(depthStencil.DepthFunction),
+                depthStencil.StencilTest, ENUM_VALUE(depthStencil.StencilFunction), depthStencil.StencilReference,
+                depthStencil.StencilReadMask, depthStencil.StencilWriteMask, ENUM_VALUE(depthStencil.StencilFail),
+                ENUM_VALUE(depthStencil.DepthFail), ENUM_VALUE(depthStencil.StencilPass),
+
+                blend.Blending, ENUM_VALUE(blend.SourceColor), ENUM_VALUE(blend.DestinationColor),
+                ENUM_VALUE(blend.ColorOperation), ENUM_VALUE(blend.SourceAlpha), ENUM_VALUE(blend.DestinationAlpha),
+                ENUM_VALUE(blend.AlphaOperation), blend.ColorWriteMask,
+
+                ENUM_VALUE(raster.CullMode), raster.FrontClockwise, ENUM_VALUE(raster.FillMode),
+        };
+
+        CopyMemory(result, fields, sizeof(fields));
+    }
+
+    Uint64 HashPipelineDesc(const PipelineState::Desc& description)
+    {
+        const RasterState& raster = description.Raster;
+
+        Uint64 fields[PipelineFieldsCount];
+        GetPipelineFields(description, fields);
+
+        Uint64 hash = HashMemory(fields, sizeof(fields));
+
+        hash = HashMemory(&raster.DepthBias, sizeof(raster.DepthBias), hash);
+        hash = HashMemory(&raster.SlopeDepthBias, sizeof(raster.SlopeDepthBias), hash);
+
+        return hash;
+    }
+
+    bool ComparePipelineDescs(const PipelineState::Desc& first, const PipelineState::Desc& second)
+    {
+        Uint64 firstFields[PipelineFieldsCount];
+        Uint64 secondFields[PipelineFieldsCount];
+
+        GetPipelineFields(first, firstFields);
+        GetPipelineFields(second, secondFields);
+
+        if (first.Raster.DepthBias != second.Raster.DepthBias)
+            return false;
+
+        if (first.Raster.SlopeDepthBias != second.Raster.SlopeDepthBias)
+            return false;
+
+        return memcmp(firstFields, secondFields, sizeof(firstFields)) == 0;
+    }
+
+    CullingBatch::CullingBatch(Uint64 objectCount)
+    {
+        m_objectCount = objectCount;
+    }
+
+    Uint64 CullingBatch::GetObjectCount() const
+    {
+        return m_objectCount;
+    }
+
+    Texture1D::Texture1D(Allocator *allocator)
+    {
+        m_allocator = allocator;
+
+        m_pixels = nullptr;
+        m_width = 0;
+        m_pixelFormat = PixelFormats::PixelRGBUint8;
+    }
+
+    Texture1D::~Texture1D()
+    {
+        if (m_allocator != nullptr && m_pixels != nullptr)
+            m_allocator->FreeMemory(m_pixels);
+    }
+
+    void Texture1D::SetPixelFormat(PixelFormats pixelFormat)
+    {
+        m_pixelFormat = pixelFormat;
+    }
+
+    PixelFormats Texture1D::GetPixelFormat() const
+    {
+        return m_pixelFormat;
+    }
+
+    void Texture1D::SetPixels(const void *pixels, Uint64 width)
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (width == 0)
+            return;
+
+        if (m_pixels != nullptr)
+            m_allocator->FreeMemory(m_pixels);
+
+        m_pixels = nullptr;
+
+        if (pixels != nullptr)
+        {
+            Uint64 textureSize = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width;
+            m_pixels = m_allocator->AllocateMemory(textureSize);
+            CopyMemory(m_pixels, pixels, textureSize);
+        }
+
+        m_width = width;
+    }
+
+    void* Texture1D::GetPixels() const
+    {
+        return m_pixels;
+    }
+
+    Uint64 Texture1D::Width() const
+    {
+        return m_width;
+    }
+
+    Texture2D::Texture2D(Allocator *allocator)
+    {
+        m_allocator = allocator;
+
+        m_pixels = nullptr;
+        m_width = 0;
+        m_height = 0;
+        m_rowPitch = 0;
+        m_pixelFormat = PixelFormats::PixelRGBUint8;
+    }
+
+    Texture2D::~Texture2D()
+    {
+        if (m_allocator != nullptr && m_pixels != nullptr)
+            m_allocator->FreeMemory(m_pixels);
+    }
+
+    void Texture2D::SetPixelFormat(PixelFormats pixelFormat)
+    {
+        m_pixelFormat = pixelFormat;
+    }
+
+    PixelFormats Texture2D::GetPixelFormat() const
+    {
+        return m_pixelFormat;
+    }
+
+    void Texture2D::SetPixels(const void *pixels, Uint64 width, Uint64 height)
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (width == 0 || height == 0)
+            return;
+
+        if (m_pixels != nullptr)
+            m_allocator->FreeMemory(m_pixels);
+
+        // Texture which is made without pixels (render target's one) keeps only its size
+        m_pixels = nullptr;
+
+        if (pixels != nullptr)
+        {
+            Uint64 textureSize = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width * height;
+            m_pixels = m_allocator->AllocateMemory(textureSize);
+            CopyMemory(m_pixels, pixels, textureSize);
+        }
+
+        m_width = width;
+        m_height = height;
+        m_rowPitch = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width;
+    }
+
+    void* Texture2D::GetPixels() const
+    {
+        return m_pixels;
+    }
+
+    Uint64 Texture2D::Width() const
+    {
+        return m_width;
+    }
+
+    Uint64 Texture2D::Height() const
+    {
+        return m_height;
+    }
+
+    Texture3D::Texture3D(Allocator *allocator)
+    {
+        m_allocator = allocator;
+
+        m_pixels = nullptr;
+        m_width = 0;
+        m_height = 0;
+        m_depth = 0;
+
+        m_rowPitch = 0;
+        m_pixelFormat = PixelFormats::PixelRGBUint8;
+    }
+
+    Texture3D::~Texture3D()
+    {
+        if (m_allocator != nullptr && m_pixels != nullptr)
+            m_allocator->FreeMemory(m_pixels);
+    }
+
+    void Texture3D::SetPixelFormat(PixelFormats pixelFormat)
+    {
+        m_pixelFormat = pixelFormat;
+    }
+
+    PixelFormats Texture3D::GetPixelFormat() const
+    {
+        return m_pixelFormat;
+    }
+
+    void Texture3D::SetPixels(const void *pixels, Uint64 width, Uint64 height, Uint64 depth)
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        if (width == 0 || height == 0 || depth == 0)
+            return;
+
+        if (m_pixels != nullptr)
+            m_allocator->FreeMemory(m_pixels);
+
+        m_pixels = nullptr;
+
+        if (pixels != nullptr)
+        {
+            Uint64 textureSize = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width * height * depth;
+
+            m_pixels = m_allocator->AllocateMemory(textureSize);
+            CopyMemory(m_pixels, pixels, textureSize);
+        }
+
+        m_width = width;
+        m_height = height;
+        m_depth = depth;
+        m_rowPitch = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width;
+        m_rowColumnPitch = GraphicsContext::PixelSizes[ENUM_VALUE(m_pixelFormat)] * width * height;
+    }
+
+    void* Texture3D::GetPixels() const
+    {
+        return m_pixels;
+    }
+
+    Uint64 Texture3D::Width() const
+    {
+        return m_width;
+    }
+
+    Uint64 Texture3D::Height() const
+    {
+        return m_height;
+    }
+
+    Uint64 Texture3D::Depth() const
+    {
+        return m_depth;
+    }
+
+    RenderTarget::RenderTarget(Uint32 width, Uint32 height)
+    {
+        m_width = width;
+        m_height = height;
+
+        for (Texture2D*& colorTexture : m_colorTextures)
+            colorTexture = nullptr;
+        m_colorTexturesUsed = 0;
+
+        m_depthTexture = nullptr;
+        m_stencilTexture = nullptr;
+    }
+
+    Uint32 RenderTarget::Width() const
+    {
+        return m_width;
+    }
+
+    Uint32 RenderTarget::Height() const
+    {
+        return m_height;
+    }
+
+    void RenderTarget::AttachColorTexture(Texture2D* texture)
+    {
+        if (texture->Width() != m_width || texture->Height() != m_height)
+            return;
+
+        if (m_colorTexturesUsed == MaxColorAttachments)
+            return;
+
+        m_colorTextures[m_colorTexturesUsed] = texture;
+        m_colorTexturesUsed++;
+    }
+
+    void RenderTarget::AttachDepthTexture(Texture2D* texture)
+    {
+        if (texture->Width() != m_width || texture->Height() != m_height)
+            return;
+
+        m_depthTexture = texture;
+    }
+
+    void RenderTarget::AttachStencilTexture(Texture2D* texture)
+    {
+        if (texture->Width() != m_width || texture->Height() != m_height)
+            return;
+
+        m_stencilTexture = texture;
+    }
+
+    Texture2D* RenderTarget::GetColorTexture(Uint64 index) const
+    {
+        if (index >= MaxColorAttachments)
+            return nullptr;
+
+        return m_colorTextures[index];
+    }
+
+    Uint64 RenderTarget::GetUsedColorTextures() const
+    {
+        return m_colorTexturesUsed;
+    }
+
+    Texture2D* RenderTarget::GetDepthTexture() const
+    {
+        return m_depthTexture;
+    }
+
+    Texture2D* RenderTarget::GetStencilTexture() const
+    {
+        return m_stencilTexture;
+    }
+
+    Uint64 HashRenderTargetDesc(const RenderTarget::Desc& description)
+    {
+        Uint64 colorCount = MIN(description.ColorAttachmentsCount, RenderTarget::MaxColorAttachments);
+
+        // Every field is widened to 8 bytes, so the hash doesn't depend on padding.
+        // Formats of unused color attachments aren't hashed
+        Uint64 fields[] = {
+                description.Width, description.Height, colorCount,
+                description.DepthAttachment, description.StencilAttachment, ENUM_VALUE(description.DepthFormat),
+        };
+
+        Uint64 hash = HashMemory(fields, sizeof(fields));
+
+        hash = HashMemory(description.ColorFormats, colorCount * sizeof(PixelFormats), hash);
+        hash = HashMemory(&description.SamplingInfo, sizeof(SamplingInfo), hash);
+
+        return hash;
+    }
+
+    bool CompareRenderTargetDescs(const RenderTarget::Desc& first, const RenderTarget::Desc& second)
+    {
+        Uint64 colorCount = MIN(first.ColorAttachmentsCount, RenderTarget::MaxColorAttachments);
+
+        if (first.Width != second.Width || first.Height != second.Height)
+            return false;
+
+        if (colorCount != MIN(second.ColorAttachmentsCount, RenderTarget::MaxColorAttachments))
+            return false;
+
+        for (Uint64 i = 0; i < colorCount; i++)
+        {
+            if (first.ColorFormats[i] != second.ColorFormats[i])
+                return false;
+        }
+
+        if (first.DepthAttachment != second.DepthAttachment || first.StencilAttachment != second.StencilAttachment)
+            return false;
+
+        if (first.DepthFormat != second.DepthFormat)
+            return false;
+
+        return CompareSamplingInfos(first.SamplingInfo, second.SamplingInfo);
+    }
+
+    bool CompareSamplingInfos(const SamplingInfo& first, const SamplingInfo& second)
+    {
+        if (first.AddressMode != second.AddressMode)
+            return false;
+
+        if (first.MinFilter != second.MinFilter || first.MagFilter != second.MagFilter)
+            return false;
+
+        if (first.MaxAnisotropy != second.MaxAnisotropy || first.LODBias != second.LODBias)
+            return false;
+
+        return first.MinLOD == second.MinLOD && first.MaxLOD == second.MaxLOD;
+    }
+
+    void GraphicsContext::Submit(const CommandList* list)
+    {
+        if (list != nullptr)
+            list->Execute(this);
+    }
+
+    void GraphicsContext::Submit(const CommandList* const* lists, Uint64 listsCount)
+    {
+        if (lists == nullptr)
+            return;
+
+        for (Uint64 i = 0; i < listsCount; i++)
+            Submit(lists[i]);
+    }
+}
@@ -1,497 +1,895 @@
-#pragma once
-
-#include <GL/glew.h>
-
-#include "Utils.h"
-#include "Memory.h"
-#include "Window.h"
-#include "DebugSystem.h"
-
-namespace Tiny3D
-{
-    class GraphicsComponent
-    {
-    private:
-        void* m_graphicsHandle = nullptr;
-        Allocator* m_allocator = nullptr;
-
-    public:
-        GraphicsComponent() = default;
-        virtual ~GraphicsComponent();
-
-        template <typename t>
-        void SetComponentHandle(const t* data, Allocator* allocator)
-        {
-            if (allocator == nullptr || data == nullptr)
-                return;
-
-            if (m_allocator != nullptr && m_graphicsHandle != nullptr)
-                m_allocator->FreeMemory(m_graphicsHandle);
-
-            m_allocator = allocator;
-            m_graphicsHandle = allocator->AllocateMemory(sizeof(t));
-            CopyMemory(m_graphicsHandle, data, sizeof(t));
-        }
-
-        template <typename t>
-        t* GetComponentHandle() const
-        {
-            return reinterpret_cast<t*>(m_graphicsHandle);
-        }
-    };
-
-    // TODO (done): create brand-new classes (which has to be inherited from abstract graphics component)
-
-    struct VertexInputElement
-    {
-        const char* Name;
-
-        DataTypes Type;
-        Uint64 Count;
-        bool Normalized;
-    };
-
-    struct VertexLayout
-    {
-        VertexInputElement* Inputs;
-        Uint64 Count;
-    };
-
-    struct ShaderData {
-        const char* VertexShaderCode;
-        const char* GeometryShaderCode;
-        const char* PixelShaderCode;
-    };
-
-    class Shader : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            ShaderData Data;
-            VertexLayout Layout;
-        };
-
-    private:
-        Uint64 m_bindedBuffers = 0;
-        Uint64 m_bindedTextures = 0;
-
-    public:
-        Shader() = default;
-
-        void AddBufferBinding();
-        void AddTextureBinding();
-
-        void ClearBindings();
-
-        Uint64 GetBufferBindings() const;
-        Uint64 GetTextureBindings() const;
-    };
-
-    enum class BufferUsage : Uint64
-    {
-        StaticUsage,
-        StreamUsage,
-        DynamicUsage,
-    };
-
-    class VertexBuffer : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            void* Vertices;
-            Uint64 VertexSize;
-            Uint64 VertexCount;
-
-            VertexLayout Layout;
-            BufferUsage Usage;
-        };
-
-    private:
-        void* m_vertices;
-        Uint64 m_vertexSize;
-        Uint64 m_vertexCount;
-
-        Allocator* m_allocator;
-
-    public:
-        VertexBuffer(Uint64 vertexSize, Allocator* allocator);
-        ~VertexBuffer();
-
-        void SetVertices(const void* data, Uint64 count);
-        void* GetVertices() const;
-
-        Uint64 GetVertexSize() const;
-        Uint64 GetVertexCount() const;
-
-        Uint64 GetBufferSize() const;
-    };
-
-    enum class IndexType : Uint64
-    {
-        UnsignedByteIndex,
-        UnsignedShortIndex,
-        UnsignedIntIndex,
-    };
-
-    class IndexBuffer : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            void* Indices;
-            IndexType IndexType;
-            Uint64 IndexCount;
-
-            BufferUsage Usage;
-        };
-
-    private:
-        void* m_indices;
-        IndexType m_indexType;
-        Uint64 m_indexCount;
-
-        Allocator* m_allocator;
-
-        static constexpr Uint64 IndexSizes[3] = {
-                1, 2, 4,
-        };
-
-    public:
-        IndexBuffer(IndexType type, Allocator* allocator);
-        ~IndexBuffer();
-
-        void SetIndices(const void* data, Uint64 count);
-        void* GetIndices() const;
-
-        Uint64 GetIndexCount() const;
-        IndexType GetIndexType() const;
-
-        Uint64 GetBufferSize() const;
-    };
-
-    class UniformBuffer : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            void* Data;
-            Uint64 Size;
-
-            BufferUsage Usage;
-        };
-
-    private:
-        void* m_data;
-        Uint64 m_size;
-
-        Allocator* m_allocator;
-
-    public:
-        UniformBuffer(Allocator* allocator);
-        ~UniformBuffer();
-
-        void SetData(const void* data, Uint64 size);
-        void* GetData() const;
-
-        Uint64 GetSize() const;
-    };
-
-    enum class TextureAddressModes : Uint64
-    {
-        AddressRepeat,
-        AddressMirroredRepeat,
-        AddressClamp,
-        AddressBorder,
-    };
-
-    enum class TextureFilters : Uint64
-    {
-        FilterLinear,
-        FilterNearest,
-    };
-
-    struct SamplingInfo
-    {
-        TextureAddressModes AddressMode = TextureAddressModes::AddressBorder;
-        TextureFilters MinFilter = TextureFilters::FilterLinear;
-        TextureFilters MagFilter = TextureFilters::FilterLinear;
-
-        Float32 MaxAnisotropy = 0.0f;
-
-        Float32 MinLOD = -1000;
-        Float32 MaxLOD = 1000;
-        Float32 LODBias = 0;
-    };
-
-    enum class PixelFormats : Uint64
-    {
-        PixelRGBAUint8, PixelRGBUint8,
-        PixelRGBAInt8, PixelRGBInt8,
-
-        PixelRGBAUint16, PixelRGBUint16,
-        PixelRGBAInt16, PixelRGBInt16,
-
-        PixelRGBAUint32, PixelRGBUint32,
-        PixelRGBAInt32, PixelRGBInt32,
-
-        PixelRGBAFloat32, PixelRGBFloat32,
-
-        PixelDepth16,
-        PixelDepth24,
-        PixelDepth32,
-
-        PixelStencilUint8,
-    };
-
-    class Texture1D : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            Uint64 Width;
-            PixelFormats PixelFormat;
-            SamplingInfo SamplingInfo;
-            void* Pixels;
-        };
-
-    private:
-        void* m_pixels;
-
-        PixelFormats m_pixelFormat;
-        Uint64 m_width;
-
-        Allocator* m_allocator;
-
-    public:
-        Texture1D(Allocator* allocator);
-        ~Texture1D();
-
-        void SetPixelFormat(PixelFormats pixelFormat);
-        PixelFormats GetPixelFormat() const;
-
-        void SetPixels(const void* pixels, Uint64 width);
-        void* GetPixels() const;
-
-        Uint64 Width() const;
-    };
-
-    class Texture2D : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            Uint64 Width, Height;
-            PixelFormats PixelFormat;
-            SamplingInfo SamplingInfo;
-            void* Pixels;
-        };
-
-    private:
-        void* m_pixels;
-
-        PixelFormats m_pixelFormat;
-        Uint64 m_width, m_height;
-        Uint64 m_rowPitch;
-
-        Allocator* m_allocator;
-
-    public:
-        Texture2D(Allocator* allocator);
-        ~Texture2D();
-
-        void SetPixelFormat(PixelFormats pixelFormat);
-        PixelFormats GetPixelFormat() const;
-
-        void SetPixels(const void* pixels, Uint64 width, Uint64 height);
-        void* GetPixels() const;
-
-        Uint64 Width() const;
-        Uint64 Height() const;
-    };
-
-    class Texture3D : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            Uint64 Width, Height, Depth;
-            PixelFormats PixelFormat;
-            SamplingInfo SamplingInfo;
-            void* Pixels;
-        };
-
-    private:
-        void* m_pixels;
-
-        PixelFormats m_pixelFormat;
-        Uint64 m_width, m_height, m_depth;
-        Uint64 m_rowPitch, m_rowColumnPitch;
-
-        Allocator* m_allocator;
-
-    public:
-        Texture3D(Allocator* allocator);
-        ~Texture3D();
-
-        void SetPixelFormat(PixelFormats pixelFormat);
-        PixelFormats GetPixelFormat() const;
-
-        void SetPixels(const void* pixels, Uint64 width, Uint64 height, Uint64 depth);
-        void* GetPixels() const;
-
-        Uint64 Width() const;
-        Uint64 Height() const;
-        Uint64 Depth() const;
-    };
-
-    class RenderTarget : public GraphicsComponent
-    {
-    public:
-        struct Desc
-        {
-            Uint32 Width, Height;
-
-            Uint64 ColorAttachmentsCount = 1;
-            bool DepthAttachment = false;
-            bool StencilAttachment = false;
-        };
-
-        static const Uint64 MaxColorAttachments = 10;
-
-    private:
-        Uint32 m_width, m_height;
-
-        Texture2D* m_colorTextures[MaxColorAttachments];
-        Uint64 m_colorTexturesUsed;
-
-        Texture2D* m_depthTexture;
-        Texture2D* m_stencilTexture;
-
-    public:
-        RenderTarget(Uint32 width, Uint32 height);
-
-        void AttachColorTexture(Texture2D* texture);
-        void AttachDepthTexture(Texture2D* texture);
-        void AttachStencilTexture(Texture2D* texture);
-
-        Texture2D* GetColorTexture(Uint64 index) const;
-        Uint64 GetUsedColorTextures() const;
-
-        Texture2D* GetDepthTexture() const;
-        Texture2D* GetStencilTexture() const;
-    };
-
-    enum class PrimitiveToplogies : Uint64
-    {
-        Points,
-        Lines,
-        LineStrip,
-        Triangles,
-        TriangleStrip,
-    };
-
-    class GraphicsContext
-    {
-    protected:
-        bool m_colorBuffer;
-        bool m_depthBuffer;
-        bool m_stencilBuffer;
-
-    public:
-        struct GraphicsAllocators
-        {
-            Allocator* StructAllocator;
-            Allocator* BufferAllocator;
-            Allocator* TextureAllocator;
-        };
-
-        static constexpr Uint64 PixelSizes[18] = {
-                4, 3,
-                3, 3,
-
-                8, 6,
-                8, 6,
-
-                16, 12,
-                16, 12,
-                16, 12,
-
-                2,
-                4,
-                4,
-                1,
-        };
-
-        virtual ~GraphicsContext() = default;
-
-        virtual void SetTarget() = 0;
-        virtual void SetTarget(RenderTarget* renderTarget) = 0;
-
-        virtual void EnableDepthTest() = 0;
-        virtual void DisableDepthTest() = 0;
-
-        virtual void EnableStencilTest() = 0;
-        virtual void DisableStencilTest() = 0;
-
-        virtual void ClearTarget(Float32 red, Float32 green, Float32 blue) = 0;
-
-        virtual VertexBuffer* CreateVertexBuffer(VertexBuffer::Desc description) = 0;
-        virtual IndexBuffer* CreateIndexBuffer(IndexBuffer::Desc description) = 0;
-        virtual UniformBuffer* CreateUniformBuffer(UniformBuffer::Desc description) = 0;
-
-        virtual void OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 vertexCount) = 0;
-        virtual void OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 newCount) = 0;
-        virtual void OverwriteBuffer(UniformBuffer* ubo, const void* newData, Uint64 newSize) = 0;
-
-        virtual void ReleaseBuffer(VertexBuffer* vbo) = 0;
-        virtual void ReleaseBuffer(IndexBuffer* ibo) = 0;
-        virtual void ReleaseBuffer(UniformBuffer* ubo) = 0;
-
-        virtual Shader* CreateShader(Shader::Desc description) = 0;
-        virtual void ReleaseShader(Shader* shader) = 0;
-
-        virtual void BindShader(Shader* shader) = 0;
-        virtual void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo) = 0;
-        virtual void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo,
-                                             Uint64 offset, Uint64 size) = 0;
-
-        virtual Texture1D* CreateTexture1D(Texture1D::Desc description) = 0;
-        virtual Texture2D* CreateTexture2D(Texture2D::Desc description) = 0;
-        virtual Texture3D* CreateTexture3D(Texture3D::Desc description) = 0;
-
-        // TODO: Rewrite this methods.
-        //  Overwriting textures should not change pixel format
-        //  Сreate two varitaions of texture overwriting (the first one overwrites whole texture
-        //  and the second one - just a part by given offset settings)
-
-        // Overwriting texture functon keeps texture's pixel format and changes pixels
-        // Add offset params in texture's methods
-        // Add offset params in buffer's methods
-        
-        virtual void OverwriteTexture(Texture1D* texture, Uint64 width,
-                                      const void* data) = 0;
-        virtual void OverwriteTexture(Texture2D* texture, Uint64 width, Uint64 height,
-                                      const void* data) = 0;
-        virtual void OverwriteTexture(Texture3D* texture, Uint64 width, Uint64 height, Uint64 depth,
-                                      const void* data) = 0;
-
-        virtual void ReleaseTexture(Texture1D* texture) = 0;
-        virtual void ReleaseTexture(Texture2D* texture) = 0;
-        virtual void ReleaseTexture(Texture3D* texture) = 0;
-
-        virtual void BindShaderTexture(Shader* shader, const char* name, const Texture1D* texture) = 0;
-        virtual void BindShaderTexture(Shader* shader, const char* name, const Texture2D* texture) = 0;
-        virtual void BindShaderTexture(Shader* shader, const char* name, const Texture3D* texture) = 0;
-
-        // virtual RenderTarget* CreateRenderTarget(RenderTarget::Desc description) = 0;
-        // virtual void ReleaseRenderTarget(RenderTarget* renderTarget) = 0;
-
-        virtual void Draw(PrimitiveToplogies topology, VertexBuffer* vbo) = 0;
-        virtual void DrawIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo) = 0;
-
-        virtual void PresentGraphics() = 0;
-    };
-}
-
+#pragma once
+
+#include <GL/glew.h>
+
+#include "Utils.h"
+#include "Memory.h"
+#include "Window.h"
+#include "DebugSystem.h"
+#include "Frustum.h"
+
+namespace Tiny3D
+{
+    class GraphicsComponent
+    {
+    private:
+        void* m_graphicsHandle = nullptr;
+        Allocator* m_allocator = nullptr;
+
+    public:
+        GraphicsComponent() = default;
+        virtual ~GraphicsComponent();
+
+        template <typename t>
+        void SetComponentHandle(const t* data, Allocator* allocator)
+        {
+            if (allocator == nullptr || data == nullptr)
+                return;
+
+            if (m_allocator != nullptr && m_graphicsHandle != nullptr)
+                m_allocator->FreeMemory(m_graphicsHandle);
+
+            m_allocator = allocator;
+            m_graphicsHandle = allocator->AllocateMemory(sizeof(t));
+            CopyMemory(m_graphicsHandle, data, sizeof(t));
+        }
+
+        template <typename t>
+        t* GetComponentHandle() const
+        {
+            return reinterpret_cast<t*>(m_graphicsHandle);
+        }
+    };
+
+    // TODO (done): create brand-new classes (which has to be inherited from abstract graphics component)
+
+    static constexpr Uint64 VertexElementAutoOffset = ~0ull;
+
+    struct VertexInputElement
+    {
+        const char* Name;
+
+        DataTypes Type;
+        Uint64 Count;
+        bool Normalized;
+
+        // Elements with automatic offset are packed right after the previous one
+        Uint64 Offset = VertexElementAutoOffset;
+
+        // Per-vertex element has zero step rate, per-instance element advances once per this count of instances
+        Uint64 InstanceStepRate = 0;
+    };
+
+    struct VertexLayout
+    {
+        VertexInputElement* Inputs;
+        Uint64 Count;
+
+        // Set by MakeVertexLayout (see VertexFormat.h). Such layouts are checked at compile time,
+        // have all offsets and stride filled and are shared between all buffers of the same format
+        Uint64 Stride = 0;
+        bool Precomputed = false;
+    };
+
+    // Precompiled SPIR-V module of one stage
+    struct ShaderBinary
+    {
+        const void* Code;
+        Uint64 Size;
+
+        // Nullptr means "main"
+        const char* EntryPoint;
+
+        // Specialization constants of the module (IDs are given by constant_id)
+        const Uint32* ConstantIDs;
+        const Uint32* ConstantValues;
+        Uint64 ConstantsCount;
+    };
+
+    struct ShaderData {
+        const char* VertexShaderCode;
+        const char* GeometryShaderCode;
+        const char* PixelShaderCode;
+
+        // Stages without GLSL code are taken from SPIR-V modules. Resources of module are bound by name
+        // only if it keeps names (wasn't stripped of debug information)
+        ShaderBinary VertexShaderBinary;
+        ShaderBinary GeometryShaderBinary;
+        ShaderBinary PixelShaderBinary;
+    };
+
+    // Hashed name of uniform block or sampler of shader. Binding by ID doesn't look at the string at all,
+    // so IDs are better to be made once (name of sampler array is the name without brackets)
+    struct ShaderBindingID
+    {
+        Uint64 Hash;
+    };
+
+    ShaderBindingID MakeShaderBindingID(const char* name);
+
+    class Shader : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            ShaderData Data;
+            VertexLayout Layout;
+        };
+
+    private:
+        Uint64 m_bindedBuffers = 0;
+        Uint64 m_bindedTextures = 0;
+
+    public:
+        Shader() = default;
+
+        void AddBufferBinding();
+        void AddTextureBinding();
+
+        void ClearBindings();
+
+        Uint64 GetBufferBindings() const;
+        Uint64 GetTextureBindings() const;
+    };
+
+    // Hash of sources (or modules with constants) of all stages and of vertex layout
+    Uint64 HashShaderDesc(const Shader::Desc& description);
+
+    enum class CompareFunctions : Uint64
+    {
+        Never,
+        Less,
+        Equal,
+        LessEqual,
+        Greater,
+        NotEqual,
+        GreaterEqual,
+        Always,
+    };
+
+    enum class StencilOperations : Uint64
+    {
+        Keep,
+        Zero,
+        Replace,
+        Increment,
+        IncrementWrap,
+        Decrement,
+        DecrementWrap,
+        Invert,
+    };
+
+    enum class BlendFactors : Uint64
+    {
+        Zero,
+        One,
+        SourceColor,
+        OneMinusSourceColor,
+        DestinationColor,
+        OneMinusDestinationColor,
+        SourceAlpha,
+        OneMinusSourceAlpha,
+        DestinationAlpha,
+        OneMinusDestinationAlpha,
+    };
+
+    enum class BlendOperations : Uint64
+    {
+        Add,
+        Subtract,
+        ReverseSubtract,
+        Minimum,
+        Maximum,
+    };
+
+    enum class CullModes : Uint64
+    {
+        CullNone,
+        CullFront,
+        CullBack,
+    };
+
+    enum class FillModes : Uint64
+    {
+        FillSolid,
+        FillWireframe,
+    };
+
+    static constexpr Uint32 ColorWriteRed = 1;
+    static constexpr Uint32 ColorWriteGreen = 2;
+    static constexpr Uint32 ColorWriteBlue = 4;
+    static constexpr Uint32 ColorWriteAlpha = 8;
+    static constexpr Uint32 ColorWriteAll = 15;
+
+    struct DepthStencilState
+    {
+        bool DepthTest = false;
+        bool DepthWrite = true;
+        CompareFunctions DepthFunction = CompareFunctions::Less;
+
+        bool StencilTest = false;
+        CompareFunctions StencilFunction = CompareFunctions::Always;
+        Uint32 StencilReference = 0;
+        Uint32 StencilReadMask = 0xFF;
+        Uint32 StencilWriteMask = 0xFF;
+
+        StencilOperations StencilFail = StencilOperations::Keep;
+        StencilOperations DepthFail = StencilOperations::Keep;
+        StencilOperations StencilPass = StencilOperations::Keep;
+    };
+
+    // Result is Source * SourceFactor (operation) Destination * DestinationFactor, alpha is blended apart
+    struct BlendState
+    {
+        bool Blending = false;
+
+        BlendFactors SourceColor = BlendFactors::One;
+        BlendFactors DestinationColor = BlendFactors::Zero;
+        BlendOperations ColorOperation = BlendOperations::Add;
+
+        BlendFactors SourceAlpha = BlendFactors::One;
+        BlendFactors DestinationAlpha = BlendFactors::Zero;
+        BlendOperations AlphaOperation = BlendOperations::Add;
+
+        // ColorWrite flags
+        Uint32 ColorWriteMask = ColorWriteAll;
+    };
+
+    // Triangles with counter-clockwise vertices are front ones unless FrontClockwise is set
+    struct RasterState
+    {
+        CullModes CullMode = CullModes::CullNone;
+        bool FrontClockwise = false;
+        FillModes FillMode = FillModes::FillSolid;
+
+        // Offset of depth is DepthBias units of depth buffer plus SlopeDepthBias times slope of triangle
+        Float32 DepthBias = 0.0f;
+        Float32 SlopeDepthBias = 0.0f;
+    };
+
+    // Shader with all of the fixed-function state it's drawn with. State objects are immutable and are made
+    // up front, binding one changes only the states which differ from the applied ones
+    class PipelineState : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            Shader* Shader;
+
+            DepthStencilState DepthStencil;
+            BlendState Blend;
+            RasterState Raster;
+        };
+
+    private:
+        Desc m_description;
+        Uint64 m_hash;
+
+    public:
+        PipelineState(const Desc& description, Uint64 hash);
+
+        const Desc& GetDescription() const;
+        Uint64 GetHash() const;
+    };
+
+    // Hash of shader (by pointer) and of all the states, padding of structs isn't hashed
+    Uint64 HashPipelineDesc(const PipelineState::Desc& description);
+    bool ComparePipelineDescs(const PipelineState::Desc& first, const PipelineState::Desc& second);
+
+    enum class BufferUsage : Uint64
+    {
+        StaticUsage,
+        StreamUsage,
+        DynamicUsage,
+    };
+
+    class VertexBuffer : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            void* Vertices;
+            Uint64 VertexSize;
+            Uint64 VertexCount;
+
+            VertexLayout Layout;
+            BufferUsage Usage;
+
+            // Vertices are read by vertex shader from storage buffer (see MakeVertexPullingCode), not by VAO.
+            // Such buffer can keep meshes of different layouts when every mesh starts at multiple of its vertex size
+            // (base vertex of draw picks the mesh)
+            bool VertexPulling = false;
+        };
+
+    private:
+        void* m_vertices;
+        Uint64 m_vertexSize;
+        Uint64 m_vertexCount;
+
+        Allocator* m_allocator;
+
+    public:
+        VertexBuffer(Uint64 vertexSize, Allocator* allocator);
+        ~VertexBuffer();
+
+        void SetVertices(const void* data, Uint64 count);
+        void* GetVertices() const;
+
+        Uint64 GetVertexSize() const;
+        Uint64 GetVertexCount() const;
+
+        Uint64 GetBufferSize() const;
+    };
+
+    enum class IndexType : Uint64
+    {
+        UnsignedByteIndex,
+        UnsignedShortIndex,
+        UnsignedIntIndex,
+    };
+
+    class IndexBuffer : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            void* Indices;
+            IndexType IndexType;
+            Uint64 IndexCount;
+
+            BufferUsage Usage;
+
+            // Store indices in the narrowest type which fits them. Triangle lists with too wide range
+            // of 32-bit indices are split into 16-bit ranges which are drawn with base vertex
+            bool NarrowIndices = false;
+
+            // Indices form a triangle list. Only such buffers are split into ranges, the others are
+            // narrowed only when the whole buffer fits
+            bool TriangleList = false;
+        };
+
+        // Part of buffer which is drawn with its own base vertex (buffer without ranges is drawn whole)
+        struct Range
+        {
+            Uint64 FirstIndex;
+            Uint64 IndexCount;
+            Int64 BaseVertex;
+        };
+
+        static const Uint64 MaxRanges = 16;
+
+    private:
+        void* m_indices;
+        IndexType m_indexType;
+        IndexType m_sourceIndexType;
+        Uint64 m_indexCount;
+
+        Range m_ranges[MaxRanges];
+        Uint64 m_rangesUsed;
+
+        Allocator* m_allocator;
+
+        static constexpr Uint64 IndexSizes[3] = {
+                1, 2, 4,
+        };
+
+    public:
+        IndexBuffer(IndexType type, Allocator* allocator);
+        ~IndexBuffer();
+
+        static Uint64 GetIndexSize(IndexType type);
+
+        static Uint32 ReadIndex(const void* indices, IndexType type, Uint64 position);
+        static void WriteIndex(void* indices, IndexType type, Uint64 position, Uint32 value);
+
+        void SetIndices(const void* data, Uint64 count);
+        void* GetIndices() const;
+
+        Uint64 GetIndexCount() const;
+        IndexType GetIndexType() const;
+
+        // Type of indices which were given by user (it differs from index type of narrowed buffers)
+        void SetSourceIndexType(IndexType type);
+        IndexType GetSourceIndexType() const;
+
+        void SetRanges(const Range* ranges, Uint64 count);
+        const Range* GetRanges() const;
+        Uint64 GetRangesCount() const;
+
+        Uint64 GetBufferSize() const;
+    };
+
+    class UniformBuffer : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            void* Data;
+            Uint64 Size;
+
+            BufferUsage Usage;
+        };
+
+    private:
+        void* m_data;
+        Uint64 m_size;
+
+        Allocator* m_allocator;
+
+    public:
+        UniformBuffer(Allocator* allocator);
+        ~UniformBuffer();
+
+        void SetData(const void* data, Uint64 size);
+        void* GetData() const;
+
+        Uint64 GetSize() const;
+    };
+
+    // Layout is the same as DrawElementsIndirectCommand of OpenGL. Indices and vertices are counted
+    // in units of index buffer and vertex buffer which are given to DrawIndexedIndirect
+    struct DrawIndexedCommand
+    {
+        Uint32 IndexCount;
+        Uint32 InstanceCount;
+        Uint32 FirstIndex;
+        Int32 BaseVertex;
+        Uint32 BaseInstance;
+    };
+
+    // GPU buffer of draw commands (commands aren't kept on CPU side, see DrawCommandBuilder)
+    class IndirectBuffer : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            const DrawIndexedCommand* Commands;
+            Uint64 CommandCount;
+
+            BufferUsage Usage;
+
+            // Commands were made by DrawCommandBuilder::Append(IndexBuffer*) and have base vertices of ranges,
+            // so they can be drawn with index buffer which was split into ranges
+            bool SplitRanges = false;
+        };
+
+    private:
+        Uint64 m_commandCount;
+        BufferUsage m_usage;
+        bool m_splitRanges;
+
+    public:
+        IndirectBuffer(Uint64 commandCount, BufferUsage usage);
+
+        void SetCommandCount(Uint64 count);
+        Uint64 GetCommandCount() const;
+
+        void SetSplitRanges(bool splitRanges);
+        bool HasSplitRanges() const;
+
+        BufferUsage GetUsage() const;
+    };
+
+    // Objects which are culled and drawn on GPU: every object has bounding sphere (center and radius,
+    // 4 floats) and draw command. Visible commands are written by compute shader right into indirect buffer
+    class CullingBatch : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            const Float32* Spheres;
+            const DrawIndexedCommand* Commands;
+            Uint64 ObjectCount;
+
+            BufferUsage Usage;
+        };
+
+    private:
+        Uint64 m_objectCount;
+
+    public:
+        explicit CullingBatch(Uint64 objectCount);
+
+        Uint64 GetObjectCount() const;
+    };
+
+    enum class TextureAddressModes : Uint64
+    {
+        AddressRepeat,
+        AddressMirroredRepeat,
+        AddressClamp,
+        AddressBorder,
+    };
+
+    enum class TextureFilters : Uint64
+    {
+        FilterLinear,
+        FilterNearest,
+    };
+
+    struct SamplingInfo
+    {
+        TextureAddressModes AddressMode = TextureAddressModes::AddressBorder;
+        TextureFilters MinFilter = TextureFilters::FilterLinear;
+        TextureFilters MagFilter = TextureFilters::FilterLinear;
+
+        Float32 MaxAnisotropy = 0.0f;
+
+        Float32 MinLOD = -1000;
+        Float32 MaxLOD = 1000;
+        Float32 LODBias = 0;
+    };
+
+    bool CompareSamplingInfos(const SamplingInfo& first, const SamplingInfo& second);
+
+    enum class PixelFormats : Uint64
+    {
+        PixelRGBAUint8, PixelRGBUint8,
+        PixelRGBAInt8, PixelRGBInt8,
+
+        PixelRGBAUint16, PixelRGBUint16,
+        PixelRGBAInt16, PixelRGBInt16,
+
+        PixelRGBAUint32, PixelRGBUint32,
+        PixelRGBAInt32, PixelRGBInt32,
+
+        PixelRGBAFloat32, PixelRGBFloat32,
+
+        PixelDepth16,
+        PixelDepth24,
+        PixelDepth32,
+
+        PixelStencilUint8,
+
+        // Depth with stencil in one texture (separate depth and stencil attachments are rarely supported)
+        PixelDepth24Stencil8,
+    };
+
+    class Texture1D : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            Uint64 Width;
+            PixelFormats PixelFormat;
+            SamplingInfo SamplingInfo;
+            void* Pixels;
+        };
+
+    private:
+        void* m_pixels;
+
+        PixelFormats m_pixelFormat;
+        Uint64 m_width;
+
+        Allocator* m_allocator;
+
+    public:
+        Texture1D(Allocator* allocator);
+        ~Texture1D();
+
+        void SetPixelFormat(PixelFormats pixelFormat);
+        PixelFormats GetPixelFormat() const;
+
+        void SetPixels(const void* pixels, Uint64 width);
+        void* GetPixels() const;
+
+        Uint64 Width() const;
+    };
+
+    class Texture2D : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            Uint64 Width, Height;
+            PixelFormats PixelFormat;
+            SamplingInfo SamplingInfo;
+            void* Pixels;
+        };
+
+    private:
+        void* m_pixels;
+
+        PixelFormats m_pixelFormat;
+        Uint64 m_width, m_height;
+        Uint64 m_rowPitch;
+
+        Allocator* m_allocator;
+
+    public:
+        Texture2D(Allocator* allocator);
+        ~Texture2D();
+
+        void SetPixelFormat(PixelFormats pixelFormat);
+        PixelFormats GetPixelFormat() const;
+
+        void SetPixels(const void* pixels, Uint64 width, Uint64 height);
+        void* GetPixels() const;
+
+        Uint64 Width() const;
+        Uint64 Height() const;
+    };
+
+    class Texture3D : public GraphicsComponent
+    {
+    public:
+        struct Desc
+        {
+            Uint64 Width, Height, Depth;
+            PixelFormats PixelFormat;
+            SamplingInfo SamplingInfo;
+            void* Pixels;
+        };
+
+    private:
+        void* m_pixels;
+
+        PixelFormats m_pixelFormat;
+        Uint64 m_width, m_height, m_depth;
+        Uint64 m_rowPitch, m_rowColumnPitch;
+
+        Allocator* m_allocator;
+
+    public:
+        Texture3D(Allocator* allocator);
+        ~Texture3D();
+
+        void SetPixelFormat(PixelFormats pixelFormat);
+        PixelFormats GetPixelFormat() const;
+
+        void SetPixels(const void* pixels, Uint64 width, Uint64 height, Uint64 depth);
+        void* GetPixels() const;
+
+        Uint64 Width() const;
+        Uint64 Height() const;
+        Uint64 Depth() const;
+    };
+
+    // Framebuffer with textures of its attachments. Target which is made by the context owns its textures,
+    // they have one mip level and can be sampled after rendering
+    class RenderTarget : public GraphicsComponent
+    {
+    public:
+        static const Uint64 MaxColorAttachments = 10;
+
+        struct Desc
+        {
+            Uint32 Width, Height;
+
+            Uint64 ColorAttachmentsCount = 1;
+            PixelFormats ColorFormats[MaxColorAttachments] = {};
+
+            // Stencil is always kept with depth (PixelDepth24Stencil8), so DepthFormat is used only without it
+            bool DepthAttachment = false;
+            bool StencilAttachment = false;
+            PixelFormats DepthFormat = PixelFormats::PixelDepth24;
+
+            SamplingInfo SamplingInfo;
+        };
+
+    private:
+        Uint32 m_width, m_height;
+
+        Texture2D* m_colorTextures[MaxColorAttachments];
+        Uint64 m_colorTexturesUsed;
+
+        Texture2D* m_depthTexture;
+        Texture2D* m_stencilTexture;
+
+    public:
+        RenderTarget(Uint32 width, Uint32 height);
+
+        Uint32 Width() const;
+        Uint32 Height() const;
+
+        void AttachColorTexture(Texture2D* texture);
+        void AttachDepthTexture(Texture2D* texture);
+        void AttachStencilTexture(Texture2D* texture);
+
+        Texture2D* GetColorTexture(Uint64 index) const;
+        Uint64 GetUsedColorTextures() const;
+
+        Texture2D* GetDepthTexture() const;
+        Texture2D* GetStencilTexture() const;
+    };
+
+    // Hash of size, formats and sampling of attachments (formats of unused color attachments aren't hashed).
+    // Descriptions with the same hash may differ, so they are compared by CompareRenderTargetDescs
+    Uint64 HashRenderTargetDesc(const RenderTarget::Desc& description);
+    bool CompareRenderTargetDescs(const RenderTarget::Desc& first, const RenderTarget::Desc& second);
+
+    enum class PrimitiveToplogies : Uint64
+    {
+        Points,
+        Lines,
+        LineStrip,
+        Triangles,
+        TriangleStrip,
+    };
+
+    class CommandList;
+
+    class GraphicsContext
+    {
+    protected:
+        bool m_colorBuffer;
+        bool m_depthBuffer;
+        bool m_stencilBuffer;
+
+    public:
+        struct GraphicsAllocators
+        {
+            Allocator* StructAllocator;
+            Allocator* BufferAllocator;
+            Allocator* TextureAllocator;
+        };
+
+        static constexpr Uint64 PixelSizes[19] = {
+                4, 3,
+                3, 3,
+
+                8, 6,
+                8, 6,
+
+                16, 12,
+                16, 12,
+                16, 12,
+
+                2,
+                4,
+                4,
+                1,
+
+                4,
+        };
+
+        virtual ~GraphicsContext() = default;
+
+        virtual void SetTarget() = 0;
+        virtual void SetTarget(RenderTarget* renderTarget) = 0;
+
+        virtual void EnableDepthTest() = 0;
+        virtual void DisableDepthTest() = 0;
+
+        virtual void EnableStencilTest() = 0;
+        virtual void DisableStencilTest() = 0;
+
+        virtual void ClearTarget(Float32 red, Float32 green, Float32 blue) = 0;
+
+        virtual VertexBuffer* CreateVertexBuffer(VertexBuffer::Desc description) = 0;
+        virtual IndexBuffer* CreateIndexBuffer(IndexBuffer::Desc description) = 0;
+        virtual UniformBuffer* CreateUniformBuffer(UniformBuffer::Desc description) = 0;
+
+        virtual void OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 vertexCount) = 0;
+        virtual void OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 newCount) = 0;
+        virtual void OverwriteBuffer(UniformBuffer* ubo, const void* newData, Uint64 newSize) = 0;
+
+        // Overwrite a part of buffer starting from the given vertex or index (size of buffer is kept)
+        virtual void OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 firstVertex,
+                                     Uint64 vertexCount) = 0;
+        virtual void OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 firstIndex,
+                                     Uint64 indexCount) = 0;
+
+        virtual void ReleaseBuffer(VertexBuffer* vbo) = 0;
+        virtual void ReleaseBuffer(IndexBuffer* ibo) = 0;
+        virtual void ReleaseBuffer(UniformBuffer* ubo) = 0;
+
+        virtual IndirectBuffer* CreateIndirectBuffer(IndirectBuffer::Desc description) = 0;
+
+        // Buffer grows if there are more commands than it has
+        virtual void OverwriteBuffer(IndirectBuffer* buffer, const DrawIndexedCommand* commands, Uint64 commandCount) = 0;
+        virtual void ReleaseBuffer(IndirectBuffer* buffer) = 0;
+
+        virtual CullingBatch* CreateCullingBatch(CullingBatch::Desc description) = 0;
+
+        // Overwrites objectCount objects starting from firstObject (spheres or commands may be nullptr)
+        virtual void OverwriteBatch(CullingBatch* batch, const Float32* spheres, const DrawIndexedCommand* commands,
+                                    Uint64 firstObject, Uint64 objectCount) = 0;
+        virtual void ReleaseCullingBatch(CullingBatch* batch) = 0;
+
+        // Culls objects of batch against world-space frustum on GPU (bound shader is kept)
+        virtual void CullBatch(CullingBatch* batch, const Frustum& frustum) = 0;
+
+        // Count of objects which passed the last culling. It waits for GPU, so it's only for debugging
+        virtual Uint64 ReadCulledCount(CullingBatch* batch) = 0;
+
+        virtual Shader* CreateShader(Shader::Desc description) = 0;
+
+        // Returns right after compilation is issued. Shader can be used at once (the first use waits for it),
+        // IsShaderReady tells if it can be used without waiting
+        virtual Shader* CreateShaderAsync(Shader::Desc description) = 0;
+        virtual bool IsShaderReady(Shader* shader) = 0;
+
+        // CreateShader returns nullptr if program fails to link, asynchronous shader is checked by this call
+        // (it waits for compilation). Shader which isn't linked can't be bound
+        virtual bool IsShaderLinked(Shader* shader) = 0;
+        virtual void ReleaseShader(Shader* shader) = 0;
+
+        virtual void BindShader(Shader* shader) = 0;
+
+        // The same description gives the same object (it's released when all of its users released it)
+        virtual PipelineState* CreatePipelineState(PipelineState::Desc description) = 0;
+        virtual void ReleasePipelineState(PipelineState* state) = 0;
+
+        // Binds shader of state and applies only the render states which differ from the applied ones.
+        // Null state keeps the bound shader and returns render states to defaults
+        virtual void BindPipelineState(PipelineState* state) = 0;
+        virtual void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo) = 0;
+        virtual void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo,
+                                             Uint64 offset, Uint64 size) = 0;
+
+        virtual void BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo) = 0;
+        virtual void BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                                             Uint64 offset, Uint64 size) = 0;
+
+        virtual Texture1D* CreateTexture1D(Texture1D::Desc description) = 0;
+        virtual Texture2D* CreateTexture2D(Texture2D::Desc description) = 0;
+        virtual Texture3D* CreateTexture3D(Texture3D::Desc description) = 0;
+
+        // TODO: Rewrite this methods.
+        //  Overwriting textures should not change pixel format
+        //  Сreate two varitaions of texture overwriting (the first one overwrites whole texture
+        //  and the second one - just a part by given offset settings)
+
+        // Overwriting texture functon keeps texture's pixel format and changes pixels
+        // Add offset params in texture's methods
+        
+        virtual void OverwriteTexture(Texture1D* texture, Uint64 width,
+                                      const void* data) = 0;
+        virtual void OverwriteTexture(Texture2D* texture, Uint64 width, Uint64 height,
+                                      const void* data) = 0;
+        virtual void OverwriteTexture(Texture3D* texture, Uint64 width, Uint64 height, Uint64 depth,
+                                      const void* data) = 0;
+
+        virtual void ReleaseTexture(Texture1D* texture) = 0;
+        virtual void ReleaseTexture(Texture2D* texture) = 0;
+        virtual void ReleaseTexture(Texture3D* texture) = 0;
+
+        // Changes sampling of texture without touching its pixels (it's used since the next binding)
+        virtual void SetTextureSampling(Texture1D* texture, const SamplingInfo& samplingInfo) = 0;
+        virtual void SetTextureSampling(Texture2D* texture, const SamplingInfo& samplingInfo) = 0;
+        virtual void SetTextureSampling(Texture3D* texture, const SamplingInfo& samplingInfo) = 0;
+
+        virtual void BindShaderTexture(Shader* shader, const char* name, const Texture1D* texture) = 0;
+        virtual void BindShaderTexture(Shader* shader, const char* name, const Texture2D* texture) = 0;
+        virtual void BindShaderTexture(Shader* shader, const char* name, const Texture3D* texture) = 0;
+
+        virtual void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture1D* texture) = 0;
+        virtual void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture2D* texture) = 0;
+        virtual void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture3D* texture) = 0;
+
+        virtual RenderTarget* CreateRenderTarget(RenderTarget::Desc description) = 0;
+        virtual void ReleaseRenderTarget(RenderTarget* renderTarget) = 0;
+
+        virtual void Draw(PrimitiveToplogies topology, VertexBuffer* vbo) = 0;
+        virtual void DrawIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo) = 0;
+
+        // Draw instanceCount copies of geometry. Elements of instances buffer (it may be nullptr) go to shader
+        // locations right after elements of vbo, per-vertex elements of it are treated as per-instance ones
+        virtual void DrawInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, VertexBuffer* instances,
+                                   Uint64 instanceCount) = 0;
+        virtual void DrawIndexedInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                          VertexBuffer* instances, Uint64 instanceCount) = 0;
+
+        // Draws commandCount commands from buffer with one submission. All of the commands use the same
+        // vertex and index buffers (meshes are told apart by first index and base vertex)
+        virtual void DrawIndexedIndirect(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                         IndirectBuffer* commands, Uint64 firstCommand, Uint64 commandCount) = 0;
+
+        // Draws objects of batch which passed the last CullBatch
+        virtual void DrawCulledIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                       CullingBatch* batch) = 0;
+
+        // Draws only given ranges of index buffer (for example, visible meshlets, see Meshlets.h)
+        virtual void DrawIndexedRanges(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                       const IndexBuffer::Range* ranges, Uint64 rangesCount) = 0;
+
+        // Replays recorded lists in the given order (see CommandList.h)
+        void Submit(const CommandList* list);
+        void Submit(const CommandList* const* lists, Uint64 listsCount);
+
+        virtual void PresentGraphics() = 0;
+    };
+}
+
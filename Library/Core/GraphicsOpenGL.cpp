@@ -1,1009 +1,3817 @@
-#include "GraphicsOpenGL.h"
-
-#include <d3d11.h>
-
-namespace Tiny3D
-{
-    // TODO: add debugger into graphics context and make it do logs (when smth happen)
-
-    GraphicsContextOGL::GraphicsContextOGL(Window *window, Debugger *debugger, GraphicsAllocators allocators)
-    {
-        if (window == nullptr || debugger == nullptr)
-        {
-            exit(1);
-        }
-
-        m_window = window;
-        m_debugger = debugger;
-        m_structAllocator = allocators.StructAllocator;
-        m_bufferAllocator = allocators.BufferAllocator;
-        m_textureAllocator = allocators.TextureAllocator;
-
-        glfwMakeContextCurrent(window->GetWindowHandle());
-
-        if (glewInit() != GLEW_OK)
-        {
-            m_debugger->MakeLog("Failed to initialize OpenGL graphics context. Program is shut down",
-                                LogTypes::WarningLog);
-            glfwTerminate();
-            exit(1);
-        }
-
-        m_colorBuffer = true;
-        m_depthBuffer = false;
-        m_stencilBuffer = false;
-
-        m_debugger->MakeLog("OpenGL context was initialized correctly", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::PresentGraphics()
-    {
-        glfwSwapBuffers(m_window->GetWindowHandle());
-    }
-
-    void GraphicsContextOGL::SetTarget() {
-        m_colorBuffer = true;
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, m_window->GetWidth(), m_window->GetHeight());
-    }
-
-    void GraphicsContextOGL::ClearTarget(Float32 red, Float32 green, Float32 blue) {
-        glClearColor(red, green, blue, 1.0);
-
-        Uint32 flags = 0;
-
-        flags |= (m_colorBuffer)? GL_COLOR_BUFFER_BIT : 0;
-        flags |= (m_depthBuffer)? GL_DEPTH_BUFFER_BIT : 0;
-        flags |= (m_stencilBuffer)? GL_STENCIL_BUFFER_BIT : 0;
-
-        glClear(flags);
-    }
-
-    VertexBuffer * GraphicsContextOGL::CreateVertexBuffer(VertexBuffer::Desc description)
-    {
-        Uint64 bufferSize = description.VertexSize * description.VertexCount;
-
-        if (bufferSize == 0)
-        {
-            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::WarningLog);
-            return nullptr;
-        }
-
-        Uint32 vao;
-        glGenVertexArrays(1, &vao);
-        glBindVertexArray(vao);
-
-        Uint32 vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, bufferSize, description.Vertices,
-                     BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
-
-        Uint64 offset = 0;
-
-        for (Uint64 i = 0; i < description.Layout.Count; i++)
-        {
-            Uint32 count = description.Layout.Inputs[i].Count;
-            Uint32 type = TypeQualifiersOGL[ENUM_VALUE(description.Layout.Inputs[i].Type)];
-            Uint8 normalized = (description.Layout.Inputs[i].Normalized) ? GL_TRUE : GL_FALSE;
-
-            glEnableVertexAttribArray(i);
-            glVertexAttribPointer(i, count, type, normalized, description.VertexSize,
-                                  reinterpret_cast<const void*>(offset));
-
-            offset += count * TypeSizesOGL[ENUM_VALUE(description.Layout.Inputs[i].Type)];
-        }
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-
-        VertexBufferOGL bufferHandle = {vao, vbo};
-
-        auto newBuffer = reinterpret_cast<VertexBuffer*>(m_structAllocator->AllocateMemory(sizeof(VertexBuffer)));
-        *newBuffer = VertexBuffer(description.VertexSize, m_bufferAllocator);
-
-        newBuffer->SetVertices(description.Vertices, description.VertexCount);
-        newBuffer->SetComponentHandle<VertexBufferOGL>(&bufferHandle, m_structAllocator);
-
-        m_debugger->MakeLog("Vertex buffer was created correctly", LogTypes::InfoLog);
-
-        return newBuffer;
-    }
-
-    IndexBuffer * GraphicsContextOGL::CreateIndexBuffer(IndexBuffer::Desc description)
-    {
-        const Uint64 indexSizes[] = {
-                1, 2, 4,
-        };
-
-        Uint64 bufferSize = description.IndexCount * indexSizes[ENUM_VALUE(description.IndexType)];
-
-        if (bufferSize == 0)
-        {
-            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::WarningLog);
-            return nullptr;
-        }
-
-        IndexBufferOGL ibo;
-        glGenBuffers(1, &ibo);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, bufferSize, description.Indices,
-                     BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
-
-        auto newBuffer = reinterpret_cast<IndexBuffer*>(m_structAllocator->AllocateMemory(sizeof(IndexBuffer)));
-        *newBuffer = IndexBuffer(description.IndexType, m_bufferAllocator);
-
-        newBuffer->SetIndices(description.Indices, description.IndexCount);
-        newBuffer->SetComponentHandle<IndexBufferOGL>(&ibo, m_structAllocator);
-
-        m_debugger->MakeLog("Index buffer was created correctly", LogTypes::InfoLog);
-
-        return newBuffer;
-    }
-
-    UniformBuffer * GraphicsContextOGL::CreateUniformBuffer(UniformBuffer::Desc description)
-    {
-        if (description.Size == 0)
-        {
-            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::UsersLog);
-            return nullptr;
-        }
-
-        UniformBufferOGL ubo;
-        glGenBuffers(1, &ubo);
-        glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-        glBufferData(GL_UNIFORM_BUFFER, description.Size, description.Data,
-                     BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
-
-        auto newBuffer = reinterpret_cast<UniformBuffer*>(m_structAllocator->AllocateMemory(sizeof(UniformBuffer)));
-        *newBuffer = UniformBuffer(m_bufferAllocator);
-
-        newBuffer->SetData(description.Data, description.Size);
-        newBuffer->SetComponentHandle<UniformBufferOGL>(&ubo, m_structAllocator);
-
-        m_debugger->MakeLog("Uniform buffer was created correctly", LogTypes::InfoLog);
-
-        return newBuffer;
-    }
-
-    void GraphicsContextOGL::OverwriteBuffer(VertexBuffer *vbo, const void *newVertices, Uint64 vertexCount)
-    {
-        if (vbo == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (newVertices == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
-
-        Uint64 sizeToChange = MIN(vertexCount, vbo->GetVertexCount()) * vbo->GetVertexSize();
-
-        glBindBuffer(GL_ARRAY_BUFFER, bufferHandle->VertexBuffer);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeToChange, newVertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        CopyMemory(vbo->GetVertices(), newVertices, sizeToChange);
-
-        m_debugger->MakeLog("Overwriting of vertex buffer was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::OverwriteBuffer(IndexBuffer *ibo, const void *newIndices, Uint64 newCount)
-    {
-        if (ibo == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (newIndices == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        const Uint64 indexSizes[] = {
-                1, 2, 4,
-        };
-
-        IndexBufferOGL* bufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
-
-        Uint64 sizeToChange = MIN(ibo->GetIndexCount(), newCount) * indexSizes[ENUM_VALUE(ibo->GetIndexType())];
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *bufferHandle);
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeToChange, newIndices);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-        CopyMemory(ibo->GetIndices(), newIndices, sizeToChange);
-
-        m_debugger->MakeLog("Overwriting of index buffer was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::OverwriteBuffer(UniformBuffer *ubo, const void *newData, Uint64 newSize)
-    {
-        if (ubo == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ubo->GetComponentHandle<UniformBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (newData == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        UniformBufferOGL* bufferHandle = ubo->GetComponentHandle<UniformBufferOGL>();
-
-        Uint64 sizeToChange = MIN(ubo->GetSize(), newSize);
-
-        glBindBuffer(GL_UNIFORM_BUFFER, *bufferHandle);
-        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeToChange, newData);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-        CopyMemory(ubo->GetData(), newData, newSize);
-
-        m_debugger->MakeLog("Overwriting of uniform buffer was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::ReleaseBuffer(VertexBuffer *vbo)
-    {
-        if (vbo == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
-        glDeleteBuffers(1, &bufferHandle->VertexBuffer);
-        glDeleteVertexArrays(1, &bufferHandle->VertexArray);
-
-        vbo->~VertexBuffer();
-        m_structAllocator->FreeMemory(vbo);
-
-        m_debugger->MakeLog("Releasing of vertex buffer was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::ReleaseBuffer(IndexBuffer *ibo)
-    {
-        if (ibo == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        IndexBufferOGL* bufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
-        glDeleteBuffers(1, bufferHandle);
-
-        ibo->~IndexBuffer();
-        m_structAllocator->FreeMemory(ibo);
-
-        m_debugger->MakeLog("Releasing of index buffer was completed", LogTypes::WarningLog);
-    }
-
-    void GraphicsContextOGL::ReleaseBuffer(UniformBuffer *ubo)
-    {
-        if (ubo == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ubo->GetComponentHandle<UniformBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        UniformBufferOGL* bufferHandle = ubo->GetComponentHandle<UniformBufferOGL>();
-        glDeleteBuffers(1, bufferHandle);
-
-        ubo->~UniformBuffer();
-        m_structAllocator->FreeMemory(ubo);
-
-        m_debugger->MakeLog("Releasing of uniform buffer was completed", LogTypes::InfoLog);
-    }
-
-    Shader * GraphicsContextOGL::CreateShader(Shader::Desc description)
-    {
-        Uint32 vShader = 0, gShader = 0, fShader = 0;
-
-        if (description.Data.VertexShaderCode != nullptr)
-        {
-            vShader = glCreateShader(GL_VERTEX_SHADER);
-            glShaderSource(vShader, 1, &description.Data.VertexShaderCode, nullptr);
-            glCompileShader(vShader);
-        }
-
-        if (description.Data.GeometryShaderCode != nullptr)
-        {
-            gShader = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(gShader, 1, &description.Data.GeometryShaderCode, nullptr);
-            glCompileShader(gShader);
-        }
-
-        if (description.Data.PixelShaderCode != nullptr)
-        {
-            fShader = glCreateShader(GL_FRAGMENT_SHADER);
-            glShaderSource(fShader, 1, &description.Data.PixelShaderCode, nullptr);
-            glCompileShader(fShader);
-        }
-
-        Uint32 program = glCreateProgram();
-
-        for (Uint64 i = 0; i < description.Layout.Count; i++)
-        {
-            glBindAttribLocation(program, i, description.Layout.Inputs[i].Name);
-        }
-
-        glAttachShader(program, vShader);
-        glAttachShader(program, gShader);
-        glAttachShader(program, fShader);
-
-        glLinkProgram(program);
-        glValidateProgram(program);
-
-        ShaderOGL shaderHandle = {vShader, gShader, fShader,
-                                  program};
-
-        auto newShader = reinterpret_cast<Shader*>(m_structAllocator->AllocateMemory(sizeof(Shader)));
-        *newShader = Shader();
-
-        newShader->SetComponentHandle<ShaderOGL>(&shaderHandle, m_structAllocator);
-
-        m_debugger->MakeLog("Shader was created", LogTypes::InfoLog);
-
-        return newShader;
-    }
-
-    void GraphicsContextOGL::ReleaseShader(Shader *shader)
-    {
-        if (shader == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
-        glDeleteShader(shaderHandle->VertexShader);
-        glDeleteShader(shaderHandle->GeometryShader);
-        glDeleteShader(shaderHandle->FragmentShader);
-
-        glDeleteProgram(shaderHandle->ShaderProgram);
-
-        m_debugger->MakeLog("Releasing of shader was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::BindShader(Shader *shader)
-    {
-        if (shader == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind this shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind this shader", LogTypes::WarningLog);
-            return;
-        }
-
-        shader->ClearBindings();
-
-        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
-        glUseProgram(shaderHandle->ShaderProgram);
-
-        m_debugger->MakeLog("Shader's binding was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::BindShaderUniformBuffer(Shader *shader, const char *name,
-                                                     const UniformBuffer *ubo)
-    {
-        BindShaderUniformBuffer(shader, name, ubo, 0, ubo->GetSize());
-    }
-
-    void GraphicsContextOGL::BindShaderUniformBuffer(Shader *shader, const char *name, const UniformBuffer *ubo,
-                                                     Uint64 offset, Uint64 size)
-    {
-        if (ubo == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind buffer into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind buffer into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ubo->GetComponentHandle<UniformBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Buffer is invalid. Can not bind buffer into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
-        UniformBufferOGL* bufferHandle = ubo->GetComponentHandle<UniformBufferOGL>();
-
-        glUniformBlockBinding(shaderHandle->ShaderProgram,
-                              glGetUniformBlockIndex(shaderHandle->ShaderProgram, name),
-                              shader->GetBufferBindings());
-
-        glBindBuffer(GL_UNIFORM_BUFFER, *bufferHandle);
-        glBindBufferRange(GL_UNIFORM_BUFFER, shader->GetBufferBindings(), *bufferHandle, offset, size);
-        glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-        shader->AddBufferBinding();
-
-        m_debugger->MakeLog("Uniform buffer was binded into shader correctly", LogTypes::InfoLog);
-    }
-
-    Texture1D * GraphicsContextOGL::CreateTexture1D(Texture1D::Desc description)
-    {
-        if (description.Width == 0)
-        {
-            m_debugger->MakeLog("Texture creation is failed. Invalid parameters were given", LogTypes::WarningLog);
-            return nullptr;
-        }
-
-        TextureOGL texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_1D, texture);
-
-        Uint32 addressModeOGL = TextureAddressModesOGL[ENUM_VALUE(description.SamplingInfo.AddressMode)];
-        Uint32 minFilterOGL = TextureMinFilterModesOGL[ENUM_VALUE(description.SamplingInfo.MinFilter)];
-        Uint32 magFilterOGL = TextureMagFilterModesOGL[ENUM_VALUE(description.SamplingInfo.MagFilter)];
-
-        Float32 maxAnisotropy;
-        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
-
-        Float32 anisotropy = MIN(maxAnisotropy, description.SamplingInfo.MaxAnisotropy);
-
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, addressModeOGL);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, minFilterOGL);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, minFilterOGL);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_LOD_BIAS, description.SamplingInfo.LODBias);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_LOD, description.SamplingInfo.MinLOD);
-        glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAX_LOD, description.SamplingInfo.MaxLOD);
-
-        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint64 textureSize = PixelSizes[ENUM_VALUE(description.PixelFormat)] * description.Width;
-
-        glTexImage1D(GL_TEXTURE_1D, 0, pixelInternalFormatOGL,
-                     description.Width, 0,
-                     pixelFormatOGL, pixelTypeOGL, description.Pixels);
-        glGenerateMipmap(GL_TEXTURE_1D);
-
-        glBindTexture(GL_TEXTURE_1D, 0);
-
-        auto newTexture = reinterpret_cast<Texture1D*>(m_structAllocator->AllocateMemory(sizeof(Texture1D)));
-        *newTexture = Texture1D(m_textureAllocator);
-
-        newTexture->SetPixelFormat(description.PixelFormat);
-        newTexture->SetPixels(description.Pixels, description.Width);
-        newTexture->SetComponentHandle<TextureOGL>(&texture, m_structAllocator);
-
-        m_debugger->MakeLog("1D texture was created correctly", LogTypes::InfoLog);
-
-        return newTexture;
-    }
-
-    Texture2D * GraphicsContextOGL::CreateTexture2D(Texture2D::Desc description)
-    {
-        if (description.Width == 0 || description.Height == 0)
-        {
-            m_debugger->MakeLog("Texture creation is failed. Invalid parameters were given", LogTypes::WarningLog);
-            return nullptr;
-        }
-
-        TextureOGL texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-
-        Uint32 addressModeOGL = TextureAddressModesOGL[ENUM_VALUE(description.SamplingInfo.AddressMode)];
-        Uint32 minFilterOGL = TextureMinFilterModesOGL[ENUM_VALUE(description.SamplingInfo.MinFilter)];
-        Uint32 magFilterOGL = TextureMagFilterModesOGL[ENUM_VALUE(description.SamplingInfo.MagFilter)];
-
-        Float32 maxAnisotropy;
-        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
-
-        Float32 anisotropy = MIN(maxAnisotropy, description.SamplingInfo.MaxAnisotropy);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, addressModeOGL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, addressModeOGL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilterOGL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilterOGL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, description.SamplingInfo.LODBias);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_LOD, description.SamplingInfo.MinLOD);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LOD, description.SamplingInfo.MaxLOD);
-
-        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(description.PixelFormat)];
-
-        Uint64 textureSize = PixelSizes[ENUM_VALUE(description.PixelFormat)] * description.Width * description.Height;
-
-        glTexImage2D(GL_TEXTURE_2D, 0, pixelInternalFormatOGL,
-                     description.Width, description.Height, 0,
-                     pixelFormatOGL, pixelTypeOGL, description.Pixels);
-
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        auto newTexture = reinterpret_cast<Texture2D*>(m_structAllocator->AllocateMemory(sizeof(Texture2D)));
-        *newTexture = Texture2D(m_textureAllocator);
-
-        newTexture->SetPixelFormat(description.PixelFormat);
-        newTexture->SetPixels(description.Pixels, description.Width, description.Height);
-        newTexture->SetComponentHandle<TextureOGL>(&texture, m_structAllocator);
-
-        m_debugger->MakeLog("2D texture was created correctly", LogTypes::InfoLog);
-
-        return newTexture;
-    }
-
-    Texture3D * GraphicsContextOGL::CreateTexture3D(Texture3D::Desc description)
-    {
-        if (description.Width == 0 || description.Height == 0 || description.Depth == 0)
-        {
-            m_debugger->MakeLog("Texture creation is failed. Invalid parameters were given", LogTypes::WarningLog);
-            return nullptr;
-        }
-
-        TextureOGL texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_3D, texture);
-
-        Uint32 addressModeOGL = TextureAddressModesOGL[ENUM_VALUE(description.SamplingInfo.AddressMode)];
-        Uint32 minFilterOGL = TextureMinFilterModesOGL[ENUM_VALUE(description.SamplingInfo.MinFilter)];
-        Uint32 magFilterOGL = TextureMagFilterModesOGL[ENUM_VALUE(description.SamplingInfo.MagFilter)];
-
-        Float32 maxAnisotropy;
-        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
-
-        Float32 anisotropy = MIN(maxAnisotropy, description.SamplingInfo.MaxAnisotropy);
-
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, addressModeOGL);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, addressModeOGL);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, addressModeOGL);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, minFilterOGL);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, minFilterOGL);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_LOD_BIAS, description.SamplingInfo.LODBias);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_LOD, description.SamplingInfo.MinLOD);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LOD, description.SamplingInfo.MaxLOD);
-
-        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(description.PixelFormat)];
-        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(description.PixelFormat)];
-
-        Uint64 textureSize = PixelSizes[ENUM_VALUE(description.PixelFormat)] *
-                description.Width * description.Height * description.Depth;
-
-        glTexImage3D(GL_TEXTURE_3D, 0, pixelInternalFormatOGL,
-                     description.Width, description.Height, description.Depth, 0,
-                     pixelFormatOGL, pixelTypeOGL, description.Pixels);
-        glGenerateMipmap(GL_TEXTURE_3D);
-
-        glBindTexture(GL_TEXTURE_3D, 0);
-
-        auto newTexture = reinterpret_cast<Texture3D*>(m_structAllocator->AllocateMemory(sizeof(Texture3D)));
-        *newTexture = Texture3D(m_textureAllocator);
-
-        newTexture->SetPixelFormat(description.PixelFormat);
-        newTexture->SetPixels(description.Pixels,
-                              description.Width, description.Height, description.Depth);
-        newTexture->SetComponentHandle<TextureOGL>(&texture, m_structAllocator);
-
-        m_debugger->MakeLog("3D texture was created correctly", LogTypes::InfoLog);
-
-        return newTexture;
-    }
-
-    void GraphicsContextOGL::OverwriteTexture(Texture1D *texture, Uint64 width, const void *data)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (data == nullptr || width == 0)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because data are invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        glBindTexture(GL_TEXTURE_1D, *textureHandle);
-
-        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
-        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
-        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(texture->GetPixelFormat())];
-
-        Uint64 textureSize = PixelSizes[ENUM_VALUE(texture->GetPixelFormat())] * width;
-
-        glTexImage1D(GL_TEXTURE_1D, 0, pixelInternalFormatOGL,
-                     width, 0,
-                     pixelFormatOGL, pixelTypeOGL, data);
-        glGenerateMipmap(GL_TEXTURE_1D);
-
-        glBindTexture(GL_TEXTURE_1D, 0);
-
-        texture->SetPixels(data, width);
-    }
-
-    void GraphicsContextOGL::OverwriteTexture(Texture2D *texture, Uint64 width, Uint64 height, const void *data)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (data == nullptr || width == 0 || height == 0)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because data are invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        glBindTexture(GL_TEXTURE_2D, *textureHandle);
-
-        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
-        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
-        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(texture->GetPixelFormat())];
-
-        Uint64 textureSize = PixelSizes[ENUM_VALUE(texture->GetPixelFormat())] * width * height;
-
-        glTexImage2D(GL_TEXTURE_2D, 0, pixelInternalFormatOGL,
-                     width, height, 0,
-                     pixelFormatOGL, pixelTypeOGL, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        texture->SetPixels(data, width, height);
-
-        m_debugger->MakeLog("Overwriting of 1D texture was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::OverwriteTexture(Texture3D *texture, Uint64 width, Uint64 height, Uint64 depth,
-                                              const void *data)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        if (data == nullptr || width == 0 || height == 0 || depth == 0)
-        {
-            m_debugger->MakeLog("Overwriting texture is failed because data are invalid", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        glBindTexture(GL_TEXTURE_3D, *textureHandle);
-
-        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
-        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
-        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(texture->GetPixelFormat())];
-
-        Uint64 textureSize = PixelSizes[ENUM_VALUE(texture->GetPixelFormat())] * width * height * depth;
-
-        glTexImage3D(GL_TEXTURE_3D, 0, pixelInternalFormatOGL,
-                     width, height, depth, 0,
-                     pixelFormatOGL, pixelTypeOGL, data);
-        glGenerateMipmap(GL_TEXTURE_3D);
-
-        glBindTexture(GL_TEXTURE_3D, 0);
-
-        texture->SetPixels(data, width, height, depth);
-
-        m_debugger->MakeLog("Overwriting of 2D texture was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::ReleaseTexture(Texture1D *texture)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        glDeleteTextures(1, textureHandle);
-
-        m_debugger->MakeLog("Releasing of 1D texture was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::ReleaseTexture(Texture2D *texture)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        glDeleteTextures(1, textureHandle);
-
-        m_debugger->MakeLog("Releasing of 2D texture was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::ReleaseTexture(Texture3D *texture)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        glDeleteTextures(1, textureHandle);
-
-        m_debugger->MakeLog("Releasing of 3D texture was completed", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::BindShaderTexture(Shader *shader, const char *name, const Texture1D *texture)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
-
-        glActiveTexture(GL_TEXTURE0 + shader->GetTextureBindings());
-        glBindTexture(GL_TEXTURE_1D, *textureHandle);
-
-        glUniform1i(glGetUniformLocation(shaderHandle->ShaderProgram, name), shader->GetTextureBindings());
-        shader->AddTextureBinding();
-
-        m_debugger->MakeLog("1D texture was binded into shader correctly", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::BindShaderTexture(Shader *shader, const char *name, const Texture2D *texture)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
-
-        glActiveTexture(GL_TEXTURE0 + shader->GetTextureBindings());
-        glBindTexture(GL_TEXTURE_2D, *textureHandle);
-
-        glUniform1i(glGetUniformLocation(shaderHandle->ShaderProgram, name), shader->GetTextureBindings());
-        shader->AddTextureBinding();
-
-        m_debugger->MakeLog("2D texture was binded into shader correctly", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::BindShaderTexture(Shader *shader, const char *name, const Texture3D *texture)
-    {
-        if (texture == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
-            return;
-        }
-
-        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
-        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
-
-        glActiveTexture(GL_TEXTURE0 + shader->GetTextureBindings());
-        glBindTexture(GL_TEXTURE_3D, *textureHandle);
-
-        glUniform1i(glGetUniformLocation(shaderHandle->ShaderProgram, name), shader->GetTextureBindings());
-        shader->AddTextureBinding();
-
-        m_debugger->MakeLog("3D texture was binded into shader correctly", LogTypes::InfoLog);
-    }
-
-    void GraphicsContextOGL::Draw(PrimitiveToplogies topology, VertexBuffer *vbo)
-    {
-        if (vbo == nullptr)
-        {
-            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
-            return;
-        }
-
-        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
-            return;
-        }
-
-        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
-        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
-
-        glBindVertexArray(bufferHandle->VertexArray);
-        glDrawArrays(primitive, 0, vbo->GetVertexCount());
-
-        glBindVertexArray(0);
-        glUseProgram(0);
-    }
-
-    void GraphicsContextOGL::DrawIndexed(PrimitiveToplogies topology, VertexBuffer *vbo, IndexBuffer *ibo)
-    {
-        if (vbo == nullptr)
-        {
-            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
-            return;
-        }
-
-        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ibo == nullptr)
-        {
-            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
-            return;
-        }
-
-        if (ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
-        {
-            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
-            return;
-        }
-
-        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
-        IndexBufferOGL* indexBufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
-        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
-
-        glBindVertexArray(bufferHandle->VertexArray);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *indexBufferHandle);
-        glDrawElements(primitive, ibo->GetIndexCount(),
-                       IndexTypesOGL[ENUM_VALUE(ibo->GetIndexType())], nullptr);
-
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glUseProgram(0);
-    }
-}
+#include "GraphicsOpenGL.h"
+#include "VertexFormat.h"
+#include "MeshOptimizer.h"
+
+#include <d3d11.h>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+namespace Tiny3D
+{
+    // Frustum culling of bounding spheres. Compacted mode appends visible commands with atomic counter
+    // (for glMultiDrawElementsIndirectCount), otherwise culled commands are kept with zero instance count.
+    // Visible objects are counted in both modes
+    static const char* CullingShaderCode = R"(
+        #version 430
+
+        layout(local_size_x = 64) in;
+
+        struct DrawCommand
+        {
+            uint IndexCount;
+            uint InstanceCount;
+            uint FirstIndex;
+            int BaseVertex;
+            uint BaseInstance;
+        };
+
+        layout(std430, binding = 0) readonly buffer Spheres { vec4 spheres[]; };
+        layout(std430, binding = 1) readonly buffer Commands { DrawCommand commands[]; };
+        layout(std430, binding = 2) writeonly buffer Visible { DrawCommand visible[]; };
+        layout(std430, binding = 3) buffer Count { uint visibleCount; };
+
+        uniform vec4 planes[6];
+        uniform uint objectCount;
+        uniform bool compact;
+
+        void main()
+        {
+            uint object = gl_GlobalInvocationID.x;
+
+            if (object >= objectCount)
+                return;
+
+            vec4 sphere = spheres[object];
+            bool inside = true;
+
+            for (int i = 0; i < 6; i++)
+                inside = inside && (dot(planes[i].xyz, sphere.xyz) + planes[i].w >= -sphere.w);
+
+            DrawCommand command = commands[object];
+
+            if (inside)
+            {
+                uint slot = atomicAdd(visibleCount, 1u);
+
+                if (compact)
+                    visible[slot] = command;
+            }
+
+            if (!compact)
+            {
+                if (!inside)
+                    command.InstanceCount = 0u;
+
+                visible[object] = command;
+            }
+        }
+    )";
+
+    static const Uint64 CullingGroupSize = 64;
+
+    // TODO: add debugger into graphics context and make it do logs (when smth happen)
+
+    GraphicsContextOGL::GraphicsContextOGL(Window *window, Debugger *debugger, GraphicsAllocators allocators)
+    {
+        if (window == nullptr || debugger == nullptr)
+        {
+            exit(1);
+        }
+
+        m_window = window;
+        m_debugger = debugger;
+        m_structAllocator = allocators.StructAllocator;
+        m_bufferAllocator = allocators.BufferAllocator;
+        m_textureAllocator = allocators.TextureAllocator;
+
+        glfwMakeContextCurrent(window->GetWindowHandle());
+
+        if (glewInit() != GLEW_OK)
+        {
+            m_debugger->MakeLog("Failed to initialize OpenGL graphics context. Program is shut down",
+                                LogTypes::WarningLog);
+            glfwTerminate();
+            exit(1);
+        }
+
+        m_colorBuffer = true;
+        m_depthBuffer = false;
+        m_stencilBuffer = false;
+
+        m_capabilities.ComputeShaders = GLEW_VERSION_4_3 || GLEW_ARB_compute_shader;
+        m_capabilities.ProgramInterfaceQuery = GLEW_VERSION_4_3 || GLEW_ARB_program_interface_query;
+        m_capabilities.DirectStateAccess = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+        m_capabilities.VertexAttribBinding = GLEW_VERSION_4_3 || GLEW_ARB_vertex_attrib_binding;
+
+        Int32 vertexStorageBlocks = 0;
+        Int32 storageBindings = 0;
+
+        if (GLEW_VERSION_4_3 || GLEW_ARB_shader_storage_buffer_object)
+        {
+            glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexStorageBlocks);
+            glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &storageBindings);
+        }
+
+        m_capabilities.VertexPulling = vertexStorageBlocks > 0 && storageBindings >= 0 &&
+                                      static_cast<Uint32>(storageBindings) > VertexPullingBinding;
+        m_capabilities.IndirectCountCore = GLEW_VERSION_4_6;
+        m_capabilities.IndirectCount = GLEW_VERSION_4_6 || GLEW_ARB_indirect_parameters;
+
+        // Driver may support program binaries and give no formats at all
+        Int32 binaryFormats = 0;
+
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+
+        m_capabilities.ProgramBinary = binaryFormats > 0;
+
+        m_capabilities.SpirVCore = GLEW_VERSION_4_6;
+        m_capabilities.SpirV = GLEW_VERSION_4_6 || GLEW_ARB_gl_spirv;
+
+        m_capabilities.ParallelShaderCompile = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+
+        m_capabilities.MaxAnisotropy = 0.0f;
+
+        if (GLEW_VERSION_4_6 || GLEW_ARB_texture_filter_anisotropic || GLEW_EXT_texture_filter_anisotropic)
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &m_capabilities.MaxAnisotropy);
+
+        Int32 colorAttachments = 0;
+        Int32 drawBuffers = 0;
+
+        glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &colorAttachments);
+        glGetIntegerv(GL_MAX_DRAW_BUFFERS, &drawBuffers);
+
+        Uint64 maxColorAttachments = static_cast<Uint64>(MIN(colorAttachments, drawBuffers));
+        m_capabilities.MaxColorAttachments = MIN(maxColorAttachments, RenderTarget::MaxColorAttachments);
+
+        // Driver picks the number of compiler threads itself
+        if (GLEW_KHR_parallel_shader_compile)
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        else if (GLEW_ARB_parallel_shader_compile)
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+
+        // Binaries can be loaded only by the same driver of the same version
+        const Uint32 driverStrings[4] = {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION};
+
+        for (Uint32 name : driverStrings)
+        {
+            auto string = reinterpret_cast<const char*>(glGetString(name));
+
+            if (string != nullptr)
+                m_driverHash = HashString(string, m_driverHash);
+        }
+
+        InvalidateStateCache();
+
+        m_debugger->MakeLog("OpenGL context was initialized correctly", LogTypes::InfoLog);
+    }
+
+    GraphicsContextOGL::~GraphicsContextOGL()
+    {
+        // Formats which are still used by buffers are deleted with the context
+        for (Uint64 i = 0; i < m_vertexFormatsCount; i++)
+        {
+            if (m_vertexFormats[i].UsersCount != 0)
+                glDeleteVertexArrays(1, &m_vertexFormats[i].VertexArray);
+        }
+
+        if (m_vertexFormats != nullptr)
+            m_structAllocator->FreeMemory(m_vertexFormats);
+
+        if (m_pullingVertexArray != 0)
+            glDeleteVertexArrays(1, &m_pullingVertexArray);
+
+        if (m_cullingProgram != 0)
+            glDeleteProgram(m_cullingProgram);
+
+        if (m_pipelineStates != nullptr)
+            m_structAllocator->FreeMemory(m_pipelineStates);
+
+        for (Uint64 i = 0; i < m_samplersCount; i++)
+        {
+            if (m_samplers[i].UsersCount != 0)
+                glDeleteSamplers(1, &m_samplers[i].Sampler);
+        }
+
+        if (m_samplers != nullptr)
+            m_structAllocator->FreeMemory(m_samplers);
+    }
+
+    void GraphicsContextOGL::PresentGraphics()
+    {
+        glfwSwapBuffers(m_window->GetWindowHandle());
+
+        m_lastFrameStatistics = m_frameStatistics;
+        m_frameStatistics = {};
+    }
+
+    const GraphicsContextOGL::StateStatistics& GraphicsContextOGL::GetStateStatistics() const
+    {
+        return m_lastFrameStatistics;
+    }
+
+    void GraphicsContextOGL::InvalidateStateCache()
+    {
+        m_state.Program = UnknownStateOGL;
+        m_state.VertexArray = UnknownStateOGL;
+        m_state.Framebuffer = UnknownStateOGL;
+
+        for (Uint32& buffer : m_state.Buffers)
+            buffer = UnknownStateOGL;
+
+        for (Uint64 i = 0; i < CachedIndexedBindings; i++)
+        {
+            m_state.UniformRanges[i] = {UnknownStateOGL, 0, 0};
+            m_state.StorageRanges[i] = {UnknownStateOGL, 0, 0};
+        }
+
+        m_state.ActiveTextureUnit = UnknownStateOGL;
+
+        for (auto& unit : m_state.Textures)
+        {
+            for (Uint32& texture : unit)
+                texture = UnknownStateOGL;
+        }
+
+        for (Uint32& sampler : m_state.Samplers)
+            sampler = UnknownStateOGL;
+
+        for (Uint32& flag : m_state.Flags)
+            flag = UnknownStateOGL;
+
+        SetMemory(&m_state.Render, sizeof(m_state.Render), 0xFF);
+
+        for (Uint64 i = 0; i < m_vertexFormatsCount; i++)
+            m_vertexFormats[i].BoundBuffer = UnknownStateOGL;
+    }
+
+    void GraphicsContextOGL::UseProgram(Uint32 program)
+    {
+        if (m_state.Program == program)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        glUseProgram(program);
+
+        m_state.Program = program;
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::BindVertexArray(Uint32 vao)
+    {
+        if (m_state.VertexArray == vao)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        glBindVertexArray(vao);
+
+        m_state.VertexArray = vao;
+        m_state.Buffers[ENUM_VALUE(BufferBindings::ElementBinding)] = UnknownStateOGL;
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::BindFramebuffer(Uint32 framebuffer)
+    {
+        if (m_state.Framebuffer == framebuffer)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+        m_state.Framebuffer = framebuffer;
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::BindBuffer(BufferBindings binding, Uint32 buffer)
+    {
+        Uint32& boundBuffer = m_state.Buffers[ENUM_VALUE(binding)];
+
+        if (boundBuffer == buffer)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        glBindBuffer(BufferTargetsOGL[ENUM_VALUE(binding)], buffer);
+
+        boundBuffer = buffer;
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::BindBufferRange(BufferBindings binding, Uint32 index, Uint32 buffer,
+                                             Uint64 offset, Uint64 size)
+    {
+        BufferRangeOGL* ranges = nullptr;
+
+        if (binding == BufferBindings::UniformBinding)
+            ranges = m_state.UniformRanges;
+        else if (binding == BufferBindings::StorageBinding)
+            ranges = m_state.StorageRanges;
+
+        if (ranges != nullptr && index < CachedIndexedBindings)
+        {
+            const BufferRangeOGL& range = ranges[index];
+
+            if (range.Buffer == buffer && range.Offset == offset && range.Size == size)
+            {
+                m_frameStatistics.SkippedCalls++;
+                return;
+            }
+
+            ranges[index] = {buffer, offset, size};
+        }
+
+        Uint32 target = BufferTargetsOGL[ENUM_VALUE(binding)];
+
+        if (size == 0)
+            glBindBufferBase(target, index, buffer);
+        else
+            glBindBufferRange(target, index, buffer, offset, size);
+
+        // Indexed binding changes the generic binding of target too
+        m_state.Buffers[ENUM_VALUE(binding)] = buffer;
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::BindTexture(Uint32 unit, TextureBindings binding, Uint32 texture)
+    {
+        Uint32* boundTexture = (unit < CachedTextureUnits) ? &m_state.Textures[unit][ENUM_VALUE(binding)] : nullptr;
+
+        if (boundTexture != nullptr && *boundTexture == texture)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        if (m_state.ActiveTextureUnit != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+
+            m_state.ActiveTextureUnit = unit;
+            m_frameStatistics.IssuedCalls++;
+        }
+
+        glBindTexture(TextureTargetsOGL[ENUM_VALUE(binding)], texture);
+
+        if (boundTexture != nullptr)
+            *boundTexture = texture;
+
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::BindTexture(TextureBindings binding, Uint32 texture)
+    {
+        // Unit is unknown only before the first binding
+        Uint32 unit = (m_state.ActiveTextureUnit != UnknownStateOGL) ? m_state.ActiveTextureUnit : 0;
+        BindTexture(unit, binding, texture);
+    }
+
+    void GraphicsContextOGL::BindSampler(Uint32 unit, Uint32 sampler)
+    {
+        Uint32* boundSampler = (unit < CachedTextureUnits) ? &m_state.Samplers[unit] : nullptr;
+
+        if (boundSampler != nullptr && *boundSampler == sampler)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        // Samplers are bound by unit, so active unit isn't changed for them
+        glBindSampler(unit, sampler);
+
+        if (boundSampler != nullptr)
+            *boundSampler = sampler;
+
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    void GraphicsContextOGL::SetStateFlag(StateFlags flag, bool enabled)
+    {
+        Uint32& state = m_state.Flags[ENUM_VALUE(flag)];
+
+        if (state == static_cast<Uint32>(enabled))
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        if (enabled)
+            glEnable(StateFlagsOGL[ENUM_VALUE(flag)]);
+        else
+            glDisable(StateFlagsOGL[ENUM_VALUE(flag)]);
+
+        state = static_cast<Uint32>(enabled);
+        m_frameStatistics.IssuedCalls++;
+    }
+
+    bool GraphicsContextOGL::ChangeRenderState(void* applied, const void* values, Uint64 size)
+    {
+        if (memcmp(applied, values, size) == 0)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return false;
+        }
+
+        CopyMemory(applied, values, size);
+        m_frameStatistics.IssuedCalls++;
+
+        return true;
+    }
+
+    void GraphicsContextOGL::ApplyPipelineState(const PipelineStateOGL& pipeline)
+    {
+        const RenderStateOGL& state = pipeline.State;
+        RenderStateOGL& applied = m_state.Render;
+
+        for (Uint64 i = 0; i < StateFlagsCount; i++)
+            SetStateFlag(static_cast<StateFlags>(i), pipeline.Flags[i]);
+
+        // Values of disabled tests aren't used, so they are changed only when tests are on.
+        // Write masks work for clearing too, so they are always applied
+        if (ChangeRenderState(&applied.DepthWrite, &state.DepthWrite, sizeof(Uint32)))
+            glDepthMask(static_cast<GLboolean>(state.DepthWrite));
+
+        if (ChangeRenderState(&applied.StencilWriteMask, &state.StencilWriteMask, sizeof(Uint32)))
+            glStencilMask(state.StencilWriteMask);
+
+        if (ChangeRenderState(&applied.ColorWriteMask, &state.ColorWriteMask, sizeof(Uint32)))
+        {
+            Uint32 mask = state.ColorWriteMask;
+
+            glColorMask((mask & ColorWriteRed) != 0, (mask & ColorWriteGreen) != 0,
+                        (mask & ColorWriteBlue) != 0, (mask & ColorWriteAlpha) != 0);
+        }
+
+        if (pipeline.Flags[ENUM_VALUE(StateFlags::DepthTest)])
+        {
+            if (ChangeRenderState(&applied.DepthFunction, &state.DepthFunction, sizeof(Uint32)))
+                glDepthFunc(state.DepthFunction);
+        }
+
+        if (pipeline.Flags[ENUM_VALUE(StateFlags::StencilTest)])
+        {
+            if (ChangeRenderState(&applied.StencilFunction, &state.StencilFunction, 3 * sizeof(Uint32)))
+                glStencilFunc(state.StencilFunction, static_cast<Int32>(state.StencilReference), state.StencilReadMask);
+
+            if (ChangeRenderState(&applied.StencilFail, &state.StencilFail, 3 * sizeof(Uint32)))
+                glStencilOp(state.StencilFail, state.StencilDepthFail, state.StencilPass);
+        }
+
+        if (pipeline.Flags[ENUM_VALUE(StateFlags::Blending)])
+        {
+            if (ChangeRenderState(&applied.BlendSourceColor, &state.BlendSourceColor, 4 * sizeof(Uint32)))
+            {
+                glBlendFuncSeparate(state.BlendSourceColor, state.BlendDestinationColor,
+                                    state.BlendSourceAlpha, state.BlendDestinationAlpha);
+            }
+
+            if (ChangeRenderState(&applied.BlendColorOperation, &state.BlendColorOperation, 2 * sizeof(Uint32)))
+                glBlendEquationSeparate(state.BlendColorOperation, state.BlendAlphaOperation);
+        }
+
+        if (pipeline.Flags[ENUM_VALUE(StateFlags::FaceCulling)])
+        {
+            if (ChangeRenderState(&applied.CullFace, &state.CullFace, sizeof(Uint32)))
+                glCullFace(state.CullFace);
+
+            if (ChangeRenderState(&applied.FrontFace, &state.FrontFace, sizeof(Uint32)))
+                glFrontFace(state.FrontFace);
+        }
+
+        if (ChangeRenderState(&applied.PolygonMode, &state.PolygonMode, sizeof(Uint32)))
+            glPolygonMode(GL_FRONT_AND_BACK, state.PolygonMode);
+
+        if (pipeline.Flags[ENUM_VALUE(StateFlags::PolygonOffset)])
+        {
+            if (ChangeRenderState(&applied.SlopeDepthBias, &state.SlopeDepthBias, 2 * sizeof(Float32)))
+                glPolygonOffset(state.SlopeDepthBias, state.DepthBias);
+        }
+    }
+
+    void GraphicsContextOGL::OpenWriteMasks()
+    {
+        RenderStateOGL& applied = m_state.Render;
+
+        Uint32 colorWriteMask = ColorWriteAll;
+        Uint32 depthWrite = GL_TRUE;
+        Uint32 stencilWriteMask = ~0u;
+
+        if (m_colorBuffer && ChangeRenderState(&applied.ColorWriteMask, &colorWriteMask, sizeof(Uint32)))
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        if (m_depthBuffer && ChangeRenderState(&applied.DepthWrite, &depthWrite, sizeof(Uint32)))
+            glDepthMask(GL_TRUE);
+
+        if (m_stencilBuffer && ChangeRenderState(&applied.StencilWriteMask, &stencilWriteMask, sizeof(Uint32)))
+            glStencilMask(stencilWriteMask);
+    }
+
+    void GraphicsContextOGL::ForgetProgram(Uint32 program)
+    {
+        if (m_state.Program == program)
+            m_state.Program = UnknownStateOGL;
+    }
+
+    void GraphicsContextOGL::ForgetVertexArray(Uint32 vao)
+    {
+        if (m_state.VertexArray == vao)
+        {
+            m_state.VertexArray = UnknownStateOGL;
+            m_state.Buffers[ENUM_VALUE(BufferBindings::ElementBinding)] = UnknownStateOGL;
+        }
+    }
+
+    void GraphicsContextOGL::ForgetBuffer(Uint32 buffer)
+    {
+        for (Uint32& boundBuffer : m_state.Buffers)
+        {
+            if (boundBuffer == buffer)
+                boundBuffer = UnknownStateOGL;
+        }
+
+        for (Uint64 i = 0; i < CachedIndexedBindings; i++)
+        {
+            if (m_state.UniformRanges[i].Buffer == buffer)
+                m_state.UniformRanges[i].Buffer = UnknownStateOGL;
+
+            if (m_state.StorageRanges[i].Buffer == buffer)
+                m_state.StorageRanges[i].Buffer = UnknownStateOGL;
+        }
+
+        for (Uint64 i = 0; i < m_vertexFormatsCount; i++)
+        {
+            if (m_vertexFormats[i].BoundBuffer == buffer)
+                m_vertexFormats[i].BoundBuffer = UnknownStateOGL;
+        }
+    }
+
+    void GraphicsContextOGL::ForgetTexture(Uint32 texture)
+    {
+        for (auto& unit : m_state.Textures)
+        {
+            for (Uint32& boundTexture : unit)
+            {
+                if (boundTexture == texture)
+                    boundTexture = UnknownStateOGL;
+            }
+        }
+    }
+
+    void GraphicsContextOGL::ForgetSampler(Uint32 sampler)
+    {
+        for (Uint32& boundSampler : m_state.Samplers)
+        {
+            if (boundSampler == sampler)
+                boundSampler = UnknownStateOGL;
+        }
+    }
+
+    void GraphicsContextOGL::ForgetFramebuffer(Uint32 framebuffer)
+    {
+        if (m_state.Framebuffer == framebuffer)
+            m_state.Framebuffer = UnknownStateOGL;
+    }
+
+    Uint32 GraphicsContextOGL::CreateBufferObject(BufferBindings binding, Uint64 size, const void* data, Uint32 usage)
+    {
+        Uint32 buffer;
+
+        // Names of glGenBuffers become buffers only when they are bound, so they can't be used by DSA calls
+        if (m_capabilities.DirectStateAccess)
+            glCreateBuffers(1, &buffer);
+        else
+            glGenBuffers(1, &buffer);
+
+        SetBufferData(binding, buffer, size, data, usage);
+
+        return buffer;
+    }
+
+    void GraphicsContextOGL::SetBufferData(BufferBindings binding, Uint32 buffer, Uint64 size, const void* data,
+                                           Uint32 usage)
+    {
+        if (m_capabilities.DirectStateAccess)
+        {
+            glNamedBufferData(buffer, size, data, usage);
+            return;
+        }
+
+        BindBuffer(binding, buffer);
+        glBufferData(BufferTargetsOGL[ENUM_VALUE(binding)], size, data, usage);
+    }
+
+    void GraphicsContextOGL::UpdateBufferData(BufferBindings binding, Uint32 buffer, Uint64 offset, Uint64 size,
+                                              const void* data)
+    {
+        if (m_capabilities.DirectStateAccess)
+        {
+            glNamedBufferSubData(buffer, offset, size, data);
+            return;
+        }
+
+        BindBuffer(binding, buffer);
+        glBufferSubData(BufferTargetsOGL[ENUM_VALUE(binding)], offset, size, data);
+    }
+
+    void GraphicsContextOGL::ReadBufferData(BufferBindings binding, Uint32 buffer, Uint64 offset, Uint64 size,
+                                            void* data)
+    {
+        if (m_capabilities.DirectStateAccess)
+        {
+            glGetNamedBufferSubData(buffer, offset, size, data);
+            return;
+        }
+
+        BindBuffer(binding, buffer);
+        glGetBufferSubData(BufferTargetsOGL[ENUM_VALUE(binding)], offset, size, data);
+    }
+
+    Uint32 GraphicsContextOGL::RecreateTexture(TextureBindings binding, Uint32 texture)
+    {
+        Uint32 newTexture;
+        glCreateTextures(TextureTargetsOGL[ENUM_VALUE(binding)], 1, &newTexture);
+
+        glDeleteTextures(1, &texture);
+        ForgetTexture(texture);
+
+        return newTexture;
+    }
+
+    template <typename entry, typename emptyTest, typename matchTest>
+    Uint64 GraphicsContextOGL::FindCacheSlot(entry*& entries, Uint64& count, Uint64& capacity, emptyTest isEmpty,
+                                             matchTest matches, bool& found)
+    {
+        Uint64 emptySlot = count;
+
+        for (Uint64 i = 0; i < count; i++)
+        {
+            if (isEmpty(entries[i]))
+            {
+                emptySlot = MIN(emptySlot, i);
+                continue;
+            }
+
+            if (matches(entries[i]))
+            {
+                found = true;
+                return i;
+            }
+        }
+
+        found = false;
+
+        if (emptySlot != count)
+            return emptySlot;
+
+        if (count == capacity)
+        {
+            Uint64 newCapacity = MAX(capacity * 2, 8);
+
+            auto newEntries = reinterpret_cast<entry*>(m_structAllocator->AllocateMemory(newCapacity * sizeof(entry)));
+
+            if (entries != nullptr)
+            {
+                CopyMemory(newEntries, entries, count * sizeof(entry));
+                m_structAllocator->FreeMemory(entries);
+            }
+
+            entries = newEntries;
+            capacity = newCapacity;
+        }
+
+        return count++;
+    }
+
+    // Anisotropy is clamped by the limit of device before hashing, so samplings which differ only
+    // above the limit share one sampler object
+    static SamplingInfo ClampSampling(SamplingInfo samplingInfo, Float32 maxAnisotropy)
+    {
+        samplingInfo.MaxAnisotropy = (maxAnisotropy > 0.0f) ?
+                MIN(MAX(samplingInfo.MaxAnisotropy, 1.0f), maxAnisotropy) : 0.0f;
+
+        return samplingInfo;
+    }
+
+    Uint64 GraphicsContextOGL::AcquireSampler(const SamplingInfo& samplingInfo)
+    {
+        SamplingInfo sampling = ClampSampling(samplingInfo, m_capabilities.MaxAnisotropy);
+        Uint64 hash = HashMemory(&sampling, sizeof(SamplingInfo));
+
+        auto isEmpty = [](const SamplerOGL& sampler) { return sampler.UsersCount == 0; };
+
+        auto matches = [&](const SamplerOGL& sampler)
+        {
+            return sampler.Hash == hash && CompareSamplingInfos(sampler.Sampling, sampling);
+        };
+
+        bool found;
+        Uint64 sampler = FindCacheSlot(m_samplers, m_samplersCount, m_samplersCapacity, isEmpty, matches, found);
+
+        if (found)
+        {
+            m_samplers[sampler].UsersCount++;
+            return sampler;
+        }
+
+        m_samplers[sampler] = {CreateSamplerObject(sampling), hash, 1, sampling};
+
+        return sampler;
+    }
+
+    void GraphicsContextOGL::ReleaseSampler(Uint64 sampler)
+    {
+        SamplerOGL& samplerObject = m_samplers[sampler];
+
+        if (--samplerObject.UsersCount != 0)
+            return;
+
+        glDeleteSamplers(1, &samplerObject.Sampler);
+        ForgetSampler(samplerObject.Sampler);
+
+        samplerObject = {0, 0, 0, SamplingInfo()};
+    }
+
+    Uint32 GraphicsContextOGL::CreateSamplerObject(const SamplingInfo& samplingInfo)
+    {
+        Uint32 addressModeOGL = TextureAddressModesOGL[ENUM_VALUE(samplingInfo.AddressMode)];
+        Uint32 minFilterOGL = TextureMinFilterModesOGL[ENUM_VALUE(samplingInfo.MinFilter)];
+        Uint32 magFilterOGL = TextureMagFilterModesOGL[ENUM_VALUE(samplingInfo.MagFilter)];
+
+        // Parameters of sampler are set by name, so it's never bound for that
+        Uint32 sampler;
+        glGenSamplers(1, &sampler);
+
+        // Sampler doesn't know dimension of texture, so all of the coordinates are wrapped
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, addressModeOGL);
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, addressModeOGL);
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_R, addressModeOGL);
+
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, minFilterOGL);
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, magFilterOGL);
+
+        glSamplerParameterf(sampler, GL_TEXTURE_MIN_LOD, samplingInfo.MinLOD);
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_LOD, samplingInfo.MaxLOD);
+        glSamplerParameterf(sampler, GL_TEXTURE_LOD_BIAS, samplingInfo.LODBias);
+
+        if (m_capabilities.MaxAnisotropy > 0.0f)
+            glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, samplingInfo.MaxAnisotropy);
+
+        return sampler;
+    }
+
+    // Mipmaps can't be generated for integer formats, so their textures have only one level
+    static Uint32 GetMipLevelsCount(Uint32 pixelFormatOGL, Uint64 width, Uint64 height = 1, Uint64 depth = 1)
+    {
+        if (pixelFormatOGL == GL_RGBA_INTEGER || pixelFormatOGL == GL_RGB_INTEGER)
+            return 1;
+
+        Uint64 size = MAX(width, MAX(height, depth));
+        Uint32 levels = 1;
+
+        while (size > 1)
+        {
+            size >>= 1;
+            levels++;
+        }
+
+        return levels;
+    }
+
+    void GraphicsContextOGL::SetTarget() {
+        m_colorBuffer = true;
+        BindFramebuffer(0);
+        glViewport(0, 0, m_window->GetWidth(), m_window->GetHeight());
+    }
+
+    void GraphicsContextOGL::SetTarget(RenderTarget* renderTarget)
+    {
+        if (renderTarget == nullptr || renderTarget->GetComponentHandle<RenderTargetOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Render target is invalid. Can not set it", LogTypes::WarningLog);
+            return;
+        }
+
+        // Target may have only depth and stencil attachments (shadow maps), then color isn't cleared
+        m_colorBuffer = renderTarget->GetUsedColorTextures() != 0;
+
+        BindFramebuffer(renderTarget->GetComponentHandle<RenderTargetOGL>()->Framebuffer);
+        glViewport(0, 0, renderTarget->Width(), renderTarget->Height());
+    }
+
+    void GraphicsContextOGL::EnableDepthTest()
+    {
+        m_depthBuffer = true;
+        SetStateFlag(StateFlags::DepthTest, true);
+    }
+
+    void GraphicsContextOGL::DisableDepthTest()
+    {
+        m_depthBuffer = false;
+        SetStateFlag(StateFlags::DepthTest, false);
+    }
+
+    void GraphicsContextOGL::EnableStencilTest()
+    {
+        m_stencilBuffer = true;
+        SetStateFlag(StateFlags::StencilTest, true);
+    }
+
+    void GraphicsContextOGL::DisableStencilTest()
+    {
+        m_stencilBuffer = false;
+        SetStateFlag(StateFlags::StencilTest, false);
+    }
+
+    void GraphicsContextOGL::ClearTarget(Float32 red, Float32 green, Float32 blue) {
+        OpenWriteMasks();
+
+        glClearColor(red, green, blue, 1.0);
+
+        Uint32 flags = 0;
+
+        flags |= (m_colorBuffer)? GL_COLOR_BUFFER_BIT : 0;
+        flags |= (m_depthBuffer)? GL_DEPTH_BUFFER_BIT : 0;
+        flags |= (m_stencilBuffer)? GL_STENCIL_BUFFER_BIT : 0;
+
+        glClear(flags);
+    }
+
+    VertexBuffer * GraphicsContextOGL::CreateVertexBuffer(VertexBuffer::Desc description)
+    {
+        // Layouts from MakeVertexLayout were already checked at compile time
+        if (description.Layout.Precomputed)
+        {
+            if (description.VertexSize == 0)
+                description.VertexSize = description.Layout.Stride;
+
+            else if (description.VertexSize < description.Layout.Stride)
+            {
+                m_debugger->MakeLog("Buffer creation is failed. Vertex size is less than layout's stride",
+                                    LogTypes::WarningLog);
+                return nullptr;
+            }
+        }
+
+        else if (!ValidateVertexLayout(description.Layout, description.VertexSize))
+        {
+            m_debugger->MakeLog("Buffer creation is failed. Vertex layout doesn't match the vertex", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        Uint64 bufferSize = description.VertexSize * description.VertexCount;
+
+        if (bufferSize == 0)
+        {
+            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        if (description.VertexPulling)
+            return CreatePulledVertexBuffer(description, bufferSize);
+
+        Uint32 vbo = CreateBufferObject(BufferBindings::ArrayBinding, bufferSize, description.Vertices,
+                                        BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
+
+        // Padding of attributes is hashed with them, so it's zeroed
+        VertexBufferOGL bufferHandle;
+        SetMemory(&bufferHandle, sizeof(bufferHandle), 0);
+
+        bufferHandle.VertexBuffer = vbo;
+        bufferHandle.Stride = description.VertexSize;
+        bufferHandle.AttributesCount = description.Layout.Count;
+
+        Uint64 offset = 0;
+
+        for (Uint64 i = 0; i < description.Layout.Count; i++)
+        {
+            const VertexInputElement& element = description.Layout.Inputs[i];
+            VertexAttributeOGL& attribute = bufferHandle.Attributes[i];
+
+            if (element.Offset != VertexElementAutoOffset)
+                offset = element.Offset;
+
+            attribute.Count = element.Count;
+            attribute.Type = TypeQualifiersOGL[ENUM_VALUE(element.Type)];
+            attribute.Normalized = (element.Normalized) ? GL_TRUE : GL_FALSE;
+            attribute.Divisor = element.InstanceStepRate;
+            attribute.Offset = offset;
+
+            offset += element.Count * TypeSizesOGL[ENUM_VALUE(element.Type)];
+        }
+
+        if (m_capabilities.VertexAttribBinding)
+        {
+            bufferHandle.VertexFormat = AcquireVertexFormat(bufferHandle);
+            bufferHandle.VertexArray = m_vertexFormats[bufferHandle.VertexFormat].VertexArray;
+        }
+
+        else
+        {
+            bufferHandle.VertexArray = CreateVertexArray(bufferHandle);
+        }
+
+        auto newBuffer = reinterpret_cast<VertexBuffer*>(m_structAllocator->AllocateMemory(sizeof(VertexBuffer)));
+        new (newBuffer) VertexBuffer(description.VertexSize, m_bufferAllocator);
+
+        newBuffer->SetVertices(description.Vertices, description.VertexCount);
+        newBuffer->SetComponentHandle<VertexBufferOGL>(&bufferHandle, m_structAllocator);
+
+        m_debugger->MakeLog("Vertex buffer was created correctly", LogTypes::InfoLog);
+
+        return newBuffer;
+    }
+
+    VertexBuffer * GraphicsContextOGL::CreatePulledVertexBuffer(const VertexBuffer::Desc& description,
+                                                                 Uint64 bufferSize)
+    {
+        if (!m_capabilities.VertexPulling)
+        {
+            m_debugger->MakeLog("Vertex pulling needs storage buffers in vertex shader. Buffer is not created",
+                                LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        if (m_pullingVertexArray == 0)
+            glGenVertexArrays(1, &m_pullingVertexArray);
+
+        Uint32 usage = BufferUsagesOGL[ENUM_VALUE(description.Usage)];
+
+        // Shader reads buffer by whole words, so the last one is padded
+        Uint64 storageSize = (bufferSize + 3) & ~3ull;
+        Uint32 vbo;
+
+        if (storageSize == bufferSize || description.Vertices == nullptr)
+        {
+            vbo = CreateBufferObject(BufferBindings::StorageBinding, storageSize, description.Vertices, usage);
+        }
+
+        else
+        {
+            vbo = CreateBufferObject(BufferBindings::StorageBinding, storageSize, nullptr, usage);
+            UpdateBufferData(BufferBindings::StorageBinding, vbo, 0, bufferSize, description.Vertices);
+        }
+
+        VertexBufferOGL bufferHandle;
+        SetMemory(&bufferHandle, sizeof(bufferHandle), 0);
+
+        bufferHandle.VertexArray = m_pullingVertexArray;
+        bufferHandle.VertexBuffer = vbo;
+        bufferHandle.VertexPulling = true;
+        bufferHandle.Stride = description.VertexSize;
+
+        auto newBuffer = reinterpret_cast<VertexBuffer*>(m_structAllocator->AllocateMemory(sizeof(VertexBuffer)));
+        new (newBuffer) VertexBuffer(description.VertexSize, m_bufferAllocator);
+
+        newBuffer->SetVertices(description.Vertices, description.VertexCount);
+        newBuffer->SetComponentHandle<VertexBufferOGL>(&bufferHandle, m_structAllocator);
+
+        m_debugger->MakeLog("Pulled vertex buffer was created correctly", LogTypes::InfoLog);
+
+        return newBuffer;
+    }
+
+    IndexBuffer * GraphicsContextOGL::CreateIndexBuffer(IndexBuffer::Desc description)
+    {
+        Uint64 bufferSize = description.IndexCount * IndexBuffer::GetIndexSize(description.IndexType);
+
+        if (bufferSize == 0)
+        {
+            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        IndexType sourceIndexType = description.IndexType;
+
+        IndexBuffer::Range ranges[IndexBuffer::MaxRanges];
+        Uint64 rangesCount = 0;
+
+        void* narrowedIndices = nullptr;
+
+        if (description.NarrowIndices && description.Indices != nullptr)
+        {
+            Uint32 maxIndex = FindMaxIndex(description.Indices, description.IndexType, description.IndexCount);
+            IndexType narrowestType = GetNarrowestIndexType(maxIndex);
+
+            if (ENUM_VALUE(narrowestType) < ENUM_VALUE(description.IndexType))
+            {
+                narrowedIndices = m_bufferAllocator->AllocateMemory(
+                        description.IndexCount * IndexBuffer::GetIndexSize(narrowestType));
+
+                ConvertIndices(description.Indices, description.IndexType,
+                               narrowedIndices, narrowestType, description.IndexCount);
+            }
+
+            // Ranges are cut by triangles, so topology has to be known for that
+            else if (narrowestType == IndexType::UnsignedIntIndex && description.TriangleList)
+            {
+                narrowedIndices = m_bufferAllocator->AllocateMemory(description.IndexCount * sizeof(Uint16));
+                rangesCount = SplitIndexRanges(description, reinterpret_cast<Uint16*>(narrowedIndices),
+                                               ranges, IndexBuffer::MaxRanges);
+
+                narrowestType = IndexType::UnsignedShortIndex;
+
+                if (rangesCount == 0)
+                {
+                    m_bufferAllocator->FreeMemory(narrowedIndices);
+                    narrowedIndices = nullptr;
+                }
+            }
+
+            if (narrowedIndices != nullptr)
+            {
+                description.Indices = narrowedIndices;
+                description.IndexType = narrowestType;
+                bufferSize = description.IndexCount * IndexBuffer::GetIndexSize(narrowestType);
+            }
+        }
+
+        IndexBufferOGL ibo = CreateBufferObject(BufferBindings::CopyBinding, bufferSize, description.Indices,
+                                                BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
+
+        auto newBuffer = reinterpret_cast<IndexBuffer*>(m_structAllocator->AllocateMemory(sizeof(IndexBuffer)));
+        new (newBuffer) IndexBuffer(description.IndexType, m_bufferAllocator);
+
+        newBuffer->SetIndices(description.Indices, description.IndexCount);
+        newBuffer->SetSourceIndexType(sourceIndexType);
+        newBuffer->SetRanges(ranges, rangesCount);
+        newBuffer->SetComponentHandle<IndexBufferOGL>(&ibo, m_structAllocator);
+
+        if (narrowedIndices != nullptr)
+            m_bufferAllocator->FreeMemory(narrowedIndices);
+
+        m_debugger->MakeLog("Index buffer was created correctly", LogTypes::InfoLog);
+
+        return newBuffer;
+    }
+
+    UniformBuffer * GraphicsContextOGL::CreateUniformBuffer(UniformBuffer::Desc description)
+    {
+        if (description.Size == 0)
+        {
+            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::UsersLog);
+            return nullptr;
+        }
+
+        UniformBufferOGL ubo = CreateBufferObject(BufferBindings::UniformBinding, description.Size, description.Data,
+                                                  BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
+
+        auto newBuffer = reinterpret_cast<UniformBuffer*>(m_structAllocator->AllocateMemory(sizeof(UniformBuffer)));
+        new (newBuffer) UniformBuffer(m_bufferAllocator);
+
+        newBuffer->SetData(description.Data, description.Size);
+        newBuffer->SetComponentHandle<UniformBufferOGL>(&ubo, m_structAllocator);
+
+        m_debugger->MakeLog("Uniform buffer was created correctly", LogTypes::InfoLog);
+
+        return newBuffer;
+    }
+
+    void GraphicsContextOGL::OverwriteBuffer(VertexBuffer *vbo, const void *newVertices, Uint64 vertexCount)
+    {
+        OverwriteBuffer(vbo, newVertices, 0, vertexCount);
+    }
+
+    void GraphicsContextOGL::OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 firstVertex,
+                                             Uint64 vertexCount)
+    {
+        if (vbo == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (newVertices == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (firstVertex >= vbo->GetVertexCount())
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because offset is out of buffer", LogTypes::WarningLog);
+            return;
+        }
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+
+        Uint64 offset = firstVertex * vbo->GetVertexSize();
+        Uint64 sizeToChange = MIN(vertexCount, vbo->GetVertexCount() - firstVertex) * vbo->GetVertexSize();
+
+        UpdateBufferData(BufferBindings::ArrayBinding, bufferHandle->VertexBuffer, offset, sizeToChange, newVertices);
+
+        CopyMemory(reinterpret_cast<Uint8*>(vbo->GetVertices()) + offset, newVertices, sizeToChange);
+
+        m_debugger->MakeLog("Overwriting of vertex buffer was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::OverwriteBuffer(IndexBuffer *ibo, const void *newIndices, Uint64 newCount)
+    {
+        OverwriteBuffer(ibo, newIndices, 0, newCount);
+    }
+
+    void GraphicsContextOGL::OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 firstIndex,
+                                             Uint64 indexCount)
+    {
+        if (ibo == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (newIndices == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (firstIndex >= ibo->GetIndexCount())
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because offset is out of buffer", LogTypes::WarningLog);
+            return;
+        }
+
+        IndexBufferOGL* bufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+
+        Uint64 countToChange = MIN(ibo->GetIndexCount() - firstIndex, indexCount);
+        Uint64 offset = firstIndex * IndexBuffer::GetIndexSize(ibo->GetIndexType());
+        Uint64 sizeToChange = countToChange * IndexBuffer::GetIndexSize(ibo->GetIndexType());
+
+        void* narrowedIndices = nullptr;
+
+        // Narrowed buffers take indices of the source type, so they are converted back here
+        if (ibo->GetIndexType() != ibo->GetSourceIndexType())
+        {
+            if (ibo->GetRangesCount() != 0)
+            {
+                m_debugger->MakeLog("Overwriting buffer is failed because buffer was split into ranges",
+                                    LogTypes::WarningLog);
+                return;
+            }
+
+            Uint32 maxIndex = FindMaxIndex(newIndices, ibo->GetSourceIndexType(), countToChange);
+
+            if (ENUM_VALUE(GetNarrowestIndexType(maxIndex)) > ENUM_VALUE(ibo->GetIndexType()))
+            {
+                m_debugger->MakeLog("Overwriting buffer is failed because new indices don't fit", LogTypes::WarningLog);
+                return;
+            }
+
+            narrowedIndices = m_bufferAllocator->AllocateMemory(sizeToChange);
+            ConvertIndices(newIndices, ibo->GetSourceIndexType(), narrowedIndices, ibo->GetIndexType(), countToChange);
+
+            newIndices = narrowedIndices;
+        }
+
+        UpdateBufferData(BufferBindings::CopyBinding, *bufferHandle, offset, sizeToChange, newIndices);
+
+        CopyMemory(reinterpret_cast<Uint8*>(ibo->GetIndices()) + offset, newIndices, sizeToChange);
+
+        if (narrowedIndices != nullptr)
+            m_bufferAllocator->FreeMemory(narrowedIndices);
+
+        m_debugger->MakeLog("Overwriting of index buffer was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::OverwriteBuffer(UniformBuffer *ubo, const void *newData, Uint64 newSize)
+    {
+        if (ubo == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ubo->GetComponentHandle<UniformBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (newData == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        UniformBufferOGL* bufferHandle = ubo->GetComponentHandle<UniformBufferOGL>();
+
+        Uint64 sizeToChange = MIN(ubo->GetSize(), newSize);
+
+        UpdateBufferData(BufferBindings::UniformBinding, *bufferHandle, 0, sizeToChange, newData);
+
+        CopyMemory(ubo->GetData(), newData, newSize);
+
+        m_debugger->MakeLog("Overwriting of uniform buffer was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::ReleaseBuffer(VertexBuffer *vbo)
+    {
+        if (vbo == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        glDeleteBuffers(1, &bufferHandle->VertexBuffer);
+        ForgetBuffer(bufferHandle->VertexBuffer);
+
+        if (bufferHandle->VertexPulling)
+        {
+            // VAO without attributes is shared by all of pulled buffers
+        }
+
+        else if (m_capabilities.VertexAttribBinding)
+        {
+            ReleaseVertexFormat(bufferHandle->VertexFormat);
+        }
+
+        else
+        {
+            glDeleteVertexArrays(1, &bufferHandle->VertexArray);
+            ForgetVertexArray(bufferHandle->VertexArray);
+        }
+
+        vbo->~VertexBuffer();
+        m_structAllocator->FreeMemory(vbo);
+
+        m_debugger->MakeLog("Releasing of vertex buffer was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::ReleaseBuffer(IndexBuffer *ibo)
+    {
+        if (ibo == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        IndexBufferOGL* bufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+        glDeleteBuffers(1, bufferHandle);
+        ForgetBuffer(*bufferHandle);
+
+        ibo->~IndexBuffer();
+        m_structAllocator->FreeMemory(ibo);
+
+        m_debugger->MakeLog("Releasing of index buffer was completed", LogTypes::WarningLog);
+    }
+
+    void GraphicsContextOGL::ReleaseBuffer(UniformBuffer *ubo)
+    {
+        if (ubo == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ubo->GetComponentHandle<UniformBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        UniformBufferOGL* bufferHandle = ubo->GetComponentHandle<UniformBufferOGL>();
+        glDeleteBuffers(1, bufferHandle);
+        ForgetBuffer(*bufferHandle);
+
+        ubo->~UniformBuffer();
+        m_structAllocator->FreeMemory(ubo);
+
+        m_debugger->MakeLog("Releasing of uniform buffer was completed", LogTypes::InfoLog);
+    }
+
+    IndirectBuffer * GraphicsContextOGL::CreateIndirectBuffer(IndirectBuffer::Desc description)
+    {
+        if (description.CommandCount == 0)
+        {
+            m_debugger->MakeLog("Buffer creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        Uint64 bufferSize = description.CommandCount * sizeof(DrawIndexedCommand);
+
+        IndirectBufferOGL buffer = CreateBufferObject(BufferBindings::IndirectBinding, bufferSize, description.Commands,
+                                                      BufferUsagesOGL[ENUM_VALUE(description.Usage)]);
+
+        auto newBuffer = reinterpret_cast<IndirectBuffer*>(m_structAllocator->AllocateMemory(sizeof(IndirectBuffer)));
+        new (newBuffer) IndirectBuffer(description.CommandCount, description.Usage);
+        newBuffer->SetSplitRanges(description.SplitRanges);
+
+        newBuffer->SetComponentHandle<IndirectBufferOGL>(&buffer, m_structAllocator);
+
+        m_debugger->MakeLog("Indirect buffer was created correctly", LogTypes::InfoLog);
+
+        return newBuffer;
+    }
+
+    void GraphicsContextOGL::OverwriteBuffer(IndirectBuffer* buffer, const DrawIndexedCommand* commands,
+                                             Uint64 commandCount)
+    {
+        if (buffer == nullptr || buffer->GetComponentHandle<IndirectBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because buffer is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (commands == nullptr || commandCount == 0)
+        {
+            m_debugger->MakeLog("Overwriting buffer is failed because new data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        IndirectBufferOGL* bufferHandle = buffer->GetComponentHandle<IndirectBufferOGL>();
+
+        // Commands are usually rebuilt every frame, so storage is orphaned instead of waiting for previous draws
+        if (commandCount > buffer->GetCommandCount() || buffer->GetUsage() != BufferUsage::StaticUsage)
+        {
+            Uint64 newCount = MAX(commandCount, buffer->GetCommandCount());
+
+            SetBufferData(BufferBindings::IndirectBinding, *bufferHandle, newCount * sizeof(DrawIndexedCommand),
+                          nullptr, BufferUsagesOGL[ENUM_VALUE(buffer->GetUsage())]);
+
+            buffer->SetCommandCount(newCount);
+        }
+
+        UpdateBufferData(BufferBindings::IndirectBinding, *bufferHandle, 0, commandCount * sizeof(DrawIndexedCommand),
+                         commands);
+    }
+
+    void GraphicsContextOGL::ReleaseBuffer(IndirectBuffer* buffer)
+    {
+        if (buffer == nullptr || buffer->GetComponentHandle<IndirectBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        IndirectBufferOGL* bufferHandle = buffer->GetComponentHandle<IndirectBufferOGL>();
+        glDeleteBuffers(1, bufferHandle);
+        ForgetBuffer(*bufferHandle);
+
+        buffer->~IndirectBuffer();
+        m_structAllocator->FreeMemory(buffer);
+
+        m_debugger->MakeLog("Releasing of indirect buffer was completed", LogTypes::InfoLog);
+    }
+
+    bool GraphicsContextOGL::CreateCullingProgram()
+    {
+        Uint32 shader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(shader, 1, &CullingShaderCode, nullptr);
+        glCompileShader(shader);
+
+        Uint32 program = glCreateProgram();
+        glAttachShader(program, shader);
+        glLinkProgram(program);
+
+        glDetachShader(program, shader);
+        glDeleteShader(shader);
+
+        Int32 linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+        if (linked != GL_TRUE)
+        {
+            glDeleteProgram(program);
+            m_debugger->MakeLog("Compute shader of GPU culling can not be compiled", LogTypes::WarningLog);
+            return false;
+        }
+
+        m_cullingProgram = program;
+        m_cullingPlanesLocation = glGetUniformLocation(program, "planes");
+        m_cullingObjectCountLocation = glGetUniformLocation(program, "objectCount");
+        m_cullingCompactLocation = glGetUniformLocation(program, "compact");
+
+        return true;
+    }
+
+    CullingBatch * GraphicsContextOGL::CreateCullingBatch(CullingBatch::Desc description)
+    {
+        if (!m_capabilities.ComputeShaders)
+        {
+            m_debugger->MakeLog("GPU culling needs compute shaders (OpenGL 4.3). Batch is not created",
+                                LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        if (description.ObjectCount == 0)
+        {
+            m_debugger->MakeLog("Batch creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        if (m_cullingProgram == 0 && !CreateCullingProgram())
+            return nullptr;
+
+        Uint32 usage = BufferUsagesOGL[ENUM_VALUE(description.Usage)];
+        Uint64 spheresSize = description.ObjectCount * sizeof(Float32) * 4;
+        Uint64 commandsSize = description.ObjectCount * sizeof(DrawIndexedCommand);
+
+        CullingBatchOGL batchHandle;
+
+        batchHandle.SpheresBuffer = CreateBufferObject(BufferBindings::StorageBinding, spheresSize,
+                                                       description.Spheres, usage);
+        batchHandle.CommandsBuffer = CreateBufferObject(BufferBindings::StorageBinding, commandsSize,
+                                                        description.Commands, usage);
+
+        // Output buffers are written only by GPU
+        Uint32 zero = 0;
+
+        batchHandle.VisibleBuffer = CreateBufferObject(BufferBindings::StorageBinding, commandsSize, nullptr,
+                                                       GL_DYNAMIC_COPY);
+        batchHandle.CountBuffer = CreateBufferObject(BufferBindings::StorageBinding, sizeof(Uint32), &zero,
+                                                     GL_DYNAMIC_COPY);
+
+        auto newBatch = reinterpret_cast<CullingBatch*>(m_structAllocator->AllocateMemory(sizeof(CullingBatch)));
+        new (newBatch) CullingBatch(description.ObjectCount);
+
+        newBatch->SetComponentHandle<CullingBatchOGL>(&batchHandle, m_structAllocator);
+
+        m_debugger->MakeLog("Culling batch was created correctly", LogTypes::InfoLog);
+
+        return newBatch;
+    }
+
+    void GraphicsContextOGL::OverwriteBatch(CullingBatch* batch, const Float32* spheres,
+                                            const DrawIndexedCommand* commands, Uint64 firstObject,
+                                            Uint64 objectCount)
+    {
+        if (batch == nullptr || batch->GetComponentHandle<CullingBatchOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting batch is failed because batch is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (firstObject + objectCount > batch->GetObjectCount())
+        {
+            m_debugger->MakeLog("Overwriting batch is failed because objects are out of batch", LogTypes::WarningLog);
+            return;
+        }
+
+        CullingBatchOGL* batchHandle = batch->GetComponentHandle<CullingBatchOGL>();
+
+        if (spheres != nullptr)
+        {
+            UpdateBufferData(BufferBindings::StorageBinding, batchHandle->SpheresBuffer,
+                             firstObject * sizeof(Float32) * 4, objectCount * sizeof(Float32) * 4, spheres);
+        }
+
+        if (commands != nullptr)
+        {
+            UpdateBufferData(BufferBindings::StorageBinding, batchHandle->CommandsBuffer,
+                             firstObject * sizeof(DrawIndexedCommand), objectCount * sizeof(DrawIndexedCommand),
+                             commands);
+        }
+    }
+
+    void GraphicsContextOGL::ReleaseCullingBatch(CullingBatch* batch)
+    {
+        if (batch == nullptr || batch->GetComponentHandle<CullingBatchOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Batch is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        CullingBatchOGL* batchHandle = batch->GetComponentHandle<CullingBatchOGL>();
+
+        glDeleteBuffers(1, &batchHandle->SpheresBuffer);
+        glDeleteBuffers(1, &batchHandle->CommandsBuffer);
+        glDeleteBuffers(1, &batchHandle->VisibleBuffer);
+        glDeleteBuffers(1, &batchHandle->CountBuffer);
+
+        ForgetBuffer(batchHandle->SpheresBuffer);
+        ForgetBuffer(batchHandle->CommandsBuffer);
+        ForgetBuffer(batchHandle->VisibleBuffer);
+        ForgetBuffer(batchHandle->CountBuffer);
+
+        batch->~CullingBatch();
+        m_structAllocator->FreeMemory(batch);
+
+        m_debugger->MakeLog("Releasing of culling batch was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::CullBatch(CullingBatch* batch, const Frustum& frustum)
+    {
+        if (batch == nullptr || batch->GetComponentHandle<CullingBatchOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Batch is invalid. Culling can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        CullingBatchOGL* batchHandle = batch->GetComponentHandle<CullingBatchOGL>();
+        Uint64 objectCount = batch->GetObjectCount();
+
+        Float32 planes[Frustum::PlanesCount * 4];
+
+        for (Uint64 i = 0; i < Frustum::PlanesCount; i++)
+        {
+            planes[i * 4] = frustum.Planes[i].Normal[0];
+            planes[i * 4 + 1] = frustum.Planes[i].Normal[1];
+            planes[i * 4 + 2] = frustum.Planes[i].Normal[2];
+            planes[i * 4 + 3] = frustum.Planes[i].Distance;
+        }
+
+        // Culling goes between binding of shader and drawing, so shader of user is restored after
+        Uint32 boundProgram = m_state.Program;
+
+        UseProgram(m_cullingProgram);
+        glUniform4fv(m_cullingPlanesLocation, Frustum::PlanesCount, planes);
+        glUniform1ui(m_cullingObjectCountLocation, static_cast<Uint32>(objectCount));
+        glUniform1i(m_cullingCompactLocation, m_capabilities.IndirectCount ? 1 : 0);
+
+        Uint32 zero = 0;
+
+        UpdateBufferData(BufferBindings::StorageBinding, batchHandle->CountBuffer, 0, sizeof(Uint32), &zero);
+
+        BindBufferRange(BufferBindings::StorageBinding, 0, batchHandle->SpheresBuffer, 0, 0);
+        BindBufferRange(BufferBindings::StorageBinding, 1, batchHandle->CommandsBuffer, 0, 0);
+        BindBufferRange(BufferBindings::StorageBinding, 2, batchHandle->VisibleBuffer, 0, 0);
+        BindBufferRange(BufferBindings::StorageBinding, 3, batchHandle->CountBuffer, 0, 0);
+
+        glDispatchCompute((objectCount + CullingGroupSize - 1) / CullingGroupSize, 1, 1);
+
+        // Written commands are read by indirect draws and by ReadCulledCount
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+        // Unknown program stays unknown, so the next binding of user's shader isn't skipped
+        if (boundProgram != UnknownStateOGL)
+            UseProgram(boundProgram);
+        else
+            m_state.Program = UnknownStateOGL;
+    }
+
+    Uint64 GraphicsContextOGL::ReadCulledCount(CullingBatch* batch)
+    {
+        if (batch == nullptr || batch->GetComponentHandle<CullingBatchOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Batch is invalid. Culled objects can not be read", LogTypes::WarningLog);
+            return 0;
+        }
+
+        CullingBatchOGL* batchHandle = batch->GetComponentHandle<CullingBatchOGL>();
+
+        Uint32 count = 0;
+
+        ReadBufferData(BufferBindings::StorageBinding, batchHandle->CountBuffer, 0, sizeof(Uint32), &count);
+
+        return count;
+    }
+
+    static bool IsSamplerType(Uint32 type)
+    {
+        switch (type)
+        {
+            case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_CUBE_SHADOW:
+            case GL_SAMPLER_1D_ARRAY: case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_1D_ARRAY_SHADOW: case GL_SAMPLER_2D_ARRAY_SHADOW:
+            case GL_SAMPLER_2D_MULTISAMPLE: case GL_SAMPLER_2D_RECT: case GL_SAMPLER_BUFFER:
+            case GL_INT_SAMPLER_1D: case GL_INT_SAMPLER_2D: case GL_INT_SAMPLER_3D: case GL_INT_SAMPLER_CUBE:
+            case GL_INT_SAMPLER_1D_ARRAY: case GL_INT_SAMPLER_2D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_1D: case GL_UNSIGNED_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_3D:
+            case GL_UNSIGNED_INT_SAMPLER_CUBE: case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    void GraphicsContextOGL::AddShaderBinding(ShaderOGL* shaderHandle, const char* name, ShaderBindingKinds kind,
+                                              Uint32 slot)
+    {
+        if (shaderHandle->BindingsCount == MaxShaderBindings)
+        {
+            m_debugger->MakeLog("Shader has too many resources. The rest of them can not be bound", LogTypes::WarningLog);
+            return;
+        }
+
+        // Arrays are reported as "name[0]", they are found by the name without brackets
+        Uint64 length = 0;
+
+        while (name[length] != '\0' && name[length] != '[')
+            length++;
+
+        ShaderBindingOGL& binding = shaderHandle->Bindings[shaderHandle->BindingsCount++];
+
+        binding.NameHash = HashMemory(name, length);
+        binding.Kind = kind;
+        binding.Slot = slot;
+    }
+
+    void GraphicsContextOGL::ReflectShader(ShaderOGL* shaderHandle)
+    {
+        // Names which are longer are cut (and won't be found by bindings)
+        static const Uint64 MaxNameLength = 128;
+
+        Uint32 program = shaderHandle->ShaderProgram;
+        shaderHandle->BindingsCount = 0;
+
+        Int32 linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+        if (linked != GL_TRUE)
+        {
+            m_debugger->MakeLog("Shader program is not linked. It has no bindings", LogTypes::WarningLog);
+            return;
+        }
+
+        bool query = m_capabilities.ProgramInterfaceQuery;
+        char name[MaxNameLength];
+
+        // Every uniform block gets binding point equal to its index
+        Int32 blocksCount = 0;
+
+        if (query)
+            glGetProgramInterfaceiv(program, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &blocksCount);
+        else
+            glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blocksCount);
+
+        for (Int32 i = 0; i < blocksCount; i++)
+        {
+            if (query)
+                glGetProgramResourceName(program, GL_UNIFORM_BLOCK, i, MaxNameLength, nullptr, name);
+            else
+                glGetActiveUniformBlockName(program, i, MaxNameLength, nullptr, name);
+
+            glUniformBlockBinding(program, i, i);
+            AddShaderBinding(shaderHandle, name, ShaderBindingKinds::UniformBlock, i);
+        }
+
+        // Samplers get texture units one by one (array takes a unit per element).
+        // Setting of sampler uniforms needs the program to be bound, shader of user is restored after
+        Uint32 boundProgram = m_state.Program;
+        UseProgram(program);
+
+        Int32 uniformsCount = 0;
+        Uint32 textureUnit = 0;
+
+        if (query)
+            glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformsCount);
+        else
+            glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformsCount);
+
+        for (Int32 i = 0; i < uniformsCount; i++)
+        {
+            Int32 type = 0;
+            Int32 arraySize = 0;
+            Int32 location = -1;
+
+            if (query)
+            {
+                const Uint32 properties[3] = {GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION};
+                Int32 values[3];
+
+                glGetProgramResourceiv(program, GL_UNIFORM, i, 3, properties, 3, nullptr, values);
+                glGetProgramResourceName(program, GL_UNIFORM, i, MaxNameLength, nullptr, name);
+
+                type = values[0];
+                arraySize = values[1];
+                location = values[2];
+            }
+
+            else
+            {
+                Uint32 uniformType = 0;
+
+                glGetActiveUniform(program, i, MaxNameLength, nullptr, &arraySize, &uniformType, name);
+
+                type = static_cast<Int32>(uniformType);
+                location = glGetUniformLocation(program, name);
+            }
+
+            if (!IsSamplerType(type) || location < 0)
+                continue;
+
+            Int32 units[MaxShaderBindings];
+            Int32 unitsCount = MIN(arraySize, static_cast<Int32>(MaxShaderBindings));
+
+            for (Int32 j = 0; j < unitsCount; j++)
+                units[j] = static_cast<Int32>(textureUnit) + j;
+
+            glUniform1iv(location, unitsCount, units);
+            AddShaderBinding(shaderHandle, name, ShaderBindingKinds::Sampler, textureUnit);
+
+            textureUnit += unitsCount;
+        }
+
+        if (boundProgram != UnknownStateOGL)
+            UseProgram(boundProgram);
+        else
+            m_state.Program = UnknownStateOGL;
+
+        // Attributes keep the locations which were given by layout or by shader
+        Int32 attributesCount = 0;
+
+        if (query)
+            glGetProgramInterfaceiv(program, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &attributesCount);
+        else
+            glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &attributesCount);
+
+        for (Int32 i = 0; i < attributesCount; i++)
+        {
+            Int32 location = -1;
+
+            if (query)
+            {
+                const Uint32 property = GL_LOCATION;
+
+                glGetProgramResourceiv(program, GL_PROGRAM_INPUT, i, 1, &property, 1, nullptr, &location);
+                glGetProgramResourceName(program, GL_PROGRAM_INPUT, i, MaxNameLength, nullptr, name);
+            }
+
+            else
+            {
+                Int32 size = 0;
+                Uint32 type = 0;
+
+                glGetActiveAttrib(program, i, MaxNameLength, nullptr, &size, &type, name);
+                location = glGetAttribLocation(program, name);
+            }
+
+            // Built-in inputs (gl_VertexID and so on) have no location
+            if (location >= 0)
+                AddShaderBinding(shaderHandle, name, ShaderBindingKinds::Attribute, location);
+        }
+    }
+
+    const GraphicsContextOGL::ShaderBindingOGL* GraphicsContextOGL::FindShaderBinding(
+            Shader* shader, ShaderBindingID binding, ShaderBindingKinds kind)
+    {
+        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
+
+        // Table of asynchronous shader is filled when its program is ready
+        FinishShader(shaderHandle);
+
+        for (Uint64 i = 0; i < shaderHandle->BindingsCount; i++)
+        {
+            const ShaderBindingOGL& candidate = shaderHandle->Bindings[i];
+
+            if (candidate.NameHash == binding.Hash && candidate.Kind == kind)
+                return &candidate;
+        }
+
+        return nullptr;
+    }
+
+    namespace
+    {
+        // "T3PB" in the first bytes of file
+        static const Uint32 ProgramCacheMagic = 0x42503354;
+
+        struct ProgramCacheHeader
+        {
+            Uint32 Magic;
+            Uint32 Format;
+            Uint64 Key;
+            Uint64 Size;
+            Float64 CompileSeconds;
+        };
+    }
+
+    void GraphicsContextOGL::SetProgramCacheDirectory(const char* directory)
+    {
+        if (directory == nullptr)
+        {
+            m_programCacheDirectory[0] = '\0';
+            return;
+        }
+
+        if (!m_capabilities.ProgramBinary)
+        {
+            m_debugger->MakeLog("Driver doesn't give program binaries. Program cache is not used", LogTypes::WarningLog);
+            return;
+        }
+
+        // Name of file (hash and extension) is appended to the directory
+        if (strlen(directory) + 32 > MaxCachePathLength)
+        {
+            m_debugger->MakeLog("Path of program cache is too long. Program cache is not used", LogTypes::WarningLog);
+            m_programCacheDirectory[0] = '\0';
+            return;
+        }
+
+        strcpy(m_programCacheDirectory, directory);
+
+        m_debugger->MakeLog("Program cache directory was set", LogTypes::InfoLog);
+    }
+
+    const GraphicsContextOGL::ProgramCacheStatistics& GraphicsContextOGL::GetProgramCacheStatistics() const
+    {
+        return m_programCacheStatistics;
+    }
+
+    bool GraphicsContextOGL::MakeCacheFilePath(Uint64 key, char* path)
+    {
+        Int32 length = snprintf(path, MaxCachePathLength, "%s/%016llx.bin", m_programCacheDirectory,
+                                static_cast<unsigned long long>(key));
+
+        if (length < 0 || static_cast<Uint64>(length) >= MaxCachePathLength)
+        {
+            m_debugger->MakeLog("Path of cached program is too long. Program cache is not used", LogTypes::WarningLog);
+            m_programCacheDirectory[0] = '\0';
+            return false;
+        }
+
+        return true;
+    }
+
+    Uint32 GraphicsContextOGL::LoadCachedProgram(Uint64 key, Float64* compileSeconds)
+    {
+        char path[MaxCachePathLength];
+
+        if (!MakeCacheFilePath(key, path))
+            return 0;
+
+        FILE* file = fopen(path, "rb");
+
+        if (file == nullptr)
+            return 0;
+
+        ProgramCacheHeader header = {};
+        void* binary = nullptr;
+
+        bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.Magic == ProgramCacheMagic &&
+                     header.Key == key && header.Size > 0 && header.Size <= 0x7FFFFFFF;
+
+        if (valid)
+        {
+            binary = m_bufferAllocator->AllocateMemory(header.Size);
+            valid = fread(binary, header.Size, 1, file) == 1;
+        }
+
+        fclose(file);
+
+        Uint32 program = 0;
+
+        if (valid)
+        {
+            program = glCreateProgram();
+            glProgramBinary(program, header.Format, binary, static_cast<Int32>(header.Size));
+
+            // Driver can refuse binary even if its version string is the same (after an update, for example)
+            Int32 linked = GL_FALSE;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+            if (linked != GL_TRUE)
+            {
+                glDeleteProgram(program);
+                program = 0;
+            }
+        }
+
+        if (binary != nullptr)
+            m_bufferAllocator->FreeMemory(binary);
+
+        if (program == 0)
+        {
+            m_programCacheStatistics.Rejected++;
+            m_debugger->MakeLog("Cached program binary was rejected. Shader is compiled from sources",
+                                LogTypes::WarningLog);
+            return 0;
+        }
+
+        *compileSeconds = header.CompileSeconds;
+
+        return program;
+    }
+
+    void GraphicsContextOGL::StoreCachedProgram(Uint64 key, Uint32 program, Float64 compileSeconds)
+    {
+        char path[MaxCachePathLength];
+
+        if (!MakeCacheFilePath(key, path))
+            return;
+
+        Int32 size = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+
+        if (size <= 0)
+            return;
+
+        void* binary = m_bufferAllocator->AllocateMemory(size);
+
+        Int32 written = 0;
+        Uint32 format = 0;
+        glGetProgramBinary(program, size, &written, &format, binary);
+
+        ProgramCacheHeader header = {ProgramCacheMagic, format, key, static_cast<Uint64>(written), compileSeconds};
+
+        FILE* file = fopen(path, "wb");
+        bool stored = false;
+
+        if (file != nullptr)
+        {
+            stored = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(binary, written, 1, file) == 1;
+            fclose(file);
+
+            // Cut file would be rejected anyway, so it's removed right away
+            if (!stored)
+                remove(path);
+        }
+
+        m_bufferAllocator->FreeMemory(binary);
+
+        if (!stored)
+            m_debugger->MakeLog("Program binary can not be written into cache directory", LogTypes::WarningLog);
+    }
+
+    Uint32 GraphicsContextOGL::CompileStage(Uint32 type, const char* code, const ShaderBinary& binary)
+    {
+        if (code != nullptr)
+        {
+            Uint32 shader = glCreateShader(type);
+            glShaderSource(shader, 1, &code, nullptr);
+            glCompileShader(shader);
+
+            return shader;
+        }
+
+        if (binary.Code == nullptr)
+            return 0;
+
+        if (!m_capabilities.SpirV)
+        {
+            m_debugger->MakeLog("Driver doesn't support SPIR-V shaders. Stage of shader is skipped",
+                                LogTypes::WarningLog);
+            return 0;
+        }
+
+        const char* entryPoint = binary.EntryPoint != nullptr ? binary.EntryPoint : "main";
+        auto constantsCount = static_cast<Uint32>(binary.ConstantsCount);
+
+        // Module is already parsed and checked offline, specialization replaces compilation of GLSL
+        Uint32 shader = glCreateShader(type);
+
+        if (m_capabilities.SpirVCore)
+        {
+            glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V, binary.Code, static_cast<Int32>(binary.Size));
+            glSpecializeShader(shader, entryPoint, constantsCount, binary.ConstantIDs, binary.ConstantValues);
+        }
+
+        else
+        {
+            glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, binary.Code,
+                           static_cast<Int32>(binary.Size));
+            glSpecializeShaderARB(shader, entryPoint, constantsCount, binary.ConstantIDs, binary.ConstantValues);
+        }
+
+        return shader;
+    }
+
+    void GraphicsContextOGL::CompileProgram(const Shader::Desc& description, ShaderOGL* shaderHandle)
+    {
+        const ShaderData& data = description.Data;
+
+        Uint32 vShader = CompileStage(GL_VERTEX_SHADER, data.VertexShaderCode, data.VertexShaderBinary);
+        Uint32 gShader = CompileStage(GL_GEOMETRY_SHADER, data.GeometryShaderCode, data.GeometryShaderBinary);
+        Uint32 fShader = CompileStage(GL_FRAGMENT_SHADER, data.PixelShaderCode, data.PixelShaderBinary);
+
+        Uint32 program = glCreateProgram();
+
+        if (m_programCacheDirectory[0] != '\0')
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        for (Uint64 i = 0; i < description.Layout.Count; i++)
+        {
+            // Unnamed elements (from MakeVertexLayout) rely on explicit locations in the shader
+            if (description.Layout.Inputs[i].Name != nullptr)
+                glBindAttribLocation(program, i, description.Layout.Inputs[i].Name);
+        }
+
+        // Zero is not a shader object, so missing stages aren't attached
+        if (vShader != 0)
+            glAttachShader(program, vShader);
+
+        if (gShader != 0)
+            glAttachShader(program, gShader);
+
+        if (fShader != 0)
+            glAttachShader(program, fShader);
+
+        glLinkProgram(program);
+
+        shaderHandle->VertexShader = vShader;
+        shaderHandle->GeometryShader = gShader;
+        shaderHandle->FragmentShader = fShader;
+        shaderHandle->ShaderProgram = program;
+    }
+
+    void GraphicsContextOGL::StartShader(const Shader::Desc& description, ShaderOGL* shaderHandle)
+    {
+        *shaderHandle = {};
+        shaderHandle->Pending = true;
+
+        shaderHandle->Cached = m_programCacheDirectory[0] != '\0';
+
+        // Binaries belong to the driver, so it's a part of the key
+        if (shaderHandle->Cached)
+            shaderHandle->CacheKey = HashMemory(&m_driverHash, sizeof(m_driverHash), HashShaderDesc(description));
+
+        if (shaderHandle->Cached)
+        {
+            Float64 loadStart = glfwGetTime();
+            Float64 compileSeconds = 0.0;
+
+            shaderHandle->ShaderProgram = LoadCachedProgram(shaderHandle->CacheKey, &compileSeconds);
+
+            if (shaderHandle->ShaderProgram != 0)
+            {
+                Float64 savedSeconds = compileSeconds - (glfwGetTime() - loadStart);
+
+                m_programCacheStatistics.Hits++;
+                m_programCacheStatistics.SavedSeconds += MAX(savedSeconds, 0.0);
+
+                return;
+            }
+
+            m_programCacheStatistics.Misses++;
+        }
+
+        shaderHandle->Compiled = true;
+        shaderHandle->CompileStart = glfwGetTime();
+
+        CompileProgram(description, shaderHandle);
+    }
+
+    bool GraphicsContextOGL::FinishShader(ShaderOGL* shaderHandle)
+    {
+        if (!shaderHandle->Pending)
+            return shaderHandle->Linked;
+
+        shaderHandle->Pending = false;
+
+        // Binaries from cache were already checked by LoadCachedProgram
+        shaderHandle->Linked = true;
+
+        if (shaderHandle->Compiled)
+        {
+            // Query of link status waits for the driver, so compilation is measured up to it
+            // (for asynchronous shaders it's the time until the shader was needed)
+            Int32 linked = GL_FALSE;
+            glGetProgramiv(shaderHandle->ShaderProgram, GL_LINK_STATUS, &linked);
+
+            Float64 compileSeconds = glfwGetTime() - shaderHandle->CompileStart;
+            m_programCacheStatistics.CompileSeconds += compileSeconds;
+
+            glValidateProgram(shaderHandle->ShaderProgram);
+
+            shaderHandle->Linked = linked == GL_TRUE;
+
+            if (shaderHandle->Cached && shaderHandle->Linked)
+                StoreCachedProgram(shaderHandle->CacheKey, shaderHandle->ShaderProgram, compileSeconds);
+        }
+
+        ReflectShader(shaderHandle);
+
+        return shaderHandle->Linked;
+    }
+
+    Shader * GraphicsContextOGL::CreateShader(Shader::Desc description)
+    {
+        ShaderOGL shaderHandle;
+
+        StartShader(description, &shaderHandle);
+
+        if (!FinishShader(&shaderHandle))
+        {
+            glDeleteShader(shaderHandle.VertexShader);
+            glDeleteShader(shaderHandle.GeometryShader);
+            glDeleteShader(shaderHandle.FragmentShader);
+            glDeleteProgram(shaderHandle.ShaderProgram);
+
+            m_debugger->MakeLog("Shader creation is failed. Shader program was not linked", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        auto newShader = reinterpret_cast<Shader*>(m_structAllocator->AllocateMemory(sizeof(Shader)));
+        new (newShader) Shader();
+
+        newShader->SetComponentHandle<ShaderOGL>(&shaderHandle, m_structAllocator);
+
+        m_debugger->MakeLog("Shader was created", LogTypes::InfoLog);
+
+        return newShader;
+    }
+
+    Shader * GraphicsContextOGL::CreateShaderAsync(Shader::Desc description)
+    {
+        ShaderOGL shaderHandle;
+
+        StartShader(description, &shaderHandle);
+
+        auto newShader = reinterpret_cast<Shader*>(m_structAllocator->AllocateMemory(sizeof(Shader)));
+        new (newShader) Shader();
+
+        newShader->SetComponentHandle<ShaderOGL>(&shaderHandle, m_structAllocator);
+
+        m_debugger->MakeLog("Shader compilation was started", LogTypes::InfoLog);
+
+        return newShader;
+    }
+
+    bool GraphicsContextOGL::IsShaderReady(Shader* shader)
+    {
+        if (shader == nullptr || shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Can not check its state", LogTypes::WarningLog);
+            return false;
+        }
+
+        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
+
+        if (!shaderHandle->Pending)
+            return true;
+
+        // Without parallel compilation state can't be checked without waiting, so shader is finished right here
+        if (shaderHandle->Compiled && m_capabilities.ParallelShaderCompile)
+        {
+            Int32 completed = GL_FALSE;
+            glGetProgramiv(shaderHandle->ShaderProgram, GL_COMPLETION_STATUS_KHR, &completed);
+
+            if (completed != GL_TRUE)
+                return false;
+        }
+
+        FinishShader(shaderHandle);
+
+        return true;
+    }
+
+    bool GraphicsContextOGL::IsShaderLinked(Shader* shader)
+    {
+        if (shader == nullptr || shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Can not check its state", LogTypes::WarningLog);
+            return false;
+        }
+
+        return FinishShader(shader->GetComponentHandle<ShaderOGL>());
+    }
+
+    void GraphicsContextOGL::ReleaseShader(Shader *shader)
+    {
+        if (shader == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
+        glDeleteShader(shaderHandle->VertexShader);
+        glDeleteShader(shaderHandle->GeometryShader);
+        glDeleteShader(shaderHandle->FragmentShader);
+
+        glDeleteProgram(shaderHandle->ShaderProgram);
+        ForgetProgram(shaderHandle->ShaderProgram);
+
+        m_debugger->MakeLog("Releasing of shader was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::BindShader(Shader *shader)
+    {
+        if (shader == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Can not bind this shader", LogTypes::WarningLog);
+            return;
+        }
+
+        if (shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Can not bind this shader", LogTypes::WarningLog);
+            return;
+        }
+
+        ShaderOGL* shaderHandle = shader->GetComponentHandle<ShaderOGL>();
+
+        // Asynchronous shader can turn out to be broken only when it's finished
+        if (!FinishShader(shaderHandle))
+        {
+            m_debugger->MakeLog("Shader program was not linked. Can not bind this shader", LogTypes::WarningLog);
+            return;
+        }
+
+        UseProgram(shaderHandle->ShaderProgram);
+
+        m_debugger->MakeLog("Shader's binding was completed", LogTypes::InfoLog);
+    }
+
+    PipelineState* GraphicsContextOGL::CreatePipelineState(PipelineState::Desc description)
+    {
+        if (description.Shader == nullptr || description.Shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Pipeline state creation is failed. Shader is invalid", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        Uint64 hash = HashPipelineDesc(description);
+
+        auto isEmpty = [](PipelineState* state) { return state == nullptr; };
+
+        auto matches = [&](PipelineState* state)
+        {
+            return state->GetHash() == hash && ComparePipelineDescs(state->GetDescription(), description);
+        };
+
+        bool found;
+        Uint64 slot = FindCacheSlot(m_pipelineStates, m_pipelineStatesCount, m_pipelineStatesCapacity,
+                                    isEmpty, matches, found);
+
+        if (found)
+        {
+            PipelineState* state = m_pipelineStates[slot];
+            state->GetComponentHandle<PipelineStateOGL>()->UsersCount++;
+
+            return state;
+        }
+
+        PipelineStateOGL stateHandle = MakePipelineState(description);
+        stateHandle.UsersCount = 1;
+
+        auto newState = reinterpret_cast<PipelineState*>(m_structAllocator->AllocateMemory(sizeof(PipelineState)));
+        new (newState) PipelineState(description, hash);
+
+        newState->SetComponentHandle<PipelineStateOGL>(&stateHandle, m_structAllocator);
+
+        m_pipelineStates[slot] = newState;
+
+        m_debugger->MakeLog("Pipeline state was created correctly", LogTypes::InfoLog);
+
+        return newState;
+    }
+
+    GraphicsContextOGL::PipelineStateOGL GraphicsContextOGL::MakePipelineState(
+            const PipelineState::Desc& description) const
+    {
+        const DepthStencilState& depthStencil = description.DepthStencil;
+        const BlendState& blend = description.Blend;
+        const RasterState& raster = description.Raster;
+
+        PipelineStateOGL stateHandle;
+        SetMemory(&stateHandle, sizeof(stateHandle), 0);
+
+        stateHandle.Flags[ENUM_VALUE(StateFlags::DepthTest)] = depthStencil.DepthTest;
+        stateHandle.Flags[ENUM_VALUE(StateFlags::StencilTest)] = depthStencil.StencilTest;
+        stateHandle.Flags[ENUM_VALUE(StateFlags::Blending)] = blend.Blending;
+        stateHandle.Flags[ENUM_VALUE(StateFlags::FaceCulling)] = raster.CullMode != CullModes::CullNone;
+        stateHandle.Flags[ENUM_VALUE(StateFlags::PolygonOffset)] = raster.DepthBias != 0.0f ||
+                                                                   raster.SlopeDepthBias != 0.0f;
+
+        RenderStateOGL& state = stateHandle.State;
+
+        state.DepthWrite = depthStencil.DepthWrite ? GL_TRUE : GL_FALSE;
+        state.DepthFunction = CompareFunctionsOGL[ENUM_VALUE(depthStencil.DepthFunction)];
+
+        state.StencilFunction = CompareFunctionsOGL[ENUM_VALUE(depthStencil.StencilFunction)];
+        state.StencilReference = depthStencil.StencilReference;
+        state.StencilReadMask = depthStencil.StencilReadMask;
+        state.StencilWriteMask = depthStencil.StencilWriteMask;
+
+        state.StencilFail = StencilOperationsOGL[ENUM_VALUE(depthStencil.StencilFail)];
+        state.StencilDepthFail = StencilOperationsOGL[ENUM_VALUE(depthStencil.DepthFail)];
+        state.StencilPass = StencilOperationsOGL[ENUM_VALUE(depthStencil.StencilPass)];
+
+        state.BlendSourceColor = BlendFactorsOGL[ENUM_VALUE(blend.SourceColor)];
+        state.BlendDestinationColor = BlendFactorsOGL[ENUM_VALUE(blend.DestinationColor)];
+        state.BlendSourceAlpha = BlendFactorsOGL[ENUM_VALUE(blend.SourceAlpha)];
+        state.BlendDestinationAlpha = BlendFactorsOGL[ENUM_VALUE(blend.DestinationAlpha)];
+
+        state.BlendColorOperation = BlendOperationsOGL[ENUM_VALUE(blend.ColorOperation)];
+        state.BlendAlphaOperation = BlendOperationsOGL[ENUM_VALUE(blend.AlphaOperation)];
+
+        state.ColorWriteMask = blend.ColorWriteMask & ColorWriteAll;
+
+        state.CullFace = CullModesOGL[ENUM_VALUE(raster.CullMode)];
+        state.FrontFace = raster.FrontClockwise ? GL_CW : GL_CCW;
+        state.PolygonMode = FillModesOGL[ENUM_VALUE(raster.FillMode)];
+
+        state.SlopeDepthBias = raster.SlopeDepthBias;
+        state.DepthBias = raster.DepthBias;
+
+        return stateHandle;
+    }
+
+    void GraphicsContextOGL::ReleasePipelineState(PipelineState* state)
+    {
+        if (state == nullptr || state->GetComponentHandle<PipelineStateOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Pipeline state is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (--state->GetComponentHandle<PipelineStateOGL>()->UsersCount != 0)
+            return;
+
+        for (Uint64 i = 0; i < m_pipelineStatesCount; i++)
+        {
+            if (m_pipelineStates[i] == state)
+                m_pipelineStates[i] = nullptr;
+        }
+
+        state->~PipelineState();
+        m_structAllocator->FreeMemory(state);
+
+        m_debugger->MakeLog("Releasing of pipeline state was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::BindPipelineState(PipelineState* state)
+    {
+        // Shader is kept, render states are returned to defaults of description
+        if (state == nullptr)
+        {
+            ApplyPipelineState(MakePipelineState(PipelineState::Desc()));
+
+            m_depthBuffer = false;
+            m_stencilBuffer = false;
+
+            return;
+        }
+
+        if (state->GetComponentHandle<PipelineStateOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Pipeline state is invalid. Can not bind it", LogTypes::WarningLog);
+            return;
+        }
+
+        const PipelineStateOGL* stateHandle = state->GetComponentHandle<PipelineStateOGL>();
+
+        BindShader(state->GetDescription().Shader);
+        ApplyPipelineState(*stateHandle);
+
+        // Clearing follows tests of the last bound state, as it does for Enable/Disable calls
+        m_depthBuffer = stateHandle->Flags[ENUM_VALUE(StateFlags::DepthTest)];
+        m_stencilBuffer = stateHandle->Flags[ENUM_VALUE(StateFlags::StencilTest)];
+    }
+
+    void GraphicsContextOGL::BindShaderUniformBuffer(Shader *shader, const char *name,
+                                                     const UniformBuffer *ubo)
+    {
+        BindShaderUniformBuffer(shader, MakeShaderBindingID(name), ubo);
+    }
+
+    void GraphicsContextOGL::BindShaderUniformBuffer(Shader *shader, const char *name, const UniformBuffer *ubo,
+                                                     Uint64 offset, Uint64 size)
+    {
+        BindShaderUniformBuffer(shader, MakeShaderBindingID(name), ubo, offset, size);
+    }
+
+    void GraphicsContextOGL::BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo)
+    {
+        if (ubo == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Can not bind buffer into the shader", LogTypes::WarningLog);
+            return;
+        }
+
+        BindShaderUniformBuffer(shader, binding, ubo, 0, ubo->GetSize());
+    }
+
+    void GraphicsContextOGL::BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                                                     Uint64 offset, Uint64 size)
+    {
+        if (shader == nullptr || shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Can not bind buffer into the shader", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ubo == nullptr || ubo->GetComponentHandle<UniformBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Buffer is invalid. Can not bind buffer into the shader", LogTypes::WarningLog);
+            return;
+        }
+
+        const ShaderBindingOGL* block = FindShaderBinding(shader, binding, ShaderBindingKinds::UniformBlock);
+
+        if (block == nullptr)
+        {
+            m_debugger->MakeLog("Shader has no such uniform block. Can not bind buffer into the shader",
+                                LogTypes::WarningLog);
+            return;
+        }
+
+        UniformBufferOGL* bufferHandle = ubo->GetComponentHandle<UniformBufferOGL>();
+
+        // Binding point of block was assigned at creation, so only the buffer is bound here
+        BindBufferRange(BufferBindings::UniformBinding, block->Slot, *bufferHandle, offset, size);
+
+        m_debugger->MakeLog("Uniform buffer was binded into shader correctly", LogTypes::InfoLog);
+    }
+
+    Texture1D * GraphicsContextOGL::CreateTexture1D(Texture1D::Desc description)
+    {
+        if (description.Width == 0)
+        {
+            m_debugger->MakeLog("Texture creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        Uint32 texture;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            glCreateTextures(GL_TEXTURE_1D, 1, &texture);
+        }
+
+        else
+        {
+            glGenTextures(1, &texture);
+            BindTexture(TextureBindings::Binding1D, texture);
+        }
+
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(description.PixelFormat)];
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+            Uint32 levelsCount = GetMipLevelsCount(pixelFormatOGL, description.Width);
+
+            glTextureStorage1D(texture, levelsCount, storageFormatOGL, description.Width);
+
+            if (description.Pixels != nullptr)
+            {
+                glTextureSubImage1D(texture, 0, 0, description.Width,
+                                    pixelFormatOGL, pixelTypeOGL, description.Pixels);
+
+                if (levelsCount > 1)
+                    glGenerateTextureMipmap(texture);
+            }
+        }
+
+        else
+        {
+            glTexImage1D(GL_TEXTURE_1D, 0, pixelInternalFormatOGL,
+                         description.Width, 0,
+                         pixelFormatOGL, pixelTypeOGL, description.Pixels);
+
+            glGenerateMipmap(GL_TEXTURE_1D);
+        }
+
+        auto newTexture = reinterpret_cast<Texture1D*>(m_structAllocator->AllocateMemory(sizeof(Texture1D)));
+        new (newTexture) Texture1D(m_textureAllocator);
+
+        newTexture->SetPixelFormat(description.PixelFormat);
+        newTexture->SetPixels(description.Pixels, description.Width);
+        TextureOGL textureHandle = {texture, AcquireSampler(description.SamplingInfo)};
+        newTexture->SetComponentHandle<TextureOGL>(&textureHandle, m_structAllocator);
+
+        m_debugger->MakeLog("1D texture was created correctly", LogTypes::InfoLog);
+
+        return newTexture;
+    }
+
+    Texture2D * GraphicsContextOGL::CreateTexture2D(Texture2D::Desc description)
+    {
+        if (description.Width == 0 || description.Height == 0)
+        {
+            m_debugger->MakeLog("Texture creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        Uint32 texture;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+        }
+
+        else
+        {
+            glGenTextures(1, &texture);
+            BindTexture(TextureBindings::Binding2D, texture);
+        }
+
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(description.PixelFormat)];
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+            Uint32 levelsCount = GetMipLevelsCount(pixelFormatOGL, description.Width, description.Height);
+
+            glTextureStorage2D(texture, levelsCount, storageFormatOGL,
+                               description.Width, description.Height);
+
+            if (description.Pixels != nullptr)
+            {
+                glTextureSubImage2D(texture, 0, 0, 0, description.Width, description.Height,
+                                    pixelFormatOGL, pixelTypeOGL, description.Pixels);
+
+                if (levelsCount > 1)
+                    glGenerateTextureMipmap(texture);
+            }
+        }
+
+        else
+        {
+            glTexImage2D(GL_TEXTURE_2D, 0, pixelInternalFormatOGL,
+                         description.Width, description.Height, 0,
+                         pixelFormatOGL, pixelTypeOGL, description.Pixels);
+
+
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        auto newTexture = reinterpret_cast<Texture2D*>(m_structAllocator->AllocateMemory(sizeof(Texture2D)));
+        new (newTexture) Texture2D(m_textureAllocator);
+
+        newTexture->SetPixelFormat(description.PixelFormat);
+        newTexture->SetPixels(description.Pixels, description.Width, description.Height);
+        TextureOGL textureHandle = {texture, AcquireSampler(description.SamplingInfo)};
+        newTexture->SetComponentHandle<TextureOGL>(&textureHandle, m_structAllocator);
+
+        m_debugger->MakeLog("2D texture was created correctly", LogTypes::InfoLog);
+
+        return newTexture;
+    }
+
+    Texture3D * GraphicsContextOGL::CreateTexture3D(Texture3D::Desc description)
+    {
+        if (description.Width == 0 || description.Height == 0 || description.Depth == 0)
+        {
+            m_debugger->MakeLog("Texture creation is failed. Invalid parameters were given", LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        Uint32 texture;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            glCreateTextures(GL_TEXTURE_3D, 1, &texture);
+        }
+
+        else
+        {
+            glGenTextures(1, &texture);
+            BindTexture(TextureBindings::Binding3D, texture);
+        }
+
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(description.PixelFormat)];
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(description.PixelFormat)];
+            Uint32 levelsCount = GetMipLevelsCount(pixelFormatOGL, description.Width, description.Height,
+                                                   description.Depth);
+
+            glTextureStorage3D(texture, levelsCount, storageFormatOGL,
+                               description.Width, description.Height, description.Depth);
+
+            if (description.Pixels != nullptr)
+            {
+                glTextureSubImage3D(texture, 0, 0, 0, 0, description.Width, description.Height, description.Depth,
+                                    pixelFormatOGL, pixelTypeOGL, description.Pixels);
+
+                if (levelsCount > 1)
+                    glGenerateTextureMipmap(texture);
+            }
+        }
+
+        else
+        {
+            glTexImage3D(GL_TEXTURE_3D, 0, pixelInternalFormatOGL,
+                         description.Width, description.Height, description.Depth, 0,
+                         pixelFormatOGL, pixelTypeOGL, description.Pixels);
+
+            glGenerateMipmap(GL_TEXTURE_3D);
+        }
+
+        auto newTexture = reinterpret_cast<Texture3D*>(m_structAllocator->AllocateMemory(sizeof(Texture3D)));
+        new (newTexture) Texture3D(m_textureAllocator);
+
+        newTexture->SetPixelFormat(description.PixelFormat);
+        newTexture->SetPixels(description.Pixels,
+                              description.Width, description.Height, description.Depth);
+        TextureOGL textureHandle = {texture, AcquireSampler(description.SamplingInfo)};
+        newTexture->SetComponentHandle<TextureOGL>(&textureHandle, m_structAllocator);
+
+        m_debugger->MakeLog("3D texture was created correctly", LogTypes::InfoLog);
+
+        return newTexture;
+    }
+
+    void GraphicsContextOGL::OverwriteTexture(Texture1D *texture, Uint64 width, const void *data)
+    {
+        if (texture == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (data == nullptr || width == 0)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(texture->GetPixelFormat())];
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            Uint32 levelsCount = GetMipLevelsCount(pixelFormatOGL, width);
+
+            if (width != texture->Width())
+            {
+                Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+
+                textureHandle->Texture = RecreateTexture(TextureBindings::Binding1D, textureHandle->Texture);
+                glTextureStorage1D(textureHandle->Texture, levelsCount, storageFormatOGL, width);
+            }
+
+            glTextureSubImage1D(textureHandle->Texture, 0, 0, width, pixelFormatOGL, pixelTypeOGL, data);
+
+            if (levelsCount > 1)
+                glGenerateTextureMipmap(textureHandle->Texture);
+        }
+
+        else
+        {
+            BindTexture(TextureBindings::Binding1D, textureHandle->Texture);
+
+            glTexImage1D(GL_TEXTURE_1D, 0, pixelInternalFormatOGL,
+                         width, 0,
+                         pixelFormatOGL, pixelTypeOGL, data);
+            glGenerateMipmap(GL_TEXTURE_1D);
+        }
+
+        texture->SetPixels(data, width);
+    }
+
+    void GraphicsContextOGL::OverwriteTexture(Texture2D *texture, Uint64 width, Uint64 height, const void *data)
+    {
+        if (texture == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (data == nullptr || width == 0 || height == 0)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(texture->GetPixelFormat())];
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            Uint32 levelsCount = GetMipLevelsCount(pixelFormatOGL, width, height);
+
+            if (width != texture->Width() || height != texture->Height())
+            {
+                Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+
+                textureHandle->Texture = RecreateTexture(TextureBindings::Binding2D, textureHandle->Texture);
+                glTextureStorage2D(textureHandle->Texture, levelsCount, storageFormatOGL, width, height);
+            }
+
+            glTextureSubImage2D(textureHandle->Texture, 0, 0, 0, width, height, pixelFormatOGL, pixelTypeOGL, data);
+
+            if (levelsCount > 1)
+                glGenerateTextureMipmap(textureHandle->Texture);
+        }
+
+        else
+        {
+            BindTexture(TextureBindings::Binding2D, textureHandle->Texture);
+
+            glTexImage2D(GL_TEXTURE_2D, 0, pixelInternalFormatOGL,
+                         width, height, 0,
+                         pixelFormatOGL, pixelTypeOGL, data);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        texture->SetPixels(data, width, height);
+
+        m_debugger->MakeLog("Overwriting of 1D texture was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::OverwriteTexture(Texture3D *texture, Uint64 width, Uint64 height, Uint64 depth,
+                                              const void *data)
+    {
+        if (texture == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because texture is invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        if (data == nullptr || width == 0 || height == 0 || depth == 0)
+        {
+            m_debugger->MakeLog("Overwriting texture is failed because data are invalid", LogTypes::WarningLog);
+            return;
+        }
+
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+        Uint32 pixelInternalFormatOGL = PixelInternalFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(texture->GetPixelFormat())];
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            Uint32 levelsCount = GetMipLevelsCount(pixelFormatOGL, width, height, depth);
+
+            if (width != texture->Width() || height != texture->Height() || depth != texture->Depth())
+            {
+                Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(texture->GetPixelFormat())];
+
+                textureHandle->Texture = RecreateTexture(TextureBindings::Binding3D, textureHandle->Texture);
+                glTextureStorage3D(textureHandle->Texture, levelsCount, storageFormatOGL,
+                                   width, height, depth);
+            }
+
+            glTextureSubImage3D(textureHandle->Texture, 0, 0, 0, 0, width, height, depth,
+                                pixelFormatOGL, pixelTypeOGL, data);
+
+            if (levelsCount > 1)
+                glGenerateTextureMipmap(textureHandle->Texture);
+        }
+
+        else
+        {
+            BindTexture(TextureBindings::Binding3D, textureHandle->Texture);
+
+            glTexImage3D(GL_TEXTURE_3D, 0, pixelInternalFormatOGL,
+                         width, height, depth, 0,
+                         pixelFormatOGL, pixelTypeOGL, data);
+            glGenerateMipmap(GL_TEXTURE_3D);
+        }
+
+        texture->SetPixels(data, width, height, depth);
+
+        m_debugger->MakeLog("Overwriting of 2D texture was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::ReleaseTexture(Texture1D *texture)
+    {
+        if (texture == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+        glDeleteTextures(1, &textureHandle->Texture);
+        ForgetTexture(textureHandle->Texture);
+        ReleaseSampler(textureHandle->Sampler);
+
+        texture->~Texture1D();
+        m_structAllocator->FreeMemory(texture);
+
+        m_debugger->MakeLog("Releasing of 1D texture was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::ReleaseTexture(Texture2D *texture)
+    {
+        if (texture == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+        glDeleteTextures(1, &textureHandle->Texture);
+        ForgetTexture(textureHandle->Texture);
+        ReleaseSampler(textureHandle->Sampler);
+
+        texture->~Texture2D();
+        m_structAllocator->FreeMemory(texture);
+
+        m_debugger->MakeLog("Releasing of 2D texture was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::ReleaseTexture(Texture3D *texture)
+    {
+        if (texture == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        if (texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+        glDeleteTextures(1, &textureHandle->Texture);
+        ForgetTexture(textureHandle->Texture);
+        ReleaseSampler(textureHandle->Sampler);
+
+        texture->~Texture3D();
+        m_structAllocator->FreeMemory(texture);
+
+        m_debugger->MakeLog("Releasing of 3D texture was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::SetTextureSampling(Texture1D* texture, const SamplingInfo& samplingInfo)
+    {
+        if (texture == nullptr || texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Sampling can not be changed", LogTypes::WarningLog);
+            return;
+        }
+
+        // New sampler is taken first, so the same sampling doesn't make its sampler again
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+        Uint64 oldSampler = textureHandle->Sampler;
+
+        textureHandle->Sampler = AcquireSampler(samplingInfo);
+        ReleaseSampler(oldSampler);
+    }
+
+    void GraphicsContextOGL::SetTextureSampling(Texture2D* texture, const SamplingInfo& samplingInfo)
+    {
+        if (texture == nullptr || texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Sampling can not be changed", LogTypes::WarningLog);
+            return;
+        }
+
+        // New sampler is taken first, so the same sampling doesn't make its sampler again
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+        Uint64 oldSampler = textureHandle->Sampler;
+
+        textureHandle->Sampler = AcquireSampler(samplingInfo);
+        ReleaseSampler(oldSampler);
+    }
+
+    void GraphicsContextOGL::SetTextureSampling(Texture3D* texture, const SamplingInfo& samplingInfo)
+    {
+        if (texture == nullptr || texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Sampling can not be changed", LogTypes::WarningLog);
+            return;
+        }
+
+        // New sampler is taken first, so the same sampling doesn't make its sampler again
+        TextureOGL* textureHandle = texture->GetComponentHandle<TextureOGL>();
+        Uint64 oldSampler = textureHandle->Sampler;
+
+        textureHandle->Sampler = AcquireSampler(samplingInfo);
+        ReleaseSampler(oldSampler);
+    }
+
+    Texture2D* GraphicsContextOGL::CreateAttachmentTexture(Uint32 width, Uint32 height, PixelFormats pixelFormat,
+                                                           const SamplingInfo& samplingInfo)
+    {
+        Uint32 pixelFormatOGL = PixelFormatsOGL[ENUM_VALUE(pixelFormat)];
+        Uint32 storageFormatOGL = PixelStorageFormatsOGL[ENUM_VALUE(pixelFormat)];
+        Uint32 pixelTypeOGL = PixelTypesOGL[ENUM_VALUE(pixelFormat)];
+
+        Uint32 texture;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+            glTextureStorage2D(texture, 1, storageFormatOGL, width, height);
+        }
+
+        else
+        {
+            glGenTextures(1, &texture);
+            BindTexture(TextureBindings::Binding2D, texture);
+
+            // Mutable texture is complete for mipmap filters of sampler only when it has no more levels
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+            glTexImage2D(GL_TEXTURE_2D, 0, storageFormatOGL, width, height, 0, pixelFormatOGL, pixelTypeOGL, nullptr);
+        }
+
+        auto newTexture = reinterpret_cast<Texture2D*>(m_structAllocator->AllocateMemory(sizeof(Texture2D)));
+        new (newTexture) Texture2D(m_textureAllocator);
+
+        newTexture->SetPixelFormat(pixelFormat);
+        newTexture->SetPixels(nullptr, width, height);
+
+        TextureOGL textureHandle = {texture, AcquireSampler(samplingInfo)};
+        newTexture->SetComponentHandle<TextureOGL>(&textureHandle, m_structAllocator);
+
+        return newTexture;
+    }
+
+    void GraphicsContextOGL::AttachFramebufferTexture(Uint32 framebuffer, Uint32 attachment,
+                                                      const Texture2D* texture)
+    {
+        Uint32 textureOGL = texture->GetComponentHandle<TextureOGL>()->Texture;
+
+        if (m_capabilities.DirectStateAccess)
+            glNamedFramebufferTexture(framebuffer, attachment, textureOGL, 0);
+        else
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, textureOGL, 0);
+    }
+
+    RenderTarget* GraphicsContextOGL::CreateRenderTarget(RenderTarget::Desc description)
+    {
+        if (description.Width == 0 || description.Height == 0)
+        {
+            m_debugger->MakeLog("Render target creation is failed. Invalid parameters were given",
+                                LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        if (description.ColorAttachmentsCount > m_capabilities.MaxColorAttachments)
+        {
+            m_debugger->MakeLog("Render target creation is failed. Driver doesn't support so many color attachments",
+                                LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        bool depthFormat = description.DepthFormat == PixelFormats::PixelDepth16 ||
+                           description.DepthFormat == PixelFormats::PixelDepth24 ||
+                           description.DepthFormat == PixelFormats::PixelDepth32;
+
+        if (description.DepthAttachment && !description.StencilAttachment && !depthFormat)
+        {
+            m_debugger->MakeLog("Render target creation is failed. Depth attachment needs depth format",
+                                LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        // Without direct state access framebuffer is made through the binding, the old one is bound back then
+        Uint32 boundFramebuffer = m_state.Framebuffer;
+        Uint32 framebuffer;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            glCreateFramebuffers(1, &framebuffer);
+        }
+
+        else
+        {
+            glGenFramebuffers(1, &framebuffer);
+            BindFramebuffer(framebuffer);
+        }
+
+        auto newTarget = reinterpret_cast<RenderTarget*>(m_structAllocator->AllocateMemory(sizeof(RenderTarget)));
+        new (newTarget) RenderTarget(description.Width, description.Height);
+
+        Uint32 drawBuffers[RenderTarget::MaxColorAttachments];
+
+        for (Uint64 i = 0; i < description.ColorAttachmentsCount; i++)
+        {
+            Texture2D* texture = CreateAttachmentTexture(description.Width, description.Height,
+                                                         description.ColorFormats[i], description.SamplingInfo);
+
+            drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+
+            AttachFramebufferTexture(framebuffer, drawBuffers[i], texture);
+            newTarget->AttachColorTexture(texture);
+        }
+
+        if (description.DepthAttachment || description.StencilAttachment)
+        {
+            PixelFormats pixelFormat = description.StencilAttachment ? PixelFormats::PixelDepth24Stencil8 :
+                                       description.DepthFormat;
+            Uint32 attachment = description.StencilAttachment ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+
+            Texture2D* texture = CreateAttachmentTexture(description.Width, description.Height,
+                                                         pixelFormat, description.SamplingInfo);
+
+            AttachFramebufferTexture(framebuffer, attachment, texture);
+
+            if (description.DepthAttachment)
+                newTarget->AttachDepthTexture(texture);
+
+            if (description.StencilAttachment)
+                newTarget->AttachStencilTexture(texture);
+        }
+
+        // Framebuffer without color attachments must not draw into them nor read from them
+        Uint32 colorCount = static_cast<Uint32>(description.ColorAttachmentsCount);
+        Uint32 status;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            if (colorCount != 0)
+            {
+                glNamedFramebufferDrawBuffers(framebuffer, colorCount, drawBuffers);
+            }
+
+            else
+            {
+                glNamedFramebufferDrawBuffer(framebuffer, GL_NONE);
+                glNamedFramebufferReadBuffer(framebuffer, GL_NONE);
+            }
+
+            status = glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER);
+        }
+
+        else
+        {
+            if (colorCount != 0)
+            {
+                glDrawBuffers(colorCount, drawBuffers);
+            }
+
+            else
+            {
+                glDrawBuffer(GL_NONE);
+                glReadBuffer(GL_NONE);
+            }
+
+            status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+            if (boundFramebuffer != UnknownStateOGL)
+                BindFramebuffer(boundFramebuffer);
+        }
+
+        RenderTargetOGL targetHandle = {framebuffer};
+        newTarget->SetComponentHandle<RenderTargetOGL>(&targetHandle, m_structAllocator);
+
+        // Formats which can't be drawn into are found out only by the driver
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            ReleaseRenderTarget(newTarget);
+
+            m_debugger->MakeLog("Render target creation is failed. Framebuffer isn't complete with these formats",
+                                LogTypes::WarningLog);
+            return nullptr;
+        }
+
+        m_debugger->MakeLog("Render target was created correctly", LogTypes::InfoLog);
+
+        return newTarget;
+    }
+
+    void GraphicsContextOGL::ReleaseRenderTarget(RenderTarget* renderTarget)
+    {
+        if (renderTarget == nullptr || renderTarget->GetComponentHandle<RenderTargetOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Render target is invalid. Deleting can not be done", LogTypes::WarningLog);
+            return;
+        }
+
+        RenderTargetOGL* targetHandle = renderTarget->GetComponentHandle<RenderTargetOGL>();
+        glDeleteFramebuffers(1, &targetHandle->Framebuffer);
+        ForgetFramebuffer(targetHandle->Framebuffer);
+
+        for (Uint64 i = 0; i < renderTarget->GetUsedColorTextures(); i++)
+            ReleaseTexture(renderTarget->GetColorTexture(i));
+
+        // Depth and stencil are one texture when both of them are used
+        Texture2D* depthTexture = renderTarget->GetDepthTexture();
+        Texture2D* stencilTexture = renderTarget->GetStencilTexture();
+
+        if (depthTexture != nullptr)
+            ReleaseTexture(depthTexture);
+
+        if (stencilTexture != nullptr && stencilTexture != depthTexture)
+            ReleaseTexture(stencilTexture);
+
+        renderTarget->~RenderTarget();
+        m_structAllocator->FreeMemory(renderTarget);
+
+        m_debugger->MakeLog("Releasing of render target was completed", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::BindShaderTexture(Shader *shader, const char *name, const Texture1D *texture)
+    {
+        BindShaderTexture(shader, MakeShaderBindingID(name), texture);
+    }
+
+    void GraphicsContextOGL::BindShaderTexture(Shader *shader, const char *name, const Texture2D *texture)
+    {
+        BindShaderTexture(shader, MakeShaderBindingID(name), texture);
+    }
+
+    void GraphicsContextOGL::BindShaderTexture(Shader *shader, const char *name, const Texture3D *texture)
+    {
+        BindShaderTexture(shader, MakeShaderBindingID(name), texture);
+    }
+
+    void GraphicsContextOGL::BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture1D* texture)
+    {
+        if (texture == nullptr || texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
+            return;
+        }
+
+        if (!BindShaderTexture(shader, binding, TextureBindings::Binding1D, *texture->GetComponentHandle<TextureOGL>()))
+            return;
+
+        m_debugger->MakeLog("1D texture was binded into shader correctly", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture2D* texture)
+    {
+        if (texture == nullptr || texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
+            return;
+        }
+
+        if (!BindShaderTexture(shader, binding, TextureBindings::Binding2D, *texture->GetComponentHandle<TextureOGL>()))
+            return;
+
+        m_debugger->MakeLog("2D texture was binded into shader correctly", LogTypes::InfoLog);
+    }
+
+    void GraphicsContextOGL::BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture3D* texture)
+    {
+        if (texture == nullptr || texture->GetComponentHandle<TextureOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Texture is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
+            return;
+        }
+
+        if (!BindShaderTexture(shader, binding, TextureBindings::Binding3D, *texture->GetComponentHandle<TextureOGL>()))
+            return;
+
+        m_debugger->MakeLog("3D texture was binded into shader correctly", LogTypes::InfoLog);
+    }
+
+    bool GraphicsContextOGL::BindShaderTexture(Shader* shader, ShaderBindingID binding, TextureBindings target,
+                                               const TextureOGL& texture)
+    {
+        if (shader == nullptr || shader->GetComponentHandle<ShaderOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Shader is invalid. Can not bind texture into the shader", LogTypes::WarningLog);
+            return false;
+        }
+
+        const ShaderBindingOGL* sampler = FindShaderBinding(shader, binding, ShaderBindingKinds::Sampler);
+
+        if (sampler == nullptr)
+        {
+            m_debugger->MakeLog("Shader has no such sampler. Can not bind texture into the shader",
+                                LogTypes::WarningLog);
+            return false;
+        }
+
+        // Sampler uniform was set to its unit at creation, so only the texture and its sampler are bound here
+        BindTexture(sampler->Slot, target, texture.Texture);
+        BindSampler(sampler->Slot, m_samplers[texture.Sampler].Sampler);
+        return true;
+    }
+
+    void GraphicsContextOGL::Draw(PrimitiveToplogies topology, VertexBuffer *vbo)
+    {
+        if (vbo == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+
+        BindVertexBuffer(bufferHandle);
+        glDrawArrays(primitive, 0, vbo->GetVertexCount());
+    }
+
+    void GraphicsContextOGL::DrawIndexed(PrimitiveToplogies topology, VertexBuffer *vbo, IndexBuffer *ibo)
+    {
+        if (vbo == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo == nullptr)
+        {
+            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
+            return;
+        }
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        IndexBufferOGL* indexBufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+
+        Uint32 indexType = IndexTypesOGL[ENUM_VALUE(ibo->GetIndexType())];
+        Uint64 indexSize = IndexBuffer::GetIndexSize(ibo->GetIndexType());
+
+        BindVertexBuffer(bufferHandle);
+        BindBuffer(BufferBindings::ElementBinding, *indexBufferHandle);
+
+        if (ibo->GetRangesCount() == 0)
+            glDrawElements(primitive, ibo->GetIndexCount(), indexType, nullptr);
+
+        for (Uint64 i = 0; i < ibo->GetRangesCount(); i++)
+        {
+            const IndexBuffer::Range& range = ibo->GetRanges()[i];
+
+            glDrawElementsBaseVertex(primitive, range.IndexCount, indexType,
+                                     reinterpret_cast<const void*>(range.FirstIndex * indexSize), range.BaseVertex);
+        }
+    }
+
+    void GraphicsContextOGL::DrawIndexedRanges(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                               const IndexBuffer::Range* ranges, Uint64 rangesCount)
+    {
+        if (vbo == nullptr || vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo == nullptr || ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ranges == nullptr || rangesCount == 0)
+            return;
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        IndexBufferOGL* indexBufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+
+        Uint32 indexType = IndexTypesOGL[ENUM_VALUE(ibo->GetIndexType())];
+        Uint64 indexSize = IndexBuffer::GetIndexSize(ibo->GetIndexType());
+
+        BindVertexBuffer(bufferHandle);
+        BindBuffer(BufferBindings::ElementBinding, *indexBufferHandle);
+
+        // Ranges are drawn by batches with one call per batch
+        static const Uint64 BatchSize = 64;
+
+        GLsizei counts[BatchSize];
+        const void* offsets[BatchSize];
+        GLint baseVertices[BatchSize];
+        Uint64 batched = 0;
+
+        // Buffer split into 16-bit ranges (see IndexBuffer::Desc::NarrowIndices) adds base vertex of its ranges
+        IndexBuffer::Range whole = {0, ibo->GetIndexCount(), 0};
+
+        const IndexBuffer::Range* bufferRanges = (ibo->GetRangesCount() != 0) ? ibo->GetRanges() : &whole;
+        Uint64 bufferRangesCount = MAX(ibo->GetRangesCount(), 1);
+
+        for (Uint64 i = 0; i < rangesCount; i++)
+        {
+            for (Uint64 j = 0; j < bufferRangesCount; j++)
+            {
+                Uint64 first = MAX(ranges[i].FirstIndex, bufferRanges[j].FirstIndex);
+                Uint64 last = MIN(ranges[i].FirstIndex + ranges[i].IndexCount,
+                                  bufferRanges[j].FirstIndex + bufferRanges[j].IndexCount);
+
+                if (first >= last)
+                    continue;
+
+                counts[batched] = static_cast<GLsizei>(last - first);
+                offsets[batched] = reinterpret_cast<const void*>(first * indexSize);
+                baseVertices[batched] = static_cast<GLint>(ranges[i].BaseVertex + bufferRanges[j].BaseVertex);
+                batched++;
+
+                if (batched == BatchSize)
+                {
+                    glMultiDrawElementsBaseVertex(primitive, counts, indexType, offsets, batched, baseVertices);
+                    batched = 0;
+                }
+            }
+        }
+
+        if (batched != 0)
+            glMultiDrawElementsBaseVertex(primitive, counts, indexType, offsets, batched, baseVertices);
+    }
+
+    Uint64 GraphicsContextOGL::AcquireVertexFormat(const VertexBufferOGL& buffer)
+    {
+        // Stride isn't a part of format, it's given when buffer is bound
+        Uint64 hash = HashMemory(buffer.Attributes, buffer.AttributesCount * sizeof(VertexAttributeOGL),
+                                 buffer.AttributesCount);
+
+        auto isEmpty = [](const VertexFormatOGL& format) { return format.UsersCount == 0; };
+
+        // Attributes are compared by fields, their padding is zeroed only in handles of buffers
+        auto matches = [&](const VertexFormatOGL& format)
+        {
+            if (format.Hash != hash || format.AttributesCount != buffer.AttributesCount)
+                return false;
+
+            for (Uint64 i = 0; i < buffer.AttributesCount; i++)
+            {
+                const VertexAttributeOGL& first = format.Attributes[i];
+                const VertexAttributeOGL& second = buffer.Attributes[i];
+
+                if (first.Count != second.Count || first.Type != second.Type || first.Normalized != second.Normalized)
+                    return false;
+
+                if (first.Divisor != second.Divisor || first.Offset != second.Offset)
+                    return false;
+            }
+
+            return true;
+        };
+
+        bool found;
+        Uint64 format = FindCacheSlot(m_vertexFormats, m_vertexFormatsCount, m_vertexFormatsCapacity,
+                                      isEmpty, matches, found);
+
+        if (found)
+        {
+            m_vertexFormats[format].UsersCount++;
+            return format;
+        }
+
+        VertexFormatOGL& newFormat = m_vertexFormats[format];
+
+        newFormat.Hash = hash;
+        newFormat.VertexArray = CreateVertexFormat(buffer);
+        newFormat.UsersCount = 1;
+        newFormat.BoundBuffer = UnknownStateOGL;
+
+        newFormat.AttributesCount = buffer.AttributesCount;
+        CopyMemory(newFormat.Attributes, buffer.Attributes, buffer.AttributesCount * sizeof(VertexAttributeOGL));
+
+        return format;
+    }
+
+    void GraphicsContextOGL::ReleaseVertexFormat(Uint64 format)
+    {
+        VertexFormatOGL& vertexFormat = m_vertexFormats[format];
+
+        if (--vertexFormat.UsersCount != 0)
+            return;
+
+        glDeleteVertexArrays(1, &vertexFormat.VertexArray);
+        ForgetVertexArray(vertexFormat.VertexArray);
+
+        vertexFormat.Hash = 0;
+        vertexFormat.VertexArray = 0;
+        vertexFormat.UsersCount = 0;
+        vertexFormat.BoundBuffer = UnknownStateOGL;
+        vertexFormat.AttributesCount = 0;
+    }
+
+    Uint32 GraphicsContextOGL::CreateVertexFormat(const VertexBufferOGL& buffer)
+    {
+        Uint32 vao;
+
+        if (m_capabilities.DirectStateAccess)
+        {
+            glCreateVertexArrays(1, &vao);
+        }
+
+        else
+        {
+            glGenVertexArrays(1, &vao);
+            BindVertexArray(vao);
+        }
+
+        // Attributes which step per vertex share binding of the first of them and differ by relative offset,
+        // attributes with instance step rate get binding of their own index for the divisor.
+        // So bindings are below the count of attributes and instance streams can be attached after them
+        Uint32 vertexBinding = UnknownStateOGL;
+
+        for (Uint32 i = 0; i < buffer.AttributesCount; i++)
+        {
+            const VertexAttributeOGL& attribute = buffer.Attributes[i];
+
+            Uint32 binding = i;
+            Uint32 relativeOffset = 0;
+
+            if (attribute.Divisor == 0)
+            {
+                if (vertexBinding == UnknownStateOGL)
+                    vertexBinding = i;
+
+                binding = vertexBinding;
+                relativeOffset = attribute.Offset;
+            }
+
+            if (m_capabilities.DirectStateAccess)
+            {
+                glEnableVertexArrayAttrib(vao, i);
+                glVertexArrayAttribFormat(vao, i, attribute.Count, attribute.Type, attribute.Normalized,
+                                          relativeOffset);
+                glVertexArrayAttribBinding(vao, i, binding);
+
+                if (attribute.Divisor != 0)
+                    glVertexArrayBindingDivisor(vao, binding, attribute.Divisor);
+            }
+
+            else
+            {
+                glEnableVertexAttribArray(i);
+                glVertexAttribFormat(i, attribute.Count, attribute.Type, attribute.Normalized, relativeOffset);
+                glVertexAttribBinding(i, binding);
+
+                if (attribute.Divisor != 0)
+                    glVertexBindingDivisor(binding, attribute.Divisor);
+            }
+        }
+
+        return vao;
+    }
+
+    Uint32 GraphicsContextOGL::CreateVertexArray(const VertexBufferOGL& buffer)
+    {
+        Uint32 vao;
+        glGenVertexArrays(1, &vao);
+
+        BindVertexArray(vao);
+        BindBuffer(BufferBindings::ArrayBinding, buffer.VertexBuffer);
+
+        for (Uint32 i = 0; i < buffer.AttributesCount; i++)
+        {
+            const VertexAttributeOGL& attribute = buffer.Attributes[i];
+
+            glEnableVertexAttribArray(i);
+            glVertexAttribPointer(i, attribute.Count, attribute.Type, attribute.Normalized, buffer.Stride,
+                                  reinterpret_cast<const void*>(attribute.Offset));
+
+            if (attribute.Divisor != 0)
+                glVertexAttribDivisor(i, attribute.Divisor);
+        }
+
+        return vao;
+    }
+
+    void GraphicsContextOGL::BindVertexBuffer(const VertexBufferOGL* buffer)
+    {
+        BindVertexArray(buffer->VertexArray);
+
+        if (buffer->VertexPulling)
+        {
+            BindBufferRange(BufferBindings::StorageBinding, VertexPullingBinding, buffer->VertexBuffer, 0, 0);
+            return;
+        }
+
+        if (!m_capabilities.VertexAttribBinding)
+            return;
+
+        VertexFormatOGL& format = m_vertexFormats[buffer->VertexFormat];
+
+        if (format.BoundBuffer == buffer->VertexBuffer)
+        {
+            m_frameStatistics.SkippedCalls++;
+            return;
+        }
+
+        // Bindings are the same as in CreateVertexFormat
+        bool vertexBinding = false;
+
+        for (Uint32 i = 0; i < buffer->AttributesCount; i++)
+        {
+            const VertexAttributeOGL& attribute = buffer->Attributes[i];
+
+            if (attribute.Divisor != 0)
+            {
+                glBindVertexBuffer(i, buffer->VertexBuffer, attribute.Offset, buffer->Stride);
+                m_frameStatistics.IssuedCalls++;
+            }
+
+            else if (!vertexBinding)
+            {
+                glBindVertexBuffer(i, buffer->VertexBuffer, 0, buffer->Stride);
+                m_frameStatistics.IssuedCalls++;
+
+                vertexBinding = true;
+            }
+        }
+
+        format.BoundBuffer = buffer->VertexBuffer;
+    }
+
+    void GraphicsContextOGL::AttachInstanceStream(const VertexBufferOGL* mesh, const VertexBufferOGL* instances)
+    {
+        BindBuffer(BufferBindings::ArrayBinding, instances->VertexBuffer);
+
+        for (Uint64 i = 0; i < instances->AttributesCount; i++)
+        {
+            const VertexAttributeOGL& attribute = instances->Attributes[i];
+            Uint32 location = mesh->AttributesCount + i;
+
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, attribute.Count, attribute.Type, attribute.Normalized, instances->Stride,
+                                  reinterpret_cast<const void*>(attribute.Offset));
+            glVertexAttribDivisor(location, MAX(attribute.Divisor, 1));
+        }
+    }
+
+    void GraphicsContextOGL::DetachInstanceStream(const VertexBufferOGL* mesh, const VertexBufferOGL* instances)
+    {
+        // VAO of the mesh is left as it was for non-instanced draws
+        for (Uint64 i = 0; i < instances->AttributesCount; i++)
+        {
+            Uint32 location = mesh->AttributesCount + i;
+
+            glVertexAttribDivisor(location, 0);
+            glDisableVertexAttribArray(location);
+        }
+    }
+
+    void GraphicsContextOGL::DrawInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, VertexBuffer* instances,
+                                           Uint64 instanceCount)
+    {
+        if (vbo == nullptr || vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (instances != nullptr && instances->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Instance buffer is invalid. Can not draw instances", LogTypes::WarningLog);
+            return;
+        }
+
+        if (instanceCount == 0)
+            return;
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        VertexBufferOGL* instanceHandle = (instances != nullptr) ? instances->GetComponentHandle<VertexBufferOGL>()
+                                                                 : nullptr;
+
+        Uint64 attributesCount = bufferHandle->AttributesCount;
+        attributesCount += (instanceHandle != nullptr) ? instanceHandle->AttributesCount : 0;
+
+        if (attributesCount > MaxVertexElements)
+        {
+            m_debugger->MakeLog("Too many vertex attributes. Can not draw instances", LogTypes::WarningLog);
+            return;
+        }
+
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+
+        BindVertexBuffer(bufferHandle);
+
+        if (instanceHandle != nullptr)
+            AttachInstanceStream(bufferHandle, instanceHandle);
+
+        glDrawArraysInstanced(primitive, 0, vbo->GetVertexCount(), instanceCount);
+
+        if (instanceHandle != nullptr)
+            DetachInstanceStream(bufferHandle, instanceHandle);
+    }
+
+    void GraphicsContextOGL::DrawIndexedInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                                  VertexBuffer* instances, Uint64 instanceCount)
+    {
+        if (vbo == nullptr || vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo == nullptr || ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
+            return;
+        }
+
+        if (instances != nullptr && instances->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Instance buffer is invalid. Can not draw instances", LogTypes::WarningLog);
+            return;
+        }
+
+        if (instanceCount == 0)
+            return;
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        VertexBufferOGL* instanceHandle = (instances != nullptr) ? instances->GetComponentHandle<VertexBufferOGL>()
+                                                                 : nullptr;
+
+        Uint64 attributesCount = bufferHandle->AttributesCount;
+        attributesCount += (instanceHandle != nullptr) ? instanceHandle->AttributesCount : 0;
+
+        if (attributesCount > MaxVertexElements)
+        {
+            m_debugger->MakeLog("Too many vertex attributes. Can not draw instances", LogTypes::WarningLog);
+            return;
+        }
+
+        IndexBufferOGL* indexBufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+
+        Uint32 indexType = IndexTypesOGL[ENUM_VALUE(ibo->GetIndexType())];
+        Uint64 indexSize = IndexBuffer::GetIndexSize(ibo->GetIndexType());
+
+        BindVertexBuffer(bufferHandle);
+        BindBuffer(BufferBindings::ElementBinding, *indexBufferHandle);
+
+        if (instanceHandle != nullptr)
+            AttachInstanceStream(bufferHandle, instanceHandle);
+
+        if (ibo->GetRangesCount() == 0)
+            glDrawElementsInstanced(primitive, ibo->GetIndexCount(), indexType, nullptr, instanceCount);
+
+        for (Uint64 i = 0; i < ibo->GetRangesCount(); i++)
+        {
+            const IndexBuffer::Range& range = ibo->GetRanges()[i];
+
+            glDrawElementsInstancedBaseVertex(primitive, range.IndexCount, indexType,
+                                              reinterpret_cast<const void*>(range.FirstIndex * indexSize),
+                                              instanceCount, range.BaseVertex);
+        }
+
+        if (instanceHandle != nullptr)
+            DetachInstanceStream(bufferHandle, instanceHandle);
+    }
+
+    void GraphicsContextOGL::DrawIndexedIndirect(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                                 IndirectBuffer* commands, Uint64 firstCommand, Uint64 commandCount)
+    {
+        if (vbo == nullptr || vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo == nullptr || ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
+            return;
+        }
+
+        if (commands == nullptr || commands->GetComponentHandle<IndirectBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Indirect buffer is invalid. Can not draw geometry by commands", LogTypes::WarningLog);
+            return;
+        }
+
+        if (firstCommand + commandCount > commands->GetCommandCount())
+        {
+            m_debugger->MakeLog("Indirect buffer has fewer commands than given. Can not draw geometry",
+                                LogTypes::WarningLog);
+            return;
+        }
+
+        // Commands of split buffer need base vertices of its ranges, plain commands would draw 16-bit
+        // indices of every range from the first vertex
+        if (ibo->GetRangesCount() != 0 && !commands->HasSplitRanges())
+        {
+            m_debugger->MakeLog("Index buffer was split into ranges, but commands weren't made for them. "
+                                "Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (commandCount == 0)
+            return;
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        IndexBufferOGL* indexBufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+        IndirectBufferOGL* commandsHandle = commands->GetComponentHandle<IndirectBufferOGL>();
+
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+        Uint32 indexType = IndexTypesOGL[ENUM_VALUE(ibo->GetIndexType())];
+
+        BindVertexBuffer(bufferHandle);
+        BindBuffer(BufferBindings::ElementBinding, *indexBufferHandle);
+        BindBuffer(BufferBindings::IndirectBinding, *commandsHandle);
+
+        glMultiDrawElementsIndirect(primitive, indexType,
+                                    reinterpret_cast<const void*>(firstCommand * sizeof(DrawIndexedCommand)),
+                                    commandCount, sizeof(DrawIndexedCommand));
+    }
+
+    void GraphicsContextOGL::DrawCulledIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                               CullingBatch* batch)
+    {
+        if (vbo == nullptr || vbo->GetComponentHandle<VertexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Vertex buffer is invalid. Can not draw geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        if (ibo == nullptr || ibo->GetComponentHandle<IndexBufferOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Index buffer is invalid. Can not draw geometry by indices", LogTypes::WarningLog);
+            return;
+        }
+
+        if (batch == nullptr || batch->GetComponentHandle<CullingBatchOGL>() == nullptr)
+        {
+            m_debugger->MakeLog("Batch is invalid. Can not draw culled geometry", LogTypes::WarningLog);
+            return;
+        }
+
+        // Commands of culled objects don't know ranges of split buffer
+        if (ibo->GetRangesCount() != 0)
+        {
+            m_debugger->MakeLog("Index buffer was split into ranges. Can not draw culled geometry",
+                                LogTypes::WarningLog);
+            return;
+        }
+
+        VertexBufferOGL* bufferHandle = vbo->GetComponentHandle<VertexBufferOGL>();
+        IndexBufferOGL* indexBufferHandle = ibo->GetComponentHandle<IndexBufferOGL>();
+        CullingBatchOGL* batchHandle = batch->GetComponentHandle<CullingBatchOGL>();
+
+        Uint32 primitive = PrimitiveTopologiesOGL[ENUM_VALUE(topology)];
+        Uint32 indexType = IndexTypesOGL[ENUM_VALUE(ibo->GetIndexType())];
+        Uint64 objectCount = batch->GetObjectCount();
+
+        BindVertexBuffer(bufferHandle);
+        BindBuffer(BufferBindings::ElementBinding, *indexBufferHandle);
+        BindBuffer(BufferBindings::IndirectBinding, batchHandle->VisibleBuffer);
+
+        // Without indirect count all of the commands are drawn, culled ones have zero instances
+        if (m_capabilities.IndirectCount)
+        {
+            BindBuffer(BufferBindings::ParameterBinding, batchHandle->CountBuffer);
+
+            if (m_capabilities.IndirectCountCore)
+                glMultiDrawElementsIndirectCount(primitive, indexType, nullptr, 0, objectCount,
+                                                 sizeof(DrawIndexedCommand));
+            else
+                glMultiDrawElementsIndirectCountARB(primitive, indexType, nullptr, 0, objectCount,
+                                                    sizeof(DrawIndexedCommand));
+        }
+
+        else
+            glMultiDrawElementsIndirect(primitive, indexType, nullptr, objectCount, sizeof(DrawIndexedCommand));
+    }
+}
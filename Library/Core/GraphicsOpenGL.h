@@ -1,203 +1,783 @@
-#pragma once
-
-#include "Graphics.h"
-
-namespace Tiny3D
-{
-    class GraphicsContextOGL : public GraphicsContext
-    {
-    private:
-        const Uint32 TypeQualifiersOGL[8] = {
-                GL_UNSIGNED_BYTE, GL_BYTE,
-                GL_UNSIGNED_SHORT, GL_SHORT,
-                GL_UNSIGNED_INT, GL_INT,
-                GL_FLOAT, GL_DOUBLE,
-        };
-
-        const Uint64 TypeSizesOGL[8] = {
-                1, 1,
-                2, 2,
-                4, 4,
-                4, 8,
-        };
-
-        const Uint32 BufferUsagesOGL[3] = {
-                GL_STATIC_DRAW,
-                GL_STREAM_DRAW,
-                GL_DYNAMIC_DRAW,
-        };
-
-        const Uint32 PixelFormatsOGL[18] = {
-                GL_RGBA, GL_RGB,
-                GL_RGBA, GL_RGB,
-                GL_RGBA_INTEGER, GL_RGB_INTEGER,
-                GL_RGBA_INTEGER, GL_RGB_INTEGER,
-                GL_RGBA_INTEGER, GL_RGB_INTEGER,
-                GL_RGBA_INTEGER, GL_RGB_INTEGER,
-                GL_RGBA, GL_RGB,
-
-                GL_DEPTH_COMPONENT,
-                GL_DEPTH_COMPONENT,
-                GL_DEPTH_COMPONENT,
-                GL_STENCIL_INDEX,
-        };
-
-        // TODO: read about how to properly use internal formats and fix it
-        const Uint32 PixelInternalFormatsOGL[18] = {
-                GL_RGBA, GL_RGB,
-                GL_RGBA, GL_RGB,
-
-                GL_RGBA, GL_RGB,
-                GL_RGBA, GL_RGB,
-
-                GL_RGBA, GL_RGB,
-                GL_RGBA, GL_RGB,
-                GL_RGBA, GL_RGB,
-
-                GL_DEPTH_COMPONENT16,
-                GL_DEPTH_COMPONENT24,
-                GL_DEPTH_COMPONENT32,
-                GL_STENCIL_INDEX8,
-        };
-
-        const Uint32 PixelTypesOGL[18] = {
-                GL_UNSIGNED_BYTE, GL_UNSIGNED_BYTE,
-                GL_BYTE, GL_BYTE,
-
-                GL_UNSIGNED_SHORT, GL_UNSIGNED_SHORT,
-                GL_SHORT, GL_SHORT,
-
-                GL_UNSIGNED_INT, GL_UNSIGNED_INT,
-                GL_INT, GL_INT,
-                GL_FLOAT, GL_FLOAT,
-
-                GL_FLOAT, GL_FLOAT, GL_FLOAT,
-                GL_UNSIGNED_BYTE,
-        };
-
-        const Uint32 TextureAddressModesOGL[4] = {
-                GL_REPEAT,
-                GL_MIRRORED_REPEAT,
-                GL_CLAMP_TO_EDGE,
-                GL_CLAMP_TO_BORDER,
-        };
-
-        const Uint32 TextureMagFilterModesOGL[2] = {
-                GL_LINEAR,
-                GL_NEAREST,
-        };
-
-        const Uint32 TextureMinFilterModesOGL[2] = {
-                GL_LINEAR_MIPMAP_LINEAR,
-                GL_NEAREST_MIPMAP_NEAREST,
-        };
-
-        const Uint32 IndexTypesOGL[3] = {
-                GL_UNSIGNED_BYTE,
-                GL_UNSIGNED_SHORT,
-                GL_UNSIGNED_INT,
-        };
-
-        const Uint32 PrimitiveTopologiesOGL[5] = {
-                GL_POINTS,
-                GL_LINES,
-                GL_LINE_STRIP,
-                GL_TRIANGLES,
-                GL_TRIANGLE_STRIP,
-        };
-
-        struct VertexBufferOGL {
-            Uint32 VertexArray;
-            Uint32 VertexBuffer;
-        };
-
-        using IndexBufferOGL = Uint32;
-        using UniformBufferOGL = Uint32;
-
-        struct ShaderOGL
-        {
-            Uint32 VertexShader, GeometryShader, FragmentShader;
-            Uint32 ShaderProgram;
-        };
-
-        using TextureOGL = Uint32;
-
-        using FramebufferOGL = Uint32;
-        using RenderBufferOGL = Uint32;
-
-        struct RenderTargetOGL
-        {
-            FramebufferOGL Framebuffer;
-
-            Uint64 UsedRenderBuffers;
-            RenderBufferOGL Renderbuffers[];
-        };
-
-        Window* m_window;
-        Debugger* m_debugger;
-
-        Allocator* m_structAllocator;
-        Allocator* m_bufferAllocator;
-        Allocator* m_textureAllocator;
-
-        // TODO: add something like an array where ALL created graphics object will be stored
-        //  and will be destroyed in the destructor.
-        //  Because sometimes user can forget about deleting objects and it can be helpful
-
-    public:
-        GraphicsContextOGL(Window *window, Debugger *debugger, GraphicsAllocators allocators);
-
-        void PresentGraphics() override;
-
-        void SetTarget() override;
-        void SetTarget(RenderTarget *renderTarget) override {}
-
-        void EnableDepthTest() override {}
-        void DisableDepthTest() override {}
-
-        void EnableStencilTest() override {}
-        void DisableStencilTest() override {}
-
-        void ClearTarget(Float32 red, Float32 green, Float32 blue) override;
-
-        VertexBuffer* CreateVertexBuffer(VertexBuffer::Desc description) override;
-        IndexBuffer* CreateIndexBuffer(IndexBuffer::Desc description) override;
-        UniformBuffer* CreateUniformBuffer(UniformBuffer::Desc description) override;
-
-        void OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 vertexCount) override;
-        void OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 newCount) override;
-        void OverwriteBuffer(UniformBuffer* ubo, const void* newData, Uint64 newSize) override;
-
-        void ReleaseBuffer(VertexBuffer* vbo) override;
-        void ReleaseBuffer(IndexBuffer* ibo) override;
-        void ReleaseBuffer(UniformBuffer* ubo) override;
-
-        Shader* CreateShader(Shader::Desc description) override;
-        void ReleaseShader(Shader* shader) override;
-
-        void BindShader(Shader* shader) override;
-
-        void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo) override;
-        void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo,
-                                     Uint64 offset, Uint64 size) override;
-
-        Texture1D* CreateTexture1D(Texture1D::Desc description) override;
-        Texture2D* CreateTexture2D(Texture2D::Desc description) override;
-        Texture3D* CreateTexture3D(Texture3D::Desc description) override;
-
-        void OverwriteTexture(Texture1D* texture, Uint64 width, const void* data) override;
-        void OverwriteTexture(Texture2D* texture, Uint64 width, Uint64 height, const void* data) override;
-        void OverwriteTexture(Texture3D* texture, Uint64 width, Uint64 height, Uint64 depth, const void* data) override;
-
-        void ReleaseTexture(Texture1D* texture) override;
-        void ReleaseTexture(Texture2D* texture) override;
-        void ReleaseTexture(Texture3D* texture) override;
-
-        void BindShaderTexture(Shader* shader, const char* name, const Texture1D* texture) override;
-        void BindShaderTexture(Shader* shader, const char* name, const Texture2D* texture) override;
-        void BindShaderTexture(Shader* shader, const char* name, const Texture3D* texture) override;
-
-        void Draw(PrimitiveToplogies topology, VertexBuffer* vbo) override;
-        void DrawIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo) override;
-    };
-}
+#pragma once
+
+#include "Graphics.h"
+#include "VertexFormat.h"
+
+namespace Tiny3D
+{
+    class GraphicsContextOGL : public GraphicsContext
+    {
+    private:
+        const Uint32 TypeQualifiersOGL[8] = {
+                GL_UNSIGNED_BYTE, GL_BYTE,
+                GL_UNSIGNED_SHORT, GL_SHORT,
+                GL_UNSIGNED_INT, GL_INT,
+                GL_FLOAT, GL_DOUBLE,
+        };
+
+        const Uint64 TypeSizesOGL[8] = {
+                1, 1,
+                2, 2,
+                4, 4,
+                4, 8,
+        };
+
+        const Uint32 BufferUsagesOGL[3] = {
+                GL_STATIC_DRAW,
+                GL_STREAM_DRAW,
+                GL_DYNAMIC_DRAW,
+        };
+
+        const Uint32 PixelFormatsOGL[19] = {
+                GL_RGBA, GL_RGB,
+                GL_RGBA, GL_RGB,
+                GL_RGBA_INTEGER, GL_RGB_INTEGER,
+                GL_RGBA_INTEGER, GL_RGB_INTEGER,
+                GL_RGBA_INTEGER, GL_RGB_INTEGER,
+                GL_RGBA_INTEGER, GL_RGB_INTEGER,
+                GL_RGBA, GL_RGB,
+
+                GL_DEPTH_COMPONENT,
+                GL_DEPTH_COMPONENT,
+                GL_DEPTH_COMPONENT,
+                GL_STENCIL_INDEX,
+
+                GL_DEPTH_STENCIL,
+        };
+
+        // TODO: read about how to properly use internal formats and fix it
+        const Uint32 PixelInternalFormatsOGL[19] = {
+                GL_RGBA, GL_RGB,
+                GL_RGBA, GL_RGB,
+
+                GL_RGBA, GL_RGB,
+                GL_RGBA, GL_RGB,
+
+                GL_RGBA, GL_RGB,
+                GL_RGBA, GL_RGB,
+                GL_RGBA, GL_RGB,
+
+                GL_DEPTH_COMPONENT16,
+                GL_DEPTH_COMPONENT24,
+                GL_DEPTH_COMPONENT32,
+                GL_STENCIL_INDEX8,
+
+                GL_DEPTH24_STENCIL8,
+        };
+
+        // Immutable storage (glTextureStorage*) takes only sized formats
+        const Uint32 PixelStorageFormatsOGL[19] = {
+                GL_RGBA8, GL_RGB8,
+                GL_RGBA8_SNORM, GL_RGB8_SNORM,
+
+                GL_RGBA16UI, GL_RGB16UI,
+                GL_RGBA16I, GL_RGB16I,
+
+                GL_RGBA32UI, GL_RGB32UI,
+                GL_RGBA32I, GL_RGB32I,
+                GL_RGBA32F, GL_RGB32F,
+
+                GL_DEPTH_COMPONENT16,
+                GL_DEPTH_COMPONENT24,
+                GL_DEPTH_COMPONENT32,
+                GL_STENCIL_INDEX8,
+
+                GL_DEPTH24_STENCIL8,
+        };
+
+        const Uint32 PixelTypesOGL[19] = {
+                GL_UNSIGNED_BYTE, GL_UNSIGNED_BYTE,
+                GL_BYTE, GL_BYTE,
+
+                GL_UNSIGNED_SHORT, GL_UNSIGNED_SHORT,
+                GL_SHORT, GL_SHORT,
+
+                GL_UNSIGNED_INT, GL_UNSIGNED_INT,
+                GL_INT, GL_INT,
+                GL_FLOAT, GL_FLOAT,
+
+                GL_FLOAT, GL_FLOAT, GL_FLOAT,
+                GL_UNSIGNED_BYTE,
+
+                GL_UNSIGNED_INT_24_8,
+        };
+
+        const Uint32 TextureAddressModesOGL[4] = {
+                GL_REPEAT,
+                GL_MIRRORED_REPEAT,
+                GL_CLAMP_TO_EDGE,
+                GL_CLAMP_TO_BORDER,
+        };
+
+        const Uint32 TextureMagFilterModesOGL[2] = {
+                GL_LINEAR,
+                GL_NEAREST,
+        };
+
+        const Uint32 TextureMinFilterModesOGL[2] = {
+                GL_LINEAR_MIPMAP_LINEAR,
+                GL_NEAREST_MIPMAP_NEAREST,
+        };
+
+        const Uint32 IndexTypesOGL[3] = {
+                GL_UNSIGNED_BYTE,
+                GL_UNSIGNED_SHORT,
+                GL_UNSIGNED_INT,
+        };
+
+        const Uint32 PrimitiveTopologiesOGL[5] = {
+                GL_POINTS,
+                GL_LINES,
+                GL_LINE_STRIP,
+                GL_TRIANGLES,
+                GL_TRIANGLE_STRIP,
+        };
+
+        enum class BufferBindings : Uint64
+        {
+            ArrayBinding,
+            ElementBinding,
+            UniformBinding,
+            IndirectBinding,
+            StorageBinding,
+            ParameterBinding,
+
+            // Uploads go through their own target, so they don't change the element buffer of the bound VAO
+            CopyBinding,
+        };
+
+        static constexpr Uint64 BufferBindingsCount = 7;
+
+        const Uint32 BufferTargetsOGL[7] = {
+                GL_ARRAY_BUFFER,
+                GL_ELEMENT_ARRAY_BUFFER,
+                GL_UNIFORM_BUFFER,
+                GL_DRAW_INDIRECT_BUFFER,
+                GL_SHADER_STORAGE_BUFFER,
+                GL_PARAMETER_BUFFER,
+                GL_COPY_WRITE_BUFFER,
+        };
+
+        enum class TextureBindings : Uint64
+        {
+            Binding1D,
+            Binding2D,
+            Binding3D,
+        };
+
+        static constexpr Uint64 TextureBindingsCount = 3;
+
+        const Uint32 TextureTargetsOGL[3] = {
+                GL_TEXTURE_1D,
+                GL_TEXTURE_2D,
+                GL_TEXTURE_3D,
+        };
+
+        enum class StateFlags : Uint64
+        {
+            DepthTest,
+            StencilTest,
+            Blending,
+            FaceCulling,
+            PolygonOffset,
+        };
+
+        static constexpr Uint64 StateFlagsCount = 5;
+
+        const Uint32 StateFlagsOGL[5] = {
+                GL_DEPTH_TEST,
+                GL_STENCIL_TEST,
+                GL_BLEND,
+                GL_CULL_FACE,
+                GL_POLYGON_OFFSET_FILL,
+        };
+
+        const Uint32 CompareFunctionsOGL[8] = {
+                GL_NEVER,
+                GL_LESS,
+                GL_EQUAL,
+                GL_LEQUAL,
+                GL_GREATER,
+                GL_NOTEQUAL,
+                GL_GEQUAL,
+                GL_ALWAYS,
+        };
+
+        const Uint32 StencilOperationsOGL[8] = {
+                GL_KEEP,
+                GL_ZERO,
+                GL_REPLACE,
+                GL_INCR,
+                GL_INCR_WRAP,
+                GL_DECR,
+                GL_DECR_WRAP,
+                GL_INVERT,
+        };
+
+        const Uint32 BlendFactorsOGL[10] = {
+                GL_ZERO,
+                GL_ONE,
+                GL_SRC_COLOR,
+                GL_ONE_MINUS_SRC_COLOR,
+                GL_DST_COLOR,
+                GL_ONE_MINUS_DST_COLOR,
+                GL_SRC_ALPHA,
+                GL_ONE_MINUS_SRC_ALPHA,
+                GL_DST_ALPHA,
+                GL_ONE_MINUS_DST_ALPHA,
+        };
+
+        const Uint32 BlendOperationsOGL[5] = {
+                GL_FUNC_ADD,
+                GL_FUNC_SUBTRACT,
+                GL_FUNC_REVERSE_SUBTRACT,
+                GL_MIN,
+                GL_MAX,
+        };
+
+        // No culling is told by the flag, face is kept as it was
+        const Uint32 CullModesOGL[3] = {
+                GL_BACK,
+                GL_FRONT,
+                GL_BACK,
+        };
+
+        const Uint32 FillModesOGL[2] = {
+                GL_FILL,
+                GL_LINE,
+        };
+
+        // Values of render state in the form they are given to GL. Values which go to one call are
+        // next to each other, so they are compared and copied together
+        struct RenderStateOGL
+        {
+            Uint32 DepthWrite;
+            Uint32 DepthFunction;
+
+            Uint32 StencilFunction;
+            Uint32 StencilReference;
+            Uint32 StencilReadMask;
+
+            Uint32 StencilWriteMask;
+
+            Uint32 StencilFail;
+            Uint32 StencilDepthFail;
+            Uint32 StencilPass;
+
+            Uint32 BlendSourceColor;
+            Uint32 BlendDestinationColor;
+            Uint32 BlendSourceAlpha;
+            Uint32 BlendDestinationAlpha;
+
+            Uint32 BlendColorOperation;
+            Uint32 BlendAlphaOperation;
+
+            Uint32 ColorWriteMask;
+
+            Uint32 CullFace;
+            Uint32 FrontFace;
+            Uint32 PolygonMode;
+
+            Float32 SlopeDepthBias;
+            Float32 DepthBias;
+        };
+
+        struct PipelineStateOGL
+        {
+            bool Flags[StateFlagsCount];
+            RenderStateOGL State;
+
+            Uint64 UsersCount;
+        };
+
+        // Format of attribute is kept to attach buffer as instance stream to VAO of another buffer
+        struct VertexAttributeOGL
+        {
+            Uint32 Count;
+            Uint32 Type;
+            Uint8 Normalized;
+            Uint32 Divisor;
+            Uint64 Offset;
+        };
+
+        // Buffers of one layout share VAO when format of attributes is separate from their buffers,
+        // then format is the index of shared VAO and the buffer is bound to it before drawing
+        struct VertexBufferOGL {
+            Uint32 VertexArray;
+            Uint32 VertexBuffer;
+            Uint64 VertexFormat;
+
+            // Pulled buffer is bound as storage buffer and has no attributes
+            bool VertexPulling;
+
+            Uint64 Stride;
+            Uint64 AttributesCount;
+            VertexAttributeOGL Attributes[MaxVertexElements];
+        };
+
+        // Buffers which are bound to VAO now are remembered, so drawing of the same mesh doesn't bind them again.
+        // Attributes are kept to tell formats with the same hash apart
+        struct VertexFormatOGL
+        {
+            Uint64 Hash;
+            Uint32 VertexArray;
+            Uint64 UsersCount;
+
+            Uint32 BoundBuffer;
+
+            Uint64 AttributesCount;
+            VertexAttributeOGL Attributes[MaxVertexElements];
+        };
+
+        using IndexBufferOGL = Uint32;
+        using UniformBufferOGL = Uint32;
+        using IndirectBufferOGL = Uint32;
+
+        struct CullingBatchOGL
+        {
+            Uint32 SpheresBuffer;
+            Uint32 CommandsBuffer;
+
+            // Output of culling: visible commands and their count
+            Uint32 VisibleBuffer;
+            Uint32 CountBuffer;
+        };
+
+        enum class ShaderBindingKinds : Uint32
+        {
+            UniformBlock,
+            Sampler,
+            Attribute,
+        };
+
+        // Active resource of linked program: uniform block has binding point, sampler has texture unit
+        // and attribute has location. Slots of blocks and samplers are assigned once at creation
+        struct ShaderBindingOGL
+        {
+            Uint64 NameHash;
+            ShaderBindingKinds Kind;
+            Uint32 Slot;
+        };
+
+        static constexpr Uint64 MaxShaderBindings = 32;
+
+        struct ShaderOGL
+        {
+            Uint32 VertexShader, GeometryShader, FragmentShader;
+            Uint32 ShaderProgram;
+
+            Uint64 BindingsCount;
+            ShaderBindingOGL Bindings[MaxShaderBindings];
+
+            // Program which is still compiled (or loaded) is checked, reflected and stored into cache
+            // when it's needed for the first time. Compiled means that it was built from sources
+            bool Pending;
+            bool Compiled;
+
+            // Program which failed to link is never bound
+            bool Linked;
+
+            bool Cached;
+            Uint64 CacheKey;
+            Float64 CompileStart;
+        };
+
+        // Sampling isn't kept by texture itself, it's the index of sampler object which is bound with it
+        struct TextureOGL
+        {
+            Uint32 Texture;
+            Uint64 Sampler;
+        };
+
+        // Textures with the same sampling share one sampler object
+        // Sampling is kept to tell samplings with the same hash apart
+        struct SamplerOGL
+        {
+            Uint32 Sampler;
+            Uint64 Hash;
+            Uint64 UsersCount;
+
+            SamplingInfo Sampling;
+        };
+
+        // Textures of attachments are kept by RenderTarget itself
+        struct RenderTargetOGL
+        {
+            Uint32 Framebuffer;
+        };
+
+        Window* m_window;
+        Debugger* m_debugger;
+
+        Allocator* m_structAllocator;
+        Allocator* m_bufferAllocator;
+        Allocator* m_textureAllocator;
+
+        // Optional features of the driver, they are queried once at initialization
+        struct CapabilitiesOGL
+        {
+            bool ComputeShaders;
+
+            // Reflection through glGetProgramResource (4.3), otherwise the older glGetActive* queries are used
+            bool ProgramInterfaceQuery;
+
+            // glGetProgramBinary (4.1) with at least one binary format which driver can give back
+            bool ProgramBinary;
+
+            // SPIR-V modules are core since 4.6 and an ARB extension before
+            bool SpirV;
+            bool SpirVCore;
+
+            // Completion of program can be polled without waiting for it (KHR or ARB extension)
+            bool ParallelShaderCompile;
+
+            // Objects are created and changed by name (4.5), so nothing is bound for that
+            bool DirectStateAccess;
+
+            // Format of attributes is set apart from their buffers (4.3), so VAO can be shared by layout
+            bool VertexAttribBinding;
+
+            // Storage buffers can be read by vertex shader (4.3 and at least one block in vertex stage)
+            bool VertexPulling;
+
+            // glMultiDrawElementsIndirectCount is core since 4.6 and an ARB extension before
+            bool IndirectCount;
+            bool IndirectCountCore;
+
+            // Limit of anisotropic filtering (core since 4.6, extension before), zero when it isn't supported
+            Float32 MaxAnisotropy;
+
+            // Color attachments which can be drawn at once (the lower of attachments and draw buffers limits)
+            Uint64 MaxColorAttachments;
+        };
+
+        CapabilitiesOGL m_capabilities;
+
+        // Shadow of the state which is changed by the context. Calls which wouldn't change anything are skipped.
+        // Unknown value means that state has to be set anyway (after InvalidateStateCache)
+        static constexpr Uint32 UnknownStateOGL = ~0u;
+
+        // Only the first units and indexed bindings are cached, the rest are always set
+        static constexpr Uint64 CachedTextureUnits = 16;
+        static constexpr Uint64 CachedIndexedBindings = 16;
+
+        struct BufferRangeOGL
+        {
+            Uint32 Buffer;
+            Uint64 Offset;
+            Uint64 Size;
+        };
+
+        struct StateCacheOGL
+        {
+            Uint32 Program;
+            Uint32 VertexArray;
+            Uint32 Framebuffer;
+
+            // Element buffer is a state of VAO, so it becomes unknown when VAO is changed
+            Uint32 Buffers[BufferBindingsCount];
+
+            BufferRangeOGL UniformRanges[CachedIndexedBindings];
+            BufferRangeOGL StorageRanges[CachedIndexedBindings];
+
+            Uint32 ActiveTextureUnit;
+            Uint32 Textures[CachedTextureUnits][TextureBindingsCount];
+            Uint32 Samplers[CachedTextureUnits];
+
+            Uint32 Flags[StateFlagsCount];
+
+            // All bytes are set when state is unknown
+            RenderStateOGL Render;
+        };
+
+        StateCacheOGL m_state;
+
+        void UseProgram(Uint32 program);
+        void BindVertexArray(Uint32 vao);
+        void BindFramebuffer(Uint32 framebuffer);
+        void BindBuffer(BufferBindings binding, Uint32 buffer);
+
+        // Indexed binding of uniform or storage buffer, zero size binds the whole buffer
+        void BindBufferRange(BufferBindings binding, Uint32 index, Uint32 buffer, Uint64 offset, Uint64 size);
+
+        // Texture is bound to the given unit (creation and overwriting use the active one)
+        void BindTexture(Uint32 unit, TextureBindings binding, Uint32 texture);
+        void BindTexture(TextureBindings binding, Uint32 texture);
+        void BindSampler(Uint32 unit, Uint32 sampler);
+
+        void SetStateFlag(StateFlags flag, bool enabled);
+
+        // Copies values into applied render state, returns false when they were applied already
+        bool ChangeRenderState(void* applied, const void* values, Uint64 size);
+        void ApplyPipelineState(const PipelineStateOGL& pipeline);
+
+        // Translates states of description into OpenGL values (users aren't counted)
+        PipelineStateOGL MakePipelineState(const PipelineState::Desc& description) const;
+
+        // Clearing is masked by write masks of pipeline state, so they are opened before it
+        void OpenWriteMasks();
+
+        // Buffers are created and changed by name with direct state access, otherwise through the binding
+        Uint32 CreateBufferObject(BufferBindings binding, Uint64 size, const void* data, Uint32 usage);
+        void SetBufferData(BufferBindings binding, Uint32 buffer, Uint64 size, const void* data, Uint32 usage);
+        void UpdateBufferData(BufferBindings binding, Uint32 buffer, Uint64 offset, Uint64 size, const void* data);
+        void ReadBufferData(BufferBindings binding, Uint32 buffer, Uint64 offset, Uint64 size, void* data);
+
+        // Texture of render target has one level and no copy of pixels, it's made with immutable storage when
+        // it's supported (the same as for the other textures)
+        Texture2D* CreateAttachmentTexture(Uint32 width, Uint32 height, PixelFormats pixelFormat,
+                                           const SamplingInfo& samplingInfo);
+
+        void AttachFramebufferTexture(Uint32 framebuffer, Uint32 attachment, const Texture2D* texture);
+
+        // Immutable storage can't be resized, so texture is made again (sampling is kept by sampler object)
+        Uint32 RecreateTexture(TextureBindings binding, Uint32 texture);
+
+        // Deleted objects are unbound by OpenGL and their names can be reused, so they are dropped from cache
+        void ForgetProgram(Uint32 program);
+        void ForgetVertexArray(Uint32 vao);
+        void ForgetBuffer(Uint32 buffer);
+        void ForgetTexture(Uint32 texture);
+        void ForgetSampler(Uint32 sampler);
+        void ForgetFramebuffer(Uint32 framebuffer);
+
+        // Compute program of GPU culling is created with the first culling batch
+        Uint32 m_cullingProgram = 0;
+        Int32 m_cullingPlanesLocation = -1;
+        Int32 m_cullingObjectCountLocation = -1;
+        Int32 m_cullingCompactLocation = -1;
+
+        bool CreateCullingProgram();
+
+        // Fills binding table of shader and assigns binding points and texture units of the program
+        void ReflectShader(ShaderOGL* shaderHandle);
+        void AddShaderBinding(ShaderOGL* shaderHandle, const char* name, ShaderBindingKinds kind, Uint32 slot);
+
+        const ShaderBindingOGL* FindShaderBinding(Shader* shader, ShaderBindingID binding, ShaderBindingKinds kind);
+
+        bool BindShaderTexture(Shader* shader, ShaderBindingID binding, TextureBindings target,
+                               const TextureOGL& texture);
+
+        // Compiles GLSL code of stage or specializes its SPIR-V module, returns zero for missing stage
+        Uint32 CompileStage(Uint32 type, const char* code, const ShaderBinary& binary);
+
+        // Compiles and links program from sources of description (it doesn't wait for the driver)
+        void CompileProgram(const Shader::Desc& description, ShaderOGL* shaderHandle);
+
+        // Shader is started by loading of cached binary or by compilation, it's finished when program is needed
+        void StartShader(const Shader::Desc& description, ShaderOGL* shaderHandle);
+        // Returns false if program failed to link
+        bool FinishShader(ShaderOGL* shaderHandle);
+
+        // Binaries of programs are kept in files which are named by hash of sources, vertex layout
+        // and driver, so any change of them makes a new file (old ones aren't removed)
+        static constexpr Uint64 MaxCachePathLength = 256;
+
+        char m_programCacheDirectory[MaxCachePathLength] = {};
+        Uint64 m_driverHash = 0;
+
+        // Cache is turned off when the path doesn't fit, returns false then
+        bool MakeCacheFilePath(Uint64 key, char* path);
+
+        // Returns zero if there is no binary for the key or driver doesn't accept it
+        Uint32 LoadCachedProgram(Uint64 key, Float64* compileSeconds);
+        void StoreCachedProgram(Uint64 key, Uint32 program, Float64 compileSeconds);
+
+        // Shared objects are kept in tables which are scanned linearly, released ones leave empty slots which
+        // are taken by the next new object. Returns index of the object which matches (found is set then),
+        // otherwise index of slot for the new one, the table grows when it has no empty slots
+        template <typename entry, typename emptyTest, typename matchTest>
+        Uint64 FindCacheSlot(entry*& entries, Uint64& count, Uint64& capacity, emptyTest isEmpty,
+                             matchTest matches, bool& found);
+
+        VertexFormatOGL* m_vertexFormats = nullptr;
+        Uint64 m_vertexFormatsCount = 0;
+        Uint64 m_vertexFormatsCapacity = 0;
+
+        PipelineState** m_pipelineStates = nullptr;
+        Uint64 m_pipelineStatesCount = 0;
+        Uint64 m_pipelineStatesCapacity = 0;
+
+        SamplerOGL* m_samplers = nullptr;
+        Uint64 m_samplersCount = 0;
+        Uint64 m_samplersCapacity = 0;
+
+        // Returns index of sampler object with the given sampling, it's created when the sampling is new
+        Uint64 AcquireSampler(const SamplingInfo& samplingInfo);
+        void ReleaseSampler(Uint64 sampler);
+
+        Uint32 CreateSamplerObject(const SamplingInfo& samplingInfo);
+
+        // Returns index of VAO with format of the buffer, it's created when the format is new
+        Uint64 AcquireVertexFormat(const VertexBufferOGL& buffer);
+        void ReleaseVertexFormat(Uint64 format);
+
+        Uint32 CreateVertexFormat(const VertexBufferOGL& buffer);
+
+        // Draws of pulled buffers still need VAO for the element buffer, this one has no attributes
+        Uint32 m_pullingVertexArray = 0;
+
+        // VAO of its own is made for every buffer when attribute binding isn't supported
+        Uint32 CreateVertexArray(const VertexBufferOGL& buffer);
+
+        VertexBuffer* CreatePulledVertexBuffer(const VertexBuffer::Desc& description, Uint64 bufferSize);
+
+        // Binds VAO of the buffer, shared VAO gets vertex buffer too (pulled buffer is bound as storage buffer)
+        void BindVertexBuffer(const VertexBufferOGL* buffer);
+
+        // Instance attributes are attached to currently bound VAO right after attributes of the mesh
+        void AttachInstanceStream(const VertexBufferOGL* mesh, const VertexBufferOGL* instances);
+        void DetachInstanceStream(const VertexBufferOGL* mesh, const VertexBufferOGL* instances);
+
+        // TODO: add something like an array where ALL created graphics object will be stored
+        //  and will be destroyed in the destructor.
+        //  Because sometimes user can forget about deleting objects and it can be helpful
+
+    public:
+        // State calls of one frame which were sent to driver and which were skipped by state cache
+        struct StateStatistics
+        {
+            Uint64 IssuedCalls;
+            Uint64 SkippedCalls;
+        };
+
+        // Rejected binaries were found but driver didn't load them (they are counted as misses too).
+        // Saved time is compile time which was stored with binary minus time of its loading
+        struct ProgramCacheStatistics
+        {
+            Uint64 Hits;
+            Uint64 Misses;
+            Uint64 Rejected;
+
+            Float64 CompileSeconds;
+            Float64 SavedSeconds;
+        };
+
+    private:
+        StateStatistics m_frameStatistics = {};
+        StateStatistics m_lastFrameStatistics = {};
+
+        ProgramCacheStatistics m_programCacheStatistics = {};
+
+    public:
+        GraphicsContextOGL(Window *window, Debugger *debugger, GraphicsAllocators allocators);
+        ~GraphicsContextOGL() override;
+
+        void PresentGraphics() override;
+
+        // Statistics of the last presented frame
+        const StateStatistics& GetStateStatistics() const;
+
+        // Has to be called when OpenGL state was changed outside of the context
+        void InvalidateStateCache();
+
+        // Shaders which are created after this call are loaded from binaries in the directory (it has to exist),
+        // missed ones are compiled and stored there. Nullptr turns the cache off
+        void SetProgramCacheDirectory(const char* directory);
+
+        const ProgramCacheStatistics& GetProgramCacheStatistics() const;
+
+        void SetTarget() override;
+        void SetTarget(RenderTarget *renderTarget) override;
+
+        void EnableDepthTest() override;
+        void DisableDepthTest() override;
+
+        void EnableStencilTest() override;
+        void DisableStencilTest() override;
+
+        void ClearTarget(Float32 red, Float32 green, Float32 blue) override;
+
+        VertexBuffer* CreateVertexBuffer(VertexBuffer::Desc description) override;
+        IndexBuffer* CreateIndexBuffer(IndexBuffer::Desc description) override;
+        UniformBuffer* CreateUniformBuffer(UniformBuffer::Desc description) override;
+
+        void OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 vertexCount) override;
+        void OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 newCount) override;
+
+        void OverwriteBuffer(VertexBuffer* vbo, const void* newVertices, Uint64 firstVertex,
+                             Uint64 vertexCount) override;
+        void OverwriteBuffer(IndexBuffer* ibo, const void* newIndices, Uint64 firstIndex, Uint64 indexCount) override;
+        void OverwriteBuffer(UniformBuffer* ubo, const void* newData, Uint64 newSize) override;
+
+        void ReleaseBuffer(VertexBuffer* vbo) override;
+        void ReleaseBuffer(IndexBuffer* ibo) override;
+        void ReleaseBuffer(UniformBuffer* ubo) override;
+
+        IndirectBuffer* CreateIndirectBuffer(IndirectBuffer::Desc description) override;
+        void OverwriteBuffer(IndirectBuffer* buffer, const DrawIndexedCommand* commands, Uint64 commandCount) override;
+        void ReleaseBuffer(IndirectBuffer* buffer) override;
+
+        CullingBatch* CreateCullingBatch(CullingBatch::Desc description) override;
+        void OverwriteBatch(CullingBatch* batch, const Float32* spheres, const DrawIndexedCommand* commands,
+                            Uint64 firstObject, Uint64 objectCount) override;
+        void ReleaseCullingBatch(CullingBatch* batch) override;
+
+        void CullBatch(CullingBatch* batch, const Frustum& frustum) override;
+        Uint64 ReadCulledCount(CullingBatch* batch) override;
+
+        Shader* CreateShader(Shader::Desc description) override;
+        Shader* CreateShaderAsync(Shader::Desc description) override;
+        bool IsShaderReady(Shader* shader) override;
+        bool IsShaderLinked(Shader* shader) override;
+        void ReleaseShader(Shader* shader) override;
+
+        void BindShader(Shader* shader) override;
+
+        PipelineState* CreatePipelineState(PipelineState::Desc description) override;
+        void ReleasePipelineState(PipelineState* state) override;
+
+        void BindPipelineState(PipelineState* state) override;
+
+        void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo) override;
+        void BindShaderUniformBuffer(Shader* shader, const char* name, const UniformBuffer* ubo,
+                                     Uint64 offset, Uint64 size) override;
+
+        void BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo) override;
+        void BindShaderUniformBuffer(Shader* shader, ShaderBindingID binding, const UniformBuffer* ubo,
+                                     Uint64 offset, Uint64 size) override;
+
+        Texture1D* CreateTexture1D(Texture1D::Desc description) override;
+        Texture2D* CreateTexture2D(Texture2D::Desc description) override;
+        Texture3D* CreateTexture3D(Texture3D::Desc description) override;
+
+        void OverwriteTexture(Texture1D* texture, Uint64 width, const void* data) override;
+        void OverwriteTexture(Texture2D* texture, Uint64 width, Uint64 height, const void* data) override;
+        void OverwriteTexture(Texture3D* texture, Uint64 width, Uint64 height, Uint64 depth, const void* data) override;
+
+        void ReleaseTexture(Texture1D* texture) override;
+        void ReleaseTexture(Texture2D* texture) override;
+        void ReleaseTexture(Texture3D* texture) override;
+
+        void SetTextureSampling(Texture1D* texture, const SamplingInfo& samplingInfo) override;
+        void SetTextureSampling(Texture2D* texture, const SamplingInfo& samplingInfo) override;
+        void SetTextureSampling(Texture3D* texture, const SamplingInfo& samplingInfo) override;
+
+        RenderTarget* CreateRenderTarget(RenderTarget::Desc description) override;
+        void ReleaseRenderTarget(RenderTarget* renderTarget) override;
+
+        void BindShaderTexture(Shader* shader, const char* name, const Texture1D* texture) override;
+        void BindShaderTexture(Shader* shader, const char* name, const Texture2D* texture) override;
+        void BindShaderTexture(Shader* shader, const char* name, const Texture3D* texture) override;
+
+        void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture1D* texture) override;
+        void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture2D* texture) override;
+        void BindShaderTexture(Shader* shader, ShaderBindingID binding, const Texture3D* texture) override;
+
+        void Draw(PrimitiveToplogies topology, VertexBuffer* vbo) override;
+        void DrawIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo) override;
+        void DrawIndexedRanges(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                               const IndexBuffer::Range* ranges, Uint64 rangesCount) override;
+
+        void DrawIndexedIndirect(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                 IndirectBuffer* commands, Uint64 firstCommand, Uint64 commandCount) override;
+
+        void DrawCulledIndexed(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                               CullingBatch* batch) override;
+
+        void DrawInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, VertexBuffer* instances,
+                           Uint64 instanceCount) override;
+        void DrawIndexedInstanced(PrimitiveToplogies topology, VertexBuffer* vbo, IndexBuffer* ibo,
+                                  VertexBuffer* instances, Uint64 instanceCount) override;
+    };
+}
@@ -0,0 +1,675 @@
+#include "MeshCodec.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        const Uint8 VertexCodecVersion = 0xA0;
+        const Uint8 IndexCodecVersion = 0xB0;
+
+        const Uint64 VertexGroupSize = 16;
+        const Uint64 VertexBlockMaxSize = 256;
+        const Uint64 VertexBlockMaxBytes = 16384;
+        const Uint64 VertexMaxSize = 256;
+
+        // Codes of the index stream (upper nibble of triangle code is an index in edge FIFO)
+        const Uint64 EdgeFifoSize = 16;
+        const Uint64 VertexFifoSize = 16;
+
+        const Uint8 NoEdgeCode = 15;
+        const Uint8 NextVertexCode = 0;
+        const Uint8 ExplicitVertexCode = 15;
+
+        Uint64 GetVertexBlockSize(Uint64 vertexSize)
+        {
+            Uint64 blockSize = (VertexBlockMaxBytes / vertexSize) & ~(VertexGroupSize - 1);
+
+            return MIN(MAX(blockSize, VertexGroupSize), VertexBlockMaxSize);
+        }
+
+        Uint8 ZigzagByte(Uint8 value)
+        {
+            return static_cast<Uint8>((value << 1) ^ static_cast<Uint8>(static_cast<Int8>(value) >> 7));
+        }
+
+        __m128i DecodeVertexGroup(Uint8 mode, const Uint8* data)
+        {
+            __m128i sequence;
+
+            switch (mode)
+            {
+                case 0:
+                    return _mm_setzero_si128();
+
+                case 1:
+                {
+                    Int32 packed;
+                    memcpy(&packed, data, sizeof(packed));
+
+                    __m128i bits = _mm_cvtsi32_si128(packed);
+                    __m128i mask = _mm_set1_epi8(0x03);
+
+                    __m128i first = _mm_and_si128(bits, mask);
+                    __m128i second = _mm_and_si128(_mm_srli_epi16(bits, 2), mask);
+                    __m128i third = _mm_and_si128(_mm_srli_epi16(bits, 4), mask);
+                    __m128i fourth = _mm_and_si128(_mm_srli_epi16(bits, 6), mask);
+
+                    sequence = _mm_unpacklo_epi16(_mm_unpacklo_epi8(first, second), _mm_unpacklo_epi8(third, fourth));
+                    break;
+                }
+
+                case 2:
+                {
+                    __m128i bits = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+                    __m128i mask = _mm_set1_epi8(0x0F);
+
+                    __m128i low = _mm_and_si128(bits, mask);
+                    __m128i high = _mm_and_si128(_mm_srli_epi16(bits, 4), mask);
+
+                    sequence = _mm_unpacklo_epi8(low, high);
+                    break;
+                }
+
+                default:
+                    sequence = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                    break;
+            }
+
+            // Zigzag decoding: (value >> 1) ^ -(value & 1)
+            __m128i shifted = _mm_and_si128(_mm_srli_epi16(sequence, 1), _mm_set1_epi8(0x7F));
+            __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(sequence, _mm_set1_epi8(1)));
+
+            return _mm_xor_si128(shifted, sign);
+        }
+
+        __m128i PrefixSum(__m128i sequence)
+        {
+            sequence = _mm_add_epi8(sequence, _mm_slli_si128(sequence, 1));
+            sequence = _mm_add_epi8(sequence, _mm_slli_si128(sequence, 2));
+            sequence = _mm_add_epi8(sequence, _mm_slli_si128(sequence, 4));
+            sequence = _mm_add_epi8(sequence, _mm_slli_si128(sequence, 8));
+
+            return sequence;
+        }
+
+        void StoreVertexWord(Uint8* destination, __m128i sequence)
+        {
+            // Plain memcpy is inlined by compiler unlike CopyMemory, which matters for 4 byte stores
+            Int32 word = _mm_cvtsi128_si32(sequence);
+            memcpy(destination, &word, sizeof(word));
+        }
+
+        // Channel-major block (byte k of all vertices goes in a row) into vertex-major memory
+        void TransposeVertexBlock(Uint8* destination, const Uint8* channels, Uint64 blockSize,
+                                  Uint64 vertexCount, Uint64 vertexSize)
+        {
+            Uint64 fullGroups = (vertexSize % 4 == 0) ? vertexCount / VertexGroupSize : 0;
+
+            for (Uint64 k = 0; k < vertexSize && fullGroups != 0; k += 4)
+            {
+                for (Uint64 g = 0; g < fullGroups; g++)
+                {
+                    Uint64 i = g * VertexGroupSize;
+
+                    __m128i row0 = _mm_load_si128(reinterpret_cast<const __m128i*>(channels + (k + 0) * blockSize + i));
+                    __m128i row1 = _mm_load_si128(reinterpret_cast<const __m128i*>(channels + (k + 1) * blockSize + i));
+                    __m128i row2 = _mm_load_si128(reinterpret_cast<const __m128i*>(channels + (k + 2) * blockSize + i));
+                    __m128i row3 = _mm_load_si128(reinterpret_cast<const __m128i*>(channels + (k + 3) * blockSize + i));
+
+                    __m128i low01 = _mm_unpacklo_epi8(row0, row1);
+                    __m128i high01 = _mm_unpackhi_epi8(row0, row1);
+                    __m128i low23 = _mm_unpacklo_epi8(row2, row3);
+                    __m128i high23 = _mm_unpackhi_epi8(row2, row3);
+
+                    __m128i words[4] = {
+                            _mm_unpacklo_epi16(low01, low23),
+                            _mm_unpackhi_epi16(low01, low23),
+                            _mm_unpacklo_epi16(high01, high23),
+                            _mm_unpackhi_epi16(high01, high23),
+                    };
+
+                    Uint8* vertex = destination + i * vertexSize + k;
+
+                    for (Uint64 w = 0; w < 4; w++)
+                    {
+                        StoreVertexWord(vertex, words[w]);
+                        StoreVertexWord(vertex + vertexSize, _mm_srli_si128(words[w], 4));
+                        StoreVertexWord(vertex + vertexSize * 2, _mm_srli_si128(words[w], 8));
+                        StoreVertexWord(vertex + vertexSize * 3, _mm_srli_si128(words[w], 12));
+
+                        vertex += vertexSize * 4;
+                    }
+                }
+            }
+
+            for (Uint64 i = fullGroups * VertexGroupSize; i < vertexCount; i++)
+            {
+                for (Uint64 k = 0; k < vertexSize; k++)
+                    destination[i * vertexSize + k] = channels[k * blockSize + i];
+            }
+        }
+
+        Uint64 WriteVarint(Uint8* destination, Uint32 value)
+        {
+            Uint64 size = 0;
+
+            do
+            {
+                Uint8 byte = value & 0x7F;
+                value >>= 7;
+
+                destination[size++] = byte | ((value != 0) ? 0x80 : 0);
+            }
+            while (value != 0);
+
+            return size;
+        }
+
+        bool ReadVarint(const Uint8*& source, const Uint8* end, Uint32& value)
+        {
+            value = 0;
+
+            for (Uint32 shift = 0; shift < 35; shift += 7)
+            {
+                if (source == end)
+                    return false;
+
+                Uint8 byte = *source++;
+                value |= static_cast<Uint32>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+
+            return false;
+        }
+
+        Uint32 ZigzagDelta(Uint32 value, Uint32 last)
+        {
+            Int32 delta = static_cast<Int32>(value - last);
+            return (static_cast<Uint32>(delta) << 1) ^ static_cast<Uint32>(delta >> 31);
+        }
+
+        Uint32 UnzigzagDelta(Uint32 value, Uint32 last)
+        {
+            Uint32 delta = (value >> 1) ^ (0u - (value & 1));
+            return last + delta;
+        }
+
+        // Edge and vertex FIFOs which are kept equally by encoder and decoder.
+        // Index 0 is the most recent entry
+        struct IndexCodecState
+        {
+            Uint32 Edges[EdgeFifoSize][2];
+            Uint64 EdgesOffset;
+
+            Uint32 Vertices[VertexFifoSize];
+            Uint64 VerticesOffset;
+
+            Uint32 Next;
+            Uint32 Last;
+
+            void PushEdge(Uint32 a, Uint32 b)
+            {
+                Edges[EdgesOffset % EdgeFifoSize][0] = a;
+                Edges[EdgesOffset % EdgeFifoSize][1] = b;
+                EdgesOffset++;
+            }
+
+            void PushVertex(Uint32 vertex)
+            {
+                Vertices[VerticesOffset % VertexFifoSize] = vertex;
+                VerticesOffset++;
+            }
+
+            const Uint32* GetEdge(Uint64 index) const
+            {
+                return Edges[(EdgesOffset - 1 - index) % EdgeFifoSize];
+            }
+
+            Uint32 GetVertex(Uint64 index) const
+            {
+                return Vertices[(VerticesOffset - 1 - index) % VertexFifoSize];
+            }
+
+            // Triangle (a, b, c) shares edge (b, a) with the next triangle of consistent winding
+            void PushTriangle(Uint32 a, Uint32 b, Uint32 c)
+            {
+                PushEdge(b, a);
+                PushEdge(c, b);
+                PushEdge(a, c);
+            }
+
+            Uint8 EncodeVertex(Uint32 vertex, Uint8* data, Uint64& dataSize)
+            {
+                if (vertex == Next)
+                {
+                    Next++;
+                    PushVertex(vertex);
+                    return NextVertexCode;
+                }
+
+                for (Uint64 i = 0; i + 1 < ExplicitVertexCode && i < VertexFifoSize; i++)
+                {
+                    if (i < VerticesOffset && GetVertex(i) == vertex)
+                        return static_cast<Uint8>(i + 1);
+                }
+
+                dataSize += WriteVarint(data + dataSize, ZigzagDelta(vertex, Last));
+                Last = vertex;
+                PushVertex(vertex);
+
+                return ExplicitVertexCode;
+            }
+
+            bool DecodeVertex(Uint8 code, const Uint8*& source, const Uint8* end, Uint32& vertex)
+            {
+                if (code == NextVertexCode)
+                {
+                    vertex = Next++;
+                    PushVertex(vertex);
+                    return true;
+                }
+
+                if (code != ExplicitVertexCode)
+                {
+                    if (code > VerticesOffset)
+                        return false;
+
+                    vertex = GetVertex(code - 1);
+                    return true;
+                }
+
+                Uint32 value;
+                if (!ReadVarint(source, end, value))
+                    return false;
+
+                vertex = UnzigzagDelta(value, Last);
+                Last = vertex;
+                PushVertex(vertex);
+
+                return true;
+            }
+        };
+    }
+
+    Uint64 GetVertexBufferEncodeBound(Uint64 vertexCount, Uint64 vertexSize)
+    {
+        if (vertexSize == 0)
+            return 0;
+
+        Uint64 blockSize = GetVertexBlockSize(vertexSize);
+        Uint64 blocks = (vertexCount + blockSize - 1) / blockSize;
+        Uint64 groups = blockSize / VertexGroupSize;
+
+        return 1 + blocks * vertexSize * ((groups + 3) / 4 + groups * VertexGroupSize);
+    }
+
+    Uint64 EncodeVertexBuffer(Uint8* destination, Uint64 destinationSize,
+                              const void* vertices, Uint64 vertexCount, Uint64 vertexSize)
+    {
+        if (destination == nullptr || vertices == nullptr || vertexSize == 0 || vertexSize > VertexMaxSize)
+            return 0;
+
+        if (destinationSize < GetVertexBufferEncodeBound(vertexCount, vertexSize))
+            return 0;
+
+        const Uint8* source = reinterpret_cast<const Uint8*>(vertices);
+        Uint64 blockSize = GetVertexBlockSize(vertexSize);
+
+        Uint8 previous[VertexMaxSize];
+        ZeroMemory(previous, vertexSize);
+
+        Uint64 size = 0;
+        destination[size++] = VertexCodecVersion;
+
+        for (Uint64 blockStart = 0; blockStart < vertexCount; blockStart += blockSize)
+        {
+            Uint64 count = MIN(blockSize, vertexCount - blockStart);
+            Uint64 groups = (count + VertexGroupSize - 1) / VertexGroupSize;
+
+            for (Uint64 k = 0; k < vertexSize; k++)
+            {
+                Uint8* header = destination + size;
+                Uint64 headerSize = (groups + 3) / 4;
+
+                ZeroMemory(header, headerSize);
+                size += headerSize;
+
+                Uint8 last = previous[k];
+
+                for (Uint64 g = 0; g < groups; g++)
+                {
+                    Uint8 deltas[VertexGroupSize] = {};
+                    Uint8 maxDelta = 0;
+
+                    for (Uint64 j = 0; j < VertexGroupSize; j++)
+                    {
+                        Uint64 i = blockStart + g * VertexGroupSize + j;
+
+                        if (i >= blockStart + count)
+                            break;
+
+                        Uint8 value = source[i * vertexSize + k];
+
+                        deltas[j] = ZigzagByte(static_cast<Uint8>(value - last));
+                        maxDelta = MAX(maxDelta, deltas[j]);
+
+                        last = value;
+                    }
+
+                    Uint8 mode = (maxDelta == 0) ? 0 : (maxDelta < 4) ? 1 : (maxDelta < 16) ? 2 : 3;
+                    header[g / 4] |= mode << ((g % 4) * 2);
+
+                    if (mode == 1)
+                    {
+                        for (Uint64 j = 0; j < 4; j++)
+                        {
+                            destination[size + j] = deltas[j * 4] | (deltas[j * 4 + 1] << 2) |
+                                                    (deltas[j * 4 + 2] << 4) | (deltas[j * 4 + 3] << 6);
+                        }
+
+                        size += 4;
+                    }
+
+                    else if (mode == 2)
+                    {
+                        for (Uint64 j = 0; j < 8; j++)
+                            destination[size + j] = deltas[j * 2] | (deltas[j * 2 + 1] << 4);
+
+                        size += 8;
+                    }
+
+                    else if (mode == 3)
+                    {
+                        CopyMemory(destination + size, deltas, VertexGroupSize);
+                        size += VertexGroupSize;
+                    }
+                }
+            }
+
+            CopyMemory(previous, source + (blockStart + count - 1) * vertexSize, vertexSize);
+        }
+
+        return size;
+    }
+
+    bool DecodeVertexBuffer(void* destination, Uint64 vertexCount, Uint64 vertexSize,
+                            const Uint8* source, Uint64 sourceSize)
+    {
+        if (destination == nullptr || source == nullptr || vertexSize == 0 || vertexSize > VertexMaxSize)
+            return false;
+
+        if (sourceSize == 0 || source[0] != VertexCodecVersion)
+            return false;
+
+        const Uint8* data = source + 1;
+        const Uint8* end = source + sourceSize;
+
+        Uint8* output = reinterpret_cast<Uint8*>(destination);
+        Uint64 blockSize = GetVertexBlockSize(vertexSize);
+
+        alignas(16) Uint8 channels[VertexBlockMaxBytes + VertexMaxSize * VertexGroupSize];
+        alignas(16) Uint8 previous[VertexMaxSize];
+        ZeroMemory(previous, vertexSize);
+
+        const Uint64 groupSizes[4] = {0, 4, 8, 16};
+
+        for (Uint64 blockStart = 0; blockStart < vertexCount; blockStart += blockSize)
+        {
+            Uint64 count = MIN(blockSize, vertexCount - blockStart);
+            Uint64 groups = (count + VertexGroupSize - 1) / VertexGroupSize;
+
+            for (Uint64 k = 0; k < vertexSize; k++)
+            {
+                const Uint8* header = data;
+                Uint64 headerSize = (groups + 3) / 4;
+
+                if (static_cast<Uint64>(end - data) < headerSize)
+                    return false;
+
+                data += headerSize;
+
+                __m128i carry = _mm_set1_epi8(static_cast<Int8>(previous[k]));
+                Uint8* channel = channels + k * blockSize;
+
+                for (Uint64 g = 0; g < groups; g++)
+                {
+                    Uint8 mode = (header[g / 4] >> ((g % 4) * 2)) & 0x03;
+
+                    if (static_cast<Uint64>(end - data) < groupSizes[mode])
+                        return false;
+
+                    __m128i deltas = DecodeVertexGroup(mode, data);
+                    data += groupSizes[mode];
+
+                    __m128i values = _mm_add_epi8(PrefixSum(deltas), carry);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(channel + g * VertexGroupSize), values);
+
+                    carry = _mm_shuffle_epi8(values, _mm_set1_epi8(15));
+                }
+
+                previous[k] = channel[count - 1];
+            }
+
+            TransposeVertexBlock(output + blockStart * vertexSize, channels, blockSize, count, vertexSize);
+        }
+
+        return data == end;
+    }
+
+    bool DecodeVertexBuffer(VertexBuffer::Desc& description, const Uint8* source, Uint64 sourceSize)
+    {
+        return DecodeVertexBuffer(description.Vertices, description.VertexCount, description.VertexSize,
+                                  source, sourceSize);
+    }
+
+    Uint64 GetIndexBufferEncodeBound(Uint64 indexCount)
+    {
+        // Code bytes and 5 bytes of varint per each index at worst
+        return 1 + (indexCount / 3) * (3 + 3 * 5);
+    }
+
+    Uint64 EncodeIndexBuffer(Uint8* destination, Uint64 destinationSize, const IndexBuffer::Desc& indices)
+    {
+        if (destination == nullptr || indices.Indices == nullptr || indices.IndexCount % 3 != 0)
+            return 0;
+
+        if (destinationSize < GetIndexBufferEncodeBound(indices.IndexCount))
+            return 0;
+
+        IndexCodecState state = {};
+
+        Uint64 size = 0;
+        destination[size++] = IndexCodecVersion;
+
+        for (Uint64 i = 0; i < indices.IndexCount; i += 3)
+        {
+            Uint32 triangle[3];
+
+            for (Uint64 j = 0; j < 3; j++)
+                triangle[j] = IndexBuffer::ReadIndex(indices.Indices, indices.IndexType, i + j);
+
+            // Looking for rotation of triangle which starts with one of recent edges
+            Uint64 edge = NoEdgeCode, rotation = 0;
+
+            for (Uint64 e = 0; e < NoEdgeCode && e < state.EdgesOffset && edge == NoEdgeCode; e++)
+            {
+                const Uint32* fifoEdge = state.GetEdge(e);
+
+                for (Uint64 r = 0; r < 3; r++)
+                {
+                    if (triangle[r] == fifoEdge[0] && triangle[(r + 1) % 3] == fifoEdge[1])
+                    {
+                        edge = e;
+                        rotation = r;
+                        break;
+                    }
+                }
+            }
+
+            if (edge != NoEdgeCode)
+            {
+                Uint32 a = triangle[rotation], b = triangle[(rotation + 1) % 3], c = triangle[(rotation + 2) % 3];
+
+                Uint8* code = destination + size++;
+                *code = static_cast<Uint8>((edge << 4) | state.EncodeVertex(c, destination, size));
+
+                state.PushTriangle(a, b, c);
+                continue;
+            }
+
+            Uint8* codes = destination + size;
+            size += 2;
+
+            Uint8 firstCode = state.EncodeVertex(triangle[0], destination, size);
+            Uint8 secondCode = state.EncodeVertex(triangle[1], destination, size);
+            Uint8 thirdCode = state.EncodeVertex(triangle[2], destination, size);
+
+            codes[0] = static_cast<Uint8>((NoEdgeCode << 4) | firstCode);
+            codes[1] = static_cast<Uint8>((secondCode << 4) | thirdCode);
+
+            state.PushTriangle(triangle[0], triangle[1], triangle[2]);
+        }
+
+        return size;
+    }
+
+    bool DecodeIndexBuffer(void* destination, IndexType type, Uint64 indexCount,
+                           const Uint8* source, Uint64 sourceSize)
+    {
+        if (destination == nullptr || source == nullptr || indexCount % 3 != 0)
+            return false;
+
+        if (sourceSize == 0 || source[0] != IndexCodecVersion)
+            return false;
+
+        const Uint8* data = source + 1;
+        const Uint8* end = source + sourceSize;
+
+        IndexCodecState state = {};
+
+        for (Uint64 i = 0; i < indexCount; i += 3)
+        {
+            if (data == end)
+                return false;
+
+            Uint8 code = *data++;
+            Uint8 edge = code >> 4;
+
+            Uint32 a, b, c;
+
+            if (edge != NoEdgeCode)
+            {
+                if (edge >= state.EdgesOffset)
+                    return false;
+
+                a = state.GetEdge(edge)[0];
+                b = state.GetEdge(edge)[1];
+
+                if (!state.DecodeVertex(code & 0x0F, data, end, c))
+                    return false;
+            }
+
+            else
+            {
+                if (data == end)
+                    return false;
+
+                Uint8 codes = *data++;
+
+                if (!state.DecodeVertex(code & 0x0F, data, end, a) ||
+                    !state.DecodeVertex(codes >> 4, data, end, b) ||
+                    !state.DecodeVertex(codes & 0x0F, data, end, c))
+                    return false;
+            }
+
+            IndexBuffer::WriteIndex(destination, type, i + 0, a);
+            IndexBuffer::WriteIndex(destination, type, i + 1, b);
+            IndexBuffer::WriteIndex(destination, type, i + 2, c);
+
+            state.PushTriangle(a, b, c);
+        }
+
+        return data == end;
+    }
+
+    bool DecodeIndexBuffer(IndexBuffer::Desc& description, const Uint8* source, Uint64 sourceSize)
+    {
+        return DecodeIndexBuffer(description.Indices, description.IndexType, description.IndexCount,
+                                 source, sourceSize);
+    }
+
+    Uint16 QuantizeHalf(Float32 value)
+    {
+        Uint32 bits;
+        CopyMemory(&bits, &value, sizeof(bits));
+
+        Uint32 sign = (bits >> 16) & 0x8000;
+        Int32 exponent = static_cast<Int32>((bits >> 23) & 0xFF) - 127 + 15;
+        Uint32 mantissa = bits & 0x7FFFFF;
+
+        // NaN and infinity
+        if (((bits >> 23) & 0xFF) == 0xFF)
+            return static_cast<Uint16>(sign | 0x7C00 | ((mantissa != 0) ? 0x200 : 0));
+
+        if (exponent >= 31)
+            return static_cast<Uint16>(sign | 0x7C00);
+
+        // Denormalized halves (and zero)
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+                return static_cast<Uint16>(sign);
+
+            mantissa |= 0x800000;
+            Uint32 shift = static_cast<Uint32>(14 - exponent);
+
+            return static_cast<Uint16>(sign | ((mantissa + (1u << (shift - 1))) >> shift));
+        }
+
+        // Rounding to nearest may carry into exponent, which is still correct
+        return static_cast<Uint16>(sign | ((static_cast<Uint32>(exponent) << 10) + ((mantissa + 0x1000) >> 13)));
+    }
+
+    Float32 DequantizeHalf(Uint16 value)
+    {
+        Uint32 sign = static_cast<Uint32>(value & 0x8000) << 16;
+        Uint32 exponent = (value >> 10) & 0x1F;
+        Uint32 mantissa = value & 0x3FF;
+
+        Float32 result;
+
+        if (exponent == 0)
+            result = ldexpf(static_cast<Float32>(mantissa), -24);
+
+        else if (exponent == 31)
+            result = (mantissa == 0) ? INFINITY : NAN;
+
+        else
+            result = ldexpf(static_cast<Float32>(mantissa | 0x400), static_cast<Int32>(exponent) - 25);
+
+        return (sign != 0) ? -result : result;
+    }
+
+    Uint8 QuantizeUnorm8(Float32 value)
+    {
+        value = MIN(MAX(value, 0.0f), 1.0f);
+        return static_cast<Uint8>(value * 255.0f + 0.5f);
+    }
+
+    Uint16 QuantizeUnorm16(Float32 value)
+    {
+        value = MIN(MAX(value, 0.0f), 1.0f);
+        return static_cast<Uint16>(value * 65535.0f + 0.5f);
+    }
+
+    Int16 QuantizeSnorm16(Float32 value)
+    {
+        value = MIN(MAX(value, -1.0f), 1.0f);
+        return static_cast<Int16>(value * 32767.0f + ((value >= 0.0f) ? 0.5f : -0.5f));
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    // Vertex stream is split into blocks of vertices. Every byte of vertex is delta-encoded against
+    // the same byte of the previous vertex and deltas are packed by groups of 16 with 0, 2, 4 or 8 bits per delta.
+    // Decoder is SIMD (SSSE3) and works straight into the memory given to CreateVertexBuffer.
+    // Quantizing attributes before encoding (see below) makes deltas much smaller
+
+    Uint64 GetVertexBufferEncodeBound(Uint64 vertexCount, Uint64 vertexSize);
+
+    // Returns the size of encoded data or 0 if destination is too small
+    Uint64 EncodeVertexBuffer(Uint8* destination, Uint64 destinationSize,
+                              const void* vertices, Uint64 vertexCount, Uint64 vertexSize);
+
+    bool DecodeVertexBuffer(void* destination, Uint64 vertexCount, Uint64 vertexSize,
+                            const Uint8* source, Uint64 sourceSize);
+
+    // Decodes into description.Vertices (VertexCount and VertexSize have to be set)
+    bool DecodeVertexBuffer(VertexBuffer::Desc& description, const Uint8* source, Uint64 sourceSize);
+
+    // Index stream is a triangle list encoded with FIFO of recent edges and FIFO of recent vertices,
+    // so triangles which share an edge with one of recent triangles take 1 or 2 bytes.
+    // It's the best after OptimizeVertexCache and OptimizeVertexFetch (see MeshOptimizer.h)
+
+    Uint64 GetIndexBufferEncodeBound(Uint64 indexCount);
+
+    Uint64 EncodeIndexBuffer(Uint8* destination, Uint64 destinationSize, const IndexBuffer::Desc& indices);
+
+    bool DecodeIndexBuffer(void* destination, IndexType type, Uint64 indexCount,
+                           const Uint8* source, Uint64 sourceSize);
+
+    // Decodes into description.Indices (IndexCount and IndexType have to be set)
+    bool DecodeIndexBuffer(IndexBuffer::Desc& description, const Uint8* source, Uint64 sourceSize);
+
+    // Attribute quantization
+
+    Uint16 QuantizeHalf(Float32 value);
+    Float32 DequantizeHalf(Uint16 value);
+
+    Uint8 QuantizeUnorm8(Float32 value);
+    Uint16 QuantizeUnorm16(Float32 value);
+    Int16 QuantizeSnorm16(Float32 value);
+}
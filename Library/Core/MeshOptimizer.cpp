@@ -0,0 +1,681 @@
+#include "MeshOptimizer.h"
+#include "VertexFormat.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        template <typename t>
+        t* AllocateArray(Allocator* allocator, Uint64 count)
+        {
+            return reinterpret_cast<t*>(allocator->AllocateMemory(MAX(count, 1) * sizeof(t)));
+        }
+
+        bool IsTriangleList(const IndexBuffer::Desc& indices)
+        {
+            return indices.Indices != nullptr && indices.IndexCount != 0 && indices.IndexCount % 3 == 0;
+        }
+
+        // Copies indices into 32-bit array, returns nullptr if some index is out of range
+        Uint32* ReadIndices(const IndexBuffer::Desc& indices, Uint64 vertexCount, Allocator* allocator)
+        {
+            auto result = AllocateArray<Uint32>(allocator, indices.IndexCount);
+
+            for (Uint64 i = 0; i < indices.IndexCount; i++)
+            {
+                result[i] = IndexBuffer::ReadIndex(indices.Indices, indices.IndexType, i);
+
+                if (result[i] >= vertexCount)
+                {
+                    allocator->FreeMemory(result);
+                    return nullptr;
+                }
+            }
+
+            return result;
+        }
+
+        void WriteIndices(IndexBuffer::Desc& indices, const Uint32* source)
+        {
+            for (Uint64 i = 0; i < indices.IndexCount; i++)
+                IndexBuffer::WriteIndex(indices.Indices, indices.IndexType, i, source[i]);
+        }
+
+        // Returns the count of cache misses for the triangle and puts it into FIFO cache
+        Uint32 SimulateTriangle(const Uint32* triangle, Uint32* cacheStamps, Uint32& time, Uint64 cacheSize)
+        {
+            Uint32 misses = 0;
+
+            for (Uint64 j = 0; j < 3; j++)
+            {
+                Uint32 vertex = triangle[j];
+
+                if (time - cacheStamps[vertex] > cacheSize)
+                {
+                    cacheStamps[vertex] = time;
+                    time++;
+                    misses++;
+                }
+            }
+
+            return misses;
+        }
+
+        struct ClusterSortKey
+        {
+            Float32 Key;
+            Uint32 Cluster;
+        };
+
+        Int32 CompareClusterSortKeys(const void* first, const void* second)
+        {
+            Float32 firstKey = reinterpret_cast<const ClusterSortKey*>(first)->Key;
+            Float32 secondKey = reinterpret_cast<const ClusterSortKey*>(second)->Key;
+
+            return (firstKey < secondKey) - (firstKey > secondKey);
+        }
+
+        void ResetCache(Uint32* cacheStamps, Uint64 vertexCount, Uint32& time, Uint64 cacheSize)
+        {
+            ZeroMemory(cacheStamps, vertexCount * sizeof(Uint32));
+            time = static_cast<Uint32>(cacheSize) + 1;
+        }
+
+        Uint32 GetNextVertex(Uint64 vertexCount, Uint64& cursor, Uint64 cacheSize,
+                             const Uint32* candidates, Uint64 candidatesCount,
+                             const Uint32* cacheStamps, Uint32 time, const Uint32* liveTriangles,
+                             const Uint32* deadEnd, Uint64& deadEndSize)
+        {
+            Uint32 best = ~0u;
+            Int64 bestPriority = -1;
+
+            for (Uint64 i = 0; i < candidatesCount; i++)
+            {
+                Uint32 vertex = candidates[i];
+
+                if (liveTriangles[vertex] == 0)
+                    continue;
+
+                Int64 priority = 0;
+
+                // Vertex stays in cache after all of its triangles are emitted
+                if (time - cacheStamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+                    priority = time - cacheStamps[vertex];
+
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    best = vertex;
+                }
+            }
+
+            if (best != ~0u)
+                return best;
+
+            while (deadEndSize > 0)
+            {
+                Uint32 vertex = deadEnd[--deadEndSize];
+
+                if (liveTriangles[vertex] > 0)
+                    return vertex;
+            }
+
+            while (cursor < vertexCount)
+            {
+                if (liveTriangles[cursor] > 0)
+                    return static_cast<Uint32>(cursor);
+
+                cursor++;
+            }
+
+            return ~0u;
+        }
+    }
+
+    VertexCacheStatistics AnalyzeVertexCache(const IndexBuffer::Desc& indices, Uint64 vertexCount,
+                                             Uint64 cacheSize, Allocator* allocator)
+    {
+        VertexCacheStatistics statistics = {};
+
+        if (!IsTriangleList(indices) || vertexCount == 0 || allocator == nullptr)
+            return statistics;
+
+        Uint32* indexData = ReadIndices(indices, vertexCount, allocator);
+
+        if (indexData == nullptr)
+            return statistics;
+
+        auto cacheStamps = AllocateArray<Uint32>(allocator, vertexCount);
+        auto used = AllocateArray<Uint8>(allocator, vertexCount);
+
+        Uint32 time;
+        ResetCache(cacheStamps, vertexCount, time, cacheSize);
+        ZeroMemory(used, vertexCount);
+
+        Uint64 usedVertices = 0;
+
+        for (Uint64 i = 0; i < indices.IndexCount; i += 3)
+        {
+            statistics.VerticesTransformed += SimulateTriangle(indexData + i, cacheStamps, time, cacheSize);
+
+            for (Uint64 j = 0; j < 3; j++)
+            {
+                usedVertices += (used[indexData[i + j]] == 0) ? 1 : 0;
+                used[indexData[i + j]] = 1;
+            }
+        }
+
+        statistics.ACMR = static_cast<Float32>(statistics.VerticesTransformed) / static_cast<Float32>(indices.IndexCount / 3);
+        statistics.ATVR = static_cast<Float32>(statistics.VerticesTransformed) / static_cast<Float32>(usedVertices);
+
+        allocator->FreeMemory(used);
+        allocator->FreeMemory(cacheStamps);
+        allocator->FreeMemory(indexData);
+
+        return statistics;
+    }
+
+    bool OptimizeVertexCache(IndexBuffer::Desc& indices, Uint64 vertexCount,
+                             Uint64 cacheSize, Allocator* allocator)
+    {
+        if (!IsTriangleList(indices) || vertexCount == 0 || cacheSize < 3 || allocator == nullptr)
+            return false;
+
+        Uint32* indexData = ReadIndices(indices, vertexCount, allocator);
+
+        if (indexData == nullptr)
+            return false;
+
+        Uint64 triangleCount = indices.IndexCount / 3;
+
+        // Vertex -> triangles adjacency (offsets are prefix sums of triangle counts)
+        auto liveTriangles = AllocateArray<Uint32>(allocator, vertexCount);
+        auto adjacencyOffsets = AllocateArray<Uint32>(allocator, vertexCount + 1);
+        auto adjacency = AllocateArray<Uint32>(allocator, indices.IndexCount);
+
+        ZeroMemory(liveTriangles, vertexCount * sizeof(Uint32));
+
+        for (Uint64 i = 0; i < indices.IndexCount; i++)
+            liveTriangles[indexData[i]]++;
+
+        adjacencyOffsets[0] = 0;
+        for (Uint64 i = 0; i < vertexCount; i++)
+            adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+
+        auto adjacencyFill = AllocateArray<Uint32>(allocator, vertexCount);
+        CopyMemory(adjacencyFill, adjacencyOffsets, vertexCount * sizeof(Uint32));
+
+        for (Uint64 i = 0; i < indices.IndexCount; i++)
+            adjacency[adjacencyFill[indexData[i]]++] = static_cast<Uint32>(i / 3);
+
+        auto cacheStamps = AllocateArray<Uint32>(allocator, vertexCount);
+        auto emitted = AllocateArray<Uint8>(allocator, triangleCount);
+        auto deadEnd = AllocateArray<Uint32>(allocator, indices.IndexCount);
+        auto candidates = AllocateArray<Uint32>(allocator, indices.IndexCount);
+        auto result = AllocateArray<Uint32>(allocator, indices.IndexCount);
+
+        Uint32 time;
+        ResetCache(cacheStamps, vertexCount, time, cacheSize);
+        ZeroMemory(emitted, triangleCount);
+
+        Uint64 deadEndSize = 0;
+        Uint64 resultSize = 0;
+        Uint64 cursor = 0;
+
+        Uint32 fanningVertex = 0;
+        while (fanningVertex < vertexCount && liveTriangles[fanningVertex] == 0)
+            fanningVertex++;
+
+        while (fanningVertex < vertexCount)
+        {
+            Uint64 candidatesCount = 0;
+
+            for (Uint32 k = adjacencyOffsets[fanningVertex]; k < adjacencyOffsets[fanningVertex + 1]; k++)
+            {
+                Uint32 triangle = adjacency[k];
+
+                if (emitted[triangle] != 0)
+                    continue;
+
+                for (Uint64 j = 0; j < 3; j++)
+                {
+                    Uint32 vertex = indexData[triangle * 3 + j];
+
+                    result[resultSize++] = vertex;
+                    deadEnd[deadEndSize++] = vertex;
+                    candidates[candidatesCount++] = vertex;
+
+                    liveTriangles[vertex]--;
+
+                    if (time - cacheStamps[vertex] > cacheSize)
+                    {
+                        cacheStamps[vertex] = time;
+                        time++;
+                    }
+                }
+
+                emitted[triangle] = 1;
+            }
+
+            fanningVertex = GetNextVertex(vertexCount, cursor, cacheSize, candidates, candidatesCount,
+                                          cacheStamps, time, liveTriangles, deadEnd, deadEndSize);
+        }
+
+        WriteIndices(indices, result);
+
+        allocator->FreeMemory(result);
+        allocator->FreeMemory(candidates);
+        allocator->FreeMemory(deadEnd);
+        allocator->FreeMemory(emitted);
+        allocator->FreeMemory(cacheStamps);
+        allocator->FreeMemory(adjacencyFill);
+        allocator->FreeMemory(adjacency);
+        allocator->FreeMemory(adjacencyOffsets);
+        allocator->FreeMemory(liveTriangles);
+        allocator->FreeMemory(indexData);
+
+        return true;
+    }
+
+    bool OptimizeOverdraw(IndexBuffer::Desc& indices, const VertexBuffer::Desc& vertices, Uint64 positionElement,
+                          Uint64 cacheSize, Float32 threshold, Allocator* allocator)
+    {
+        if (!IsTriangleList(indices) || vertices.Vertices == nullptr || allocator == nullptr)
+            return false;
+
+        if (positionElement >= vertices.Layout.Count)
+            return false;
+
+        const VertexInputElement& position = vertices.Layout.Inputs[positionElement];
+
+        if (position.Type != DataTypes::Float32 || position.Count < 3)
+            return false;
+
+        Uint64 positionOffset = GetVertexElementOffset(vertices.Layout, positionElement);
+        Uint64 vertexSize = (vertices.VertexSize != 0) ? vertices.VertexSize : GetPackedVertexSize(vertices.Layout);
+
+        Uint32* indexData = ReadIndices(indices, vertices.VertexCount, allocator);
+
+        if (indexData == nullptr)
+            return false;
+
+        Uint64 triangleCount = indices.IndexCount / 3;
+
+        auto cacheStamps = AllocateArray<Uint32>(allocator, vertices.VertexCount);
+        auto misses = AllocateArray<Uint32>(allocator, triangleCount);
+        auto clusters = AllocateArray<Uint32>(allocator, triangleCount + 1);
+
+        Uint32 time;
+        ResetCache(cacheStamps, vertices.VertexCount, time, cacheSize);
+
+        // Hard boundaries are the places where optimizer restarted from a new vertex (all of vertices miss)
+        Uint64 hardCount = 0;
+
+        for (Uint64 i = 0; i < triangleCount; i++)
+        {
+            misses[i] = SimulateTriangle(indexData + i * 3, cacheStamps, time, cacheSize);
+
+            if (i == 0 || misses[i] == 3)
+                clusters[hardCount++] = static_cast<Uint32>(i);
+        }
+
+        clusters[hardCount] = static_cast<Uint32>(triangleCount);
+
+        // Soft boundaries split hard clusters while local miss ratio is still good enough
+        auto softClusters = AllocateArray<Uint32>(allocator, triangleCount + 1);
+        Uint64 clusterCount = 0;
+
+        for (Uint64 c = 0; c < hardCount; c++)
+        {
+            Uint32 start = clusters[c], end = clusters[c + 1];
+
+            Uint64 clusterMisses = 0;
+            for (Uint32 i = start; i < end; i++)
+                clusterMisses += misses[i];
+
+            Float32 clusterThreshold = threshold * static_cast<Float32>(clusterMisses) / static_cast<Float32>(end - start);
+
+            ResetCache(cacheStamps, vertices.VertexCount, time, cacheSize);
+            softClusters[clusterCount++] = start;
+
+            Uint64 runMisses = 0, runTriangles = 0;
+
+            for (Uint32 i = start; i < end; i++)
+            {
+                runMisses += SimulateTriangle(indexData + i * 3, cacheStamps, time, cacheSize);
+                runTriangles++;
+
+                if (i + 1 < end && runTriangles >= 4 &&
+                    static_cast<Float32>(runMisses) / static_cast<Float32>(runTriangles) <= clusterThreshold)
+                {
+                    softClusters[clusterCount++] = i + 1;
+                    ResetCache(cacheStamps, vertices.VertexCount, time, cacheSize);
+
+                    runMisses = 0;
+                    runTriangles = 0;
+                }
+            }
+        }
+
+        softClusters[clusterCount] = static_cast<Uint32>(triangleCount);
+
+        auto readPosition = [&](Uint32 vertex, Float32* result)
+        {
+            const Uint8* data = reinterpret_cast<const Uint8*>(vertices.Vertices) + vertex * vertexSize + positionOffset;
+            CopyMemory(result, data, 3 * sizeof(Float32));
+        };
+
+        // Area-weighted center and normal of each cluster, mesh center is the center of all clusters
+        auto sortKeys = AllocateArray<ClusterSortKey>(allocator, clusterCount);
+        auto clusterData = AllocateArray<Float32>(allocator, clusterCount * 7);
+
+        Float32 meshCenter[3] = {0.0f, 0.0f, 0.0f};
+        Float32 meshArea = 0.0f;
+
+        for (Uint64 c = 0; c < clusterCount; c++)
+        {
+            Float32* data = clusterData + c * 7;
+            ZeroMemory(data, 7 * sizeof(Float32));
+
+            for (Uint32 i = softClusters[c]; i < softClusters[c + 1]; i++)
+            {
+                Float32 a[3], b[3], d[3];
+                readPosition(indexData[i * 3 + 0], a);
+                readPosition(indexData[i * 3 + 1], b);
+                readPosition(indexData[i * 3 + 2], d);
+
+                Float32 e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+                Float32 e2[3] = {d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+
+                Float32 normal[3] = {
+                        e1[1] * e2[2] - e1[2] * e2[1],
+                        e1[2] * e2[0] - e1[0] * e2[2],
+                        e1[0] * e2[1] - e1[1] * e2[0],
+                };
+
+                Float32 area = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                for (Uint64 k = 0; k < 3; k++)
+                {
+                    data[k] += (a[k] + b[k] + d[k]) / 3.0f * area;
+                    data[3 + k] += normal[k];
+                }
+
+                data[6] += area;
+            }
+
+            for (Uint64 k = 0; k < 3; k++)
+                meshCenter[k] += data[k];
+
+            meshArea += data[6];
+        }
+
+        for (Uint64 k = 0; k < 3; k++)
+            meshCenter[k] = (meshArea > 0.0f) ? meshCenter[k] / meshArea : 0.0f;
+
+        for (Uint64 c = 0; c < clusterCount; c++)
+        {
+            Float32* data = clusterData + c * 7;
+
+            Float32 normalLength = sqrtf(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+            Float32 area = (data[6] > 0.0f) ? data[6] : 1.0f;
+            normalLength = (normalLength > 0.0f) ? normalLength : 1.0f;
+
+            sortKeys[c].Cluster = static_cast<Uint32>(c);
+            sortKeys[c].Key = 0.0f;
+
+            for (Uint64 k = 0; k < 3; k++)
+                sortKeys[c].Key += (data[k] / area - meshCenter[k]) * data[3 + k] / normalLength;
+        }
+
+        // Clusters which look outwards from the center are drawn first
+        qsort(sortKeys, clusterCount, sizeof(ClusterSortKey), CompareClusterSortKeys);
+
+        auto result = AllocateArray<Uint32>(allocator, indices.IndexCount);
+        Uint64 resultSize = 0;
+
+        for (Uint64 c = 0; c < clusterCount; c++)
+        {
+            Uint32 cluster = sortKeys[c].Cluster;
+            Uint64 size = (softClusters[cluster + 1] - softClusters[cluster]) * 3;
+
+            CopyMemory(result + resultSize, indexData + softClusters[cluster] * 3, size * sizeof(Uint32));
+            resultSize += size;
+        }
+
+        WriteIndices(indices, result);
+
+        allocator->FreeMemory(result);
+        allocator->FreeMemory(clusterData);
+        allocator->FreeMemory(sortKeys);
+        allocator->FreeMemory(softClusters);
+        allocator->FreeMemory(clusters);
+        allocator->FreeMemory(misses);
+        allocator->FreeMemory(cacheStamps);
+        allocator->FreeMemory(indexData);
+
+        return true;
+    }
+
+    bool OptimizeVertexFetch(VertexBuffer::Desc& vertices, IndexBuffer::Desc& indices, Allocator* allocator)
+    {
+        if (!IsTriangleList(indices) || vertices.Vertices == nullptr || allocator == nullptr)
+            return false;
+
+        Uint64 vertexSize = (vertices.VertexSize != 0) ? vertices.VertexSize : GetPackedVertexSize(vertices.Layout);
+
+        if (vertexSize == 0)
+            return false;
+
+        Uint32* indexData = ReadIndices(indices, vertices.VertexCount, allocator);
+
+        if (indexData == nullptr)
+            return false;
+
+        auto remap = AllocateArray<Uint32>(allocator, vertices.VertexCount);
+        SetMemory(remap, vertices.VertexCount * sizeof(Uint32), 0xFF);
+
+        auto newVertices = AllocateArray<Uint8>(allocator, vertices.VertexCount * vertexSize);
+        const Uint8* oldVertices = reinterpret_cast<const Uint8*>(vertices.Vertices);
+
+        Uint32 nextVertex = 0;
+
+        for (Uint64 i = 0; i < indices.IndexCount; i++)
+        {
+            Uint32 vertex = indexData[i];
+
+            if (remap[vertex] == ~0u)
+            {
+                CopyMemory(newVertices + nextVertex * vertexSize, oldVertices + vertex * vertexSize, vertexSize);
+                remap[vertex] = nextVertex++;
+            }
+
+            indexData[i] = remap[vertex];
+        }
+
+        CopyMemory(vertices.Vertices, newVertices, nextVertex * vertexSize);
+        vertices.VertexCount = nextVertex;
+
+        WriteIndices(indices, indexData);
+
+        allocator->FreeMemory(newVertices);
+        allocator->FreeMemory(remap);
+        allocator->FreeMemory(indexData);
+
+        return true;
+    }
+
+    MeshOptimizationReport OptimizeMesh(VertexBuffer::Desc& vertices, IndexBuffer::Desc& indices,
+                                        const MeshOptimizationSettings& settings, Allocator* allocator)
+    {
+        MeshOptimizationReport report = {};
+
+        report.Before = AnalyzeVertexCache(indices, vertices.VertexCount, settings.CacheSize, allocator);
+
+        if (report.Before.VerticesTransformed == 0)
+            return report;
+
+        report.Succeeded = true;
+
+        if (settings.OptimizeVertexCache)
+            report.Succeeded &= OptimizeVertexCache(indices, vertices.VertexCount, settings.CacheSize, allocator);
+
+        if (settings.OptimizeOverdraw && report.Succeeded)
+            report.Succeeded &= OptimizeOverdraw(indices, vertices, settings.PositionElement, settings.CacheSize,
+                                                 settings.OverdrawThreshold, allocator);
+
+        if (settings.OptimizeVertexFetch && report.Succeeded)
+            report.Succeeded &= OptimizeVertexFetch(vertices, indices, allocator);
+
+        report.After = AnalyzeVertexCache(indices, vertices.VertexCount, settings.CacheSize, allocator);
+
+        return report;
+    }
+
+    Uint32 FindMaxIndex(const void* indices, IndexType type, Uint64 count)
+    {
+        if (indices == nullptr || count == 0)
+            return 0;
+
+        const Uint8* data = reinterpret_cast<const Uint8*>(indices);
+        Uint64 indexSize = IndexBuffer::GetIndexSize(type);
+        Uint64 lanes = 32 / indexSize;
+
+        __m256i maxSequence = _mm256_setzero_si256();
+        Uint64 i = 0;
+
+        for (; i + lanes <= count; i += lanes)
+        {
+            __m256i sequence = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * indexSize));
+
+            switch (type)
+            {
+                case IndexType::UnsignedByteIndex:
+                    maxSequence = _mm256_max_epu8(maxSequence, sequence);
+                    break;
+
+                case IndexType::UnsignedShortIndex:
+                    maxSequence = _mm256_max_epu16(maxSequence, sequence);
+                    break;
+
+                default:
+                    maxSequence = _mm256_max_epu32(maxSequence, sequence);
+                    break;
+            }
+        }
+
+        alignas(32) Uint8 lanesData[32];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanesData), maxSequence);
+
+        Uint32 maxIndex = 0;
+
+        for (Uint64 j = 0; j < lanes; j++)
+            maxIndex = MAX(maxIndex, IndexBuffer::ReadIndex(lanesData, type, j));
+
+        for (; i < count; i++)
+            maxIndex = MAX(maxIndex, IndexBuffer::ReadIndex(indices, type, i));
+
+        return maxIndex;
+    }
+
+    IndexType GetNarrowestIndexType(Uint32 maxIndex)
+    {
+        if (maxIndex <= 0xFFFF)
+            return IndexType::UnsignedShortIndex;
+
+        return IndexType::UnsignedIntIndex;
+    }
+
+    void ConvertIndices(const void* source, IndexType sourceType, void* destination, IndexType destinationType,
+                        Uint64 count)
+    {
+        if (source == nullptr || destination == nullptr)
+            return;
+
+        if (sourceType == IndexType::UnsignedIntIndex && destinationType == IndexType::UnsignedShortIndex)
+        {
+            const Uint32* sourceIndices = reinterpret_cast<const Uint32*>(source);
+            Uint16* destinationIndices = reinterpret_cast<Uint16*>(destination);
+
+            // Packing with unsigned saturation is fine because all of indices fit into 16 bits
+            Uint64 i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sourceIndices + i));
+                __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sourceIndices + i + 8));
+
+                __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), 0xD8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destinationIndices + i), packed);
+            }
+
+            for (; i < count; i++)
+                destinationIndices[i] = static_cast<Uint16>(sourceIndices[i]);
+
+            return;
+        }
+
+        for (Uint64 i = 0; i < count; i++)
+            IndexBuffer::WriteIndex(destination, destinationType, i, IndexBuffer::ReadIndex(source, sourceType, i));
+    }
+
+    Uint64 SplitIndexRanges(const IndexBuffer::Desc& indices, Uint16* destination,
+                            IndexBuffer::Range* ranges, Uint64 maxRanges)
+    {
+        if (!IsTriangleList(indices) || destination == nullptr || ranges == nullptr || maxRanges == 0)
+            return 0;
+
+        Uint64 rangesCount = 0;
+        Uint64 rangeStart = 0;
+        Uint32 rangeMin = ~0u, rangeMax = 0;
+
+        auto closeRange = [&](Uint64 rangeEnd)
+        {
+            for (Uint64 i = rangeStart; i < rangeEnd; i++)
+                destination[i] = static_cast<Uint16>(IndexBuffer::ReadIndex(indices.Indices, indices.IndexType, i) - rangeMin);
+
+            ranges[rangesCount] = {rangeStart, rangeEnd - rangeStart, static_cast<Int64>(rangeMin)};
+            rangesCount++;
+        };
+
+        for (Uint64 i = 0; i < indices.IndexCount; i += 3)
+        {
+            Uint32 triangleMin = ~0u, triangleMax = 0;
+
+            for (Uint64 j = 0; j < 3; j++)
+            {
+                Uint32 index = IndexBuffer::ReadIndex(indices.Indices, indices.IndexType, i + j);
+
+                triangleMin = MIN(triangleMin, index);
+                triangleMax = MAX(triangleMax, index);
+            }
+
+            if (triangleMax - triangleMin > 0xFFFF)
+                return 0;
+
+            Uint32 newMin = MIN(rangeMin, triangleMin);
+            Uint32 newMax = MAX(rangeMax, triangleMax);
+
+            if (newMax - newMin > 0xFFFF)
+            {
+                if (rangesCount + 1 == maxRanges)
+                    return 0;
+
+                closeRange(i);
+
+                rangeStart = i;
+                newMin = triangleMin;
+                newMax = triangleMax;
+            }
+
+            rangeMin = newMin;
+            rangeMax = newMax;
+        }
+
+        closeRange(indices.IndexCount);
+
+        return rangesCount;
+    }
+}
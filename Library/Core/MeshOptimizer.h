@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    // All of the functions work with triangle lists and change buffers of given descriptions in place,
+    // so they can be called right before CreateVertexBuffer/CreateIndexBuffer or in an offline bake.
+    // Allocator is used only for temporary memory
+
+    struct VertexCacheStatistics
+    {
+        Uint64 VerticesTransformed;
+
+        // Average cache miss ratio (transformed vertices per triangle, 0.5 is the best one)
+        Float32 ACMR;
+
+        // Average transform to vertex ratio (transformed vertices per used vertex, 1.0 is the best one)
+        Float32 ATVR;
+    };
+
+    struct MeshOptimizationSettings
+    {
+        // Size of simulated FIFO post-transform cache
+        Uint64 CacheSize = 16;
+
+        // Clusters may make cache efficiency worse by this factor to get better overdraw
+        Float32 OverdrawThreshold = 1.05f;
+
+        // Element of vertex layout with positions (it has to be 3 or 4 Float32 components)
+        Uint64 PositionElement = 0;
+
+        bool OptimizeVertexCache = true;
+        bool OptimizeOverdraw = true;
+        bool OptimizeVertexFetch = true;
+    };
+
+    struct MeshOptimizationReport
+    {
+        bool Succeeded;
+
+        VertexCacheStatistics Before;
+        VertexCacheStatistics After;
+    };
+
+    VertexCacheStatistics AnalyzeVertexCache(const IndexBuffer::Desc& indices, Uint64 vertexCount,
+                                             Uint64 cacheSize, Allocator* allocator);
+
+    // Tipsify (Sander et al. 2007) triangle ordering for FIFO post-transform cache
+    bool OptimizeVertexCache(IndexBuffer::Desc& indices, Uint64 vertexCount,
+                             Uint64 cacheSize, Allocator* allocator);
+
+    // Splits cache-ordered triangles into clusters and sorts them by their orientation relative to mesh center,
+    // so outer faces are drawn first. It should be called after OptimizeVertexCache
+    bool OptimizeOverdraw(IndexBuffer::Desc& indices, const VertexBuffer::Desc& vertices, Uint64 positionElement,
+                          Uint64 cacheSize, Float32 threshold, Allocator* allocator);
+
+    // Lays vertices out in order of the first use and remaps indices. Unused vertices are removed
+    // (VertexCount of description is changed)
+    bool OptimizeVertexFetch(VertexBuffer::Desc& vertices, IndexBuffer::Desc& indices, Allocator* allocator);
+
+    MeshOptimizationReport OptimizeMesh(VertexBuffer::Desc& vertices, IndexBuffer::Desc& indices,
+                                        const MeshOptimizationSettings& settings, Allocator* allocator);
+
+    // Maximal index with SIMD reduction
+    Uint32 FindMaxIndex(const void* indices, IndexType type, Uint64 count);
+
+    // The narrowest type for indices up to maxIndex. Byte indices aren't chosen
+    // because most of the hardware doesn't support them and drivers convert them on every draw
+    IndexType GetNarrowestIndexType(Uint32 maxIndex);
+
+    void ConvertIndices(const void* source, IndexType sourceType, void* destination, IndexType destinationType,
+                        Uint64 count);
+
+    // Splits triangle list into ranges where indices differ less than 65536, so each range can be stored
+    // in 16-bit indices relative to its base vertex. Returns the count of ranges or 0 if there are more than maxRanges
+    Uint64 SplitIndexRanges(const IndexBuffer::Desc& indices, Uint16* destination,
+                            IndexBuffer::Range* ranges, Uint64 maxRanges);
+}
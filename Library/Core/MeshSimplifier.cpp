@@ -0,0 +1,529 @@
+#include "MeshSimplifier.h"
+#include "VertexFormat.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        template <typename t>
+        t* AllocateArray(Allocator* allocator, Uint64 count)
+        {
+            return reinterpret_cast<t*>(allocator->AllocateMemory(MAX(count, 1) * sizeof(t)));
+        }
+
+        // Symmetric 4x4 matrix of plane equations, error(p) = p*A*p + 2*b*p + c
+        struct Quadric
+        {
+            Float64 A00, A01, A02, A11, A12, A22;
+            Float64 B0, B1, B2;
+            Float64 C;
+        };
+
+        void MakePlaneQuadric(Quadric& quadric, const Float32* p0, const Float32* p1, const Float32* p2)
+        {
+            Float64 e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            Float64 e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+            Float64 n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            Float64 length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            memset(&quadric, 0, sizeof(Quadric));
+
+            if (length == 0.0)
+                return;
+
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+
+            Float64 d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+
+            quadric.A00 = n[0] * n[0];
+            quadric.A01 = n[0] * n[1];
+            quadric.A02 = n[0] * n[2];
+            quadric.A11 = n[1] * n[1];
+            quadric.A12 = n[1] * n[2];
+            quadric.A22 = n[2] * n[2];
+            quadric.B0 = n[0] * d;
+            quadric.B1 = n[1] * d;
+            quadric.B2 = n[2] * d;
+            quadric.C = d * d;
+        }
+
+        void AddQuadric(Quadric& destination, const Quadric& source)
+        {
+            destination.A00 += source.A00;
+            destination.A01 += source.A01;
+            destination.A02 += source.A02;
+            destination.A11 += source.A11;
+            destination.A12 += source.A12;
+            destination.A22 += source.A22;
+            destination.B0 += source.B0;
+            destination.B1 += source.B1;
+            destination.B2 += source.B2;
+            destination.C += source.C;
+        }
+
+        // Error of the point for the sum of two quadrics
+        Float64 EvaluateQuadrics(const Quadric& first, const Quadric& second, const Float32* p)
+        {
+            Float64 x = p[0], y = p[1], z = p[2];
+
+            Float64 a00 = first.A00 + second.A00, a01 = first.A01 + second.A01, a02 = first.A02 + second.A02;
+            Float64 a11 = first.A11 + second.A11, a12 = first.A12 + second.A12, a22 = first.A22 + second.A22;
+
+            Float64 error = a00 * x * x + a11 * y * y + a22 * z * z +
+                            2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                            2.0 * ((first.B0 + second.B0) * x + (first.B1 + second.B1) * y + (first.B2 + second.B2) * z) +
+                            first.C + second.C;
+
+            return (error > 0.0) ? error : 0.0;
+        }
+
+        void GetTriangleNormal(const Float32* p0, const Float32* p1, const Float32* p2, Float32* normal)
+        {
+            Float32 e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            Float32 e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+            normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+
+        struct Collapse
+        {
+            Float64 Cost;
+            Uint32 From;
+            Uint32 To;
+        };
+
+        Int32 CompareCollapses(const void* first, const void* second)
+        {
+            Float64 firstCost = reinterpret_cast<const Collapse*>(first)->Cost;
+            Float64 secondCost = reinterpret_cast<const Collapse*>(second)->Cost;
+
+            return (firstCost > secondCost) - (firstCost < secondCost);
+        }
+
+        Int32 CompareEdges(const void* first, const void* second)
+        {
+            Uint64 firstEdge = *reinterpret_cast<const Uint64*>(first);
+            Uint64 secondEdge = *reinterpret_cast<const Uint64*>(second);
+
+            return (firstEdge > secondEdge) - (firstEdge < secondEdge);
+        }
+
+        // Working state of simplification, it can be continued with smaller targets to get the next levels
+        struct Simplifier
+        {
+            Allocator* Memory;
+
+            Uint64 VertexCount;
+            Float32* Positions;
+            Quadric* Quadrics;
+            bool* Locked;
+
+            Uint32* Indices;
+            Uint64 IndexCount;
+
+            Float64 MaxCost;
+
+            // Temporary arrays which live during the whole simplification
+            Uint32* Remap;
+            bool* Touched;
+            Uint32* AdjacencyOffsets;
+            Uint32* Adjacency;
+            Collapse* Collapses;
+        };
+
+        bool InitializeSimplifier(Simplifier& simplifier, const IndexBuffer::Desc& indices,
+                                  const VertexBuffer::Desc& vertices, Uint64 positionElement, Allocator* allocator)
+        {
+            if (indices.Indices == nullptr || indices.IndexCount == 0 || indices.IndexCount % 3 != 0)
+                return false;
+
+            if (vertices.Vertices == nullptr || positionElement >= vertices.Layout.Count || allocator == nullptr)
+                return false;
+
+            const VertexInputElement& position = vertices.Layout.Inputs[positionElement];
+
+            if (position.Type != DataTypes::Float32 || position.Count < 3)
+                return false;
+
+            Uint64 positionOffset = GetVertexElementOffset(vertices.Layout, positionElement);
+            Uint64 vertexSize = (vertices.VertexSize != 0) ? vertices.VertexSize : GetPackedVertexSize(vertices.Layout);
+
+            Uint64 vertexCount = vertices.VertexCount;
+            Uint64 indexCount = indices.IndexCount;
+
+            auto indexData = AllocateArray<Uint32>(allocator, indexCount);
+
+            for (Uint64 i = 0; i < indexCount; i++)
+            {
+                indexData[i] = IndexBuffer::ReadIndex(indices.Indices, indices.IndexType, i);
+
+                if (indexData[i] >= vertexCount)
+                {
+                    allocator->FreeMemory(indexData);
+                    return false;
+                }
+            }
+
+            simplifier.Memory = allocator;
+            simplifier.VertexCount = vertexCount;
+            simplifier.Indices = indexData;
+            simplifier.IndexCount = indexCount;
+            simplifier.MaxCost = 0.0;
+
+            simplifier.Positions = AllocateArray<Float32>(allocator, vertexCount * 3);
+            simplifier.Quadrics = AllocateArray<Quadric>(allocator, vertexCount);
+            simplifier.Locked = AllocateArray<bool>(allocator, vertexCount);
+            simplifier.Remap = AllocateArray<Uint32>(allocator, vertexCount);
+            simplifier.Touched = AllocateArray<bool>(allocator, vertexCount);
+            simplifier.AdjacencyOffsets = AllocateArray<Uint32>(allocator, vertexCount + 1);
+            simplifier.Adjacency = AllocateArray<Uint32>(allocator, indexCount);
+            simplifier.Collapses = AllocateArray<Collapse>(allocator, indexCount);
+
+            auto vertexBytes = reinterpret_cast<const Uint8*>(vertices.Vertices);
+
+            for (Uint64 i = 0; i < vertexCount; i++)
+                memcpy(simplifier.Positions + i * 3, vertexBytes + i * vertexSize + positionOffset, sizeof(Float32) * 3);
+
+            memset(simplifier.Quadrics, 0, sizeof(Quadric) * vertexCount);
+            memset(simplifier.Locked, 0, sizeof(bool) * vertexCount);
+
+            for (Uint64 i = 0; i < indexCount; i += 3)
+            {
+                Quadric plane;
+
+                MakePlaneQuadric(plane, simplifier.Positions + indexData[i] * 3,
+                                 simplifier.Positions + indexData[i + 1] * 3,
+                                 simplifier.Positions + indexData[i + 2] * 3);
+
+                for (Uint64 j = 0; j < 3; j++)
+                    AddQuadric(simplifier.Quadrics[indexData[i + j]], plane);
+            }
+
+            // Directed edge without its opposite one is a border (or a seam), vertices on it are never moved
+            auto edges = AllocateArray<Uint64>(allocator, indexCount);
+
+            for (Uint64 i = 0; i < indexCount; i += 3)
+            {
+                for (Uint64 j = 0; j < 3; j++)
+                {
+                    Uint64 a = indexData[i + j];
+                    Uint64 b = indexData[i + (j + 1) % 3];
+
+                    edges[i + j] = (a << 32) | b;
+                }
+            }
+
+            qsort(edges, indexCount, sizeof(Uint64), CompareEdges);
+
+            for (Uint64 i = 0; i < indexCount; i++)
+            {
+                Uint64 a = edges[i] >> 32;
+                Uint64 b = edges[i] & 0xFFFFFFFF;
+                Uint64 opposite = (b << 32) | a;
+
+                if (bsearch(&opposite, edges, indexCount, sizeof(Uint64), CompareEdges) == nullptr)
+                {
+                    simplifier.Locked[a] = true;
+                    simplifier.Locked[b] = true;
+                }
+            }
+
+            allocator->FreeMemory(edges);
+
+            return true;
+        }
+
+        void ReleaseSimplifier(Simplifier& simplifier)
+        {
+            Allocator* allocator = simplifier.Memory;
+
+            allocator->FreeMemory(simplifier.Indices);
+            allocator->FreeMemory(simplifier.Positions);
+            allocator->FreeMemory(simplifier.Quadrics);
+            allocator->FreeMemory(simplifier.Locked);
+            allocator->FreeMemory(simplifier.Remap);
+            allocator->FreeMemory(simplifier.Touched);
+            allocator->FreeMemory(simplifier.AdjacencyOffsets);
+            allocator->FreeMemory(simplifier.Adjacency);
+            allocator->FreeMemory(simplifier.Collapses);
+        }
+
+        void BuildAdjacency(Simplifier& simplifier)
+        {
+            Uint32* offsets = simplifier.AdjacencyOffsets;
+            Uint64 vertexCount = simplifier.VertexCount;
+
+            memset(offsets, 0, sizeof(Uint32) * (vertexCount + 1));
+
+            for (Uint64 i = 0; i < simplifier.IndexCount; i++)
+                offsets[simplifier.Indices[i] + 1]++;
+
+            for (Uint64 i = 0; i < vertexCount; i++)
+                offsets[i + 1] += offsets[i];
+
+            // Offsets are moved forward while filling and restored after
+            for (Uint64 i = 0; i < simplifier.IndexCount; i++)
+                simplifier.Adjacency[offsets[simplifier.Indices[i]]++] = static_cast<Uint32>(i / 3);
+
+            for (Uint64 i = vertexCount; i > 0; i--)
+                offsets[i] = offsets[i - 1];
+
+            offsets[0] = 0;
+        }
+
+        // Collapse is rejected if some of the remaining triangles around vertex flips
+        bool IsCollapseValid(const Simplifier& simplifier, Uint32 from, Uint32 to)
+        {
+            const Float32* positions = simplifier.Positions;
+
+            for (Uint32 k = simplifier.AdjacencyOffsets[from]; k < simplifier.AdjacencyOffsets[from + 1]; k++)
+            {
+                const Uint32* triangle = simplifier.Indices + simplifier.Adjacency[k] * 3;
+
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                    continue;
+
+                Uint32 moved[3];
+
+                for (Uint64 j = 0; j < 3; j++)
+                    moved[j] = (triangle[j] == from) ? to : triangle[j];
+
+                Float32 before[3], after[3];
+
+                GetTriangleNormal(positions + triangle[0] * 3, positions + triangle[1] * 3,
+                                  positions + triangle[2] * 3, before);
+                GetTriangleNormal(positions + moved[0] * 3, positions + moved[1] * 3,
+                                  positions + moved[2] * 3, after);
+
+                if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0f)
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Collapses the cheapest edges pass by pass. Every pass collapses only independent edges,
+        // so costs and flip checks of a pass stay valid
+        void Simplify(Simplifier& simplifier, Uint64 targetIndexCount, Float32 targetError)
+        {
+            Float64 maxCost = static_cast<Float64>(targetError) * targetError;
+
+            while (simplifier.IndexCount > targetIndexCount)
+            {
+                BuildAdjacency(simplifier);
+
+                Uint64 collapseCount = 0;
+
+                for (Uint64 i = 0; i < simplifier.IndexCount; i++)
+                {
+                    Uint32 from = simplifier.Indices[i];
+                    Uint32 to = simplifier.Indices[(i % 3 == 2) ? i - 2 : i + 1];
+
+                    if (simplifier.Locked[from])
+                        continue;
+
+                    Collapse& collapse = simplifier.Collapses[collapseCount++];
+
+                    collapse.Cost = EvaluateQuadrics(simplifier.Quadrics[from], simplifier.Quadrics[to],
+                                                     simplifier.Positions + to * 3);
+                    collapse.From = from;
+                    collapse.To = to;
+                }
+
+                if (collapseCount == 0)
+                    break;
+
+                qsort(simplifier.Collapses, collapseCount, sizeof(Collapse), CompareCollapses);
+
+                for (Uint64 i = 0; i < simplifier.VertexCount; i++)
+                {
+                    simplifier.Remap[i] = static_cast<Uint32>(i);
+                    simplifier.Touched[i] = false;
+                }
+
+                // Every collapse removes about two triangles
+                Uint64 triangleExcess = (simplifier.IndexCount - targetIndexCount) / 3;
+                Uint64 collapseLimit = triangleExcess / 2 + 1;
+                Uint64 collapsed = 0;
+
+                for (Uint64 i = 0; i < collapseCount && collapsed < collapseLimit; i++)
+                {
+                    const Collapse& collapse = simplifier.Collapses[i];
+
+                    if (collapse.Cost > maxCost)
+                        break;
+
+                    if (simplifier.Touched[collapse.From] || simplifier.Touched[collapse.To])
+                        continue;
+
+                    if (!IsCollapseValid(simplifier, collapse.From, collapse.To))
+                        continue;
+
+                    simplifier.Remap[collapse.From] = collapse.To;
+                    AddQuadric(simplifier.Quadrics[collapse.To], simplifier.Quadrics[collapse.From]);
+
+                    for (Uint32 k = simplifier.AdjacencyOffsets[collapse.From];
+                         k < simplifier.AdjacencyOffsets[collapse.From + 1]; k++)
+                    {
+                        const Uint32* triangle = simplifier.Indices + simplifier.Adjacency[k] * 3;
+
+                        for (Uint64 j = 0; j < 3; j++)
+                            simplifier.Touched[triangle[j]] = true;
+                    }
+
+                    simplifier.MaxCost = MAX(simplifier.MaxCost, collapse.Cost);
+                    collapsed++;
+                }
+
+                if (collapsed == 0)
+                    break;
+
+                // Triangles which lost an edge are removed
+                Uint64 writeIndex = 0;
+
+                for (Uint64 i = 0; i < simplifier.IndexCount; i += 3)
+                {
+                    Uint32 a = simplifier.Remap[simplifier.Indices[i]];
+                    Uint32 b = simplifier.Remap[simplifier.Indices[i + 1]];
+                    Uint32 c = simplifier.Remap[simplifier.Indices[i + 2]];
+
+                    if (a == b || b == c || a == c)
+                        continue;
+
+                    simplifier.Indices[writeIndex] = a;
+                    simplifier.Indices[writeIndex + 1] = b;
+                    simplifier.Indices[writeIndex + 2] = c;
+
+                    writeIndex += 3;
+                }
+
+                simplifier.IndexCount = writeIndex;
+            }
+        }
+
+        Float32 GetSimplifierError(const Simplifier& simplifier)
+        {
+            return static_cast<Float32>(std::sqrt(simplifier.MaxCost));
+        }
+
+        void WriteSimplifierIndices(const Simplifier& simplifier, void* destination, IndexType type)
+        {
+            for (Uint64 i = 0; i < simplifier.IndexCount; i++)
+                IndexBuffer::WriteIndex(destination, type, i, simplifier.Indices[i]);
+        }
+    }
+
+    Uint64 SimplifyMesh(void* destination, const IndexBuffer::Desc& indices, const VertexBuffer::Desc& vertices,
+                        Uint64 positionElement, Uint64 targetIndexCount, Float32 targetError,
+                        Float32* resultError, Allocator* allocator)
+    {
+        if (destination == nullptr)
+            return 0;
+
+        Simplifier simplifier;
+
+        if (!InitializeSimplifier(simplifier, indices, vertices, positionElement, allocator))
+            return 0;
+
+        Simplify(simplifier, targetIndexCount, targetError);
+        WriteSimplifierIndices(simplifier, destination, indices.IndexType);
+
+        Uint64 result = simplifier.IndexCount;
+
+        if (resultError != nullptr)
+            *resultError = GetSimplifierError(simplifier);
+
+        ReleaseSimplifier(simplifier);
+
+        return result;
+    }
+
+    bool GenerateMeshLodChain(MeshLodChain& chain, const IndexBuffer::Desc& indices, const VertexBuffer::Desc& vertices,
+                              const MeshLodSettings& settings, Allocator* allocator)
+    {
+        chain.LodsCount = 0;
+
+        Simplifier simplifier;
+
+        if (!InitializeSimplifier(simplifier, indices, vertices, settings.PositionElement, allocator))
+            return false;
+
+        Uint64 maxLods = MIN(settings.MaxLods, MaxMeshLods);
+        Uint64 indexSize = IndexBuffer::GetIndexSize(indices.IndexType);
+
+        while (chain.LodsCount < maxLods)
+        {
+            if (chain.LodsCount != 0)
+            {
+                Uint64 previousCount = simplifier.IndexCount;
+                Uint64 targetCount = static_cast<Uint64>(previousCount / 3 * settings.ReductionRatio) * 3;
+
+                if (targetCount < settings.MinTriangles * 3)
+                    break;
+
+                Simplify(simplifier, targetCount, settings.MaxError);
+
+                // Level isn't worth it if simplification got stuck on borders or error limit
+                if (simplifier.IndexCount == 0 || simplifier.IndexCount * 20 > previousCount * 19)
+                    break;
+            }
+
+            MeshLod& lod = chain.Lods[chain.LodsCount++];
+
+            lod.Indices = indices;
+            lod.Indices.IndexCount = simplifier.IndexCount;
+            lod.Indices.Indices = allocator->AllocateMemory(simplifier.IndexCount * indexSize);
+            lod.Error = GetSimplifierError(simplifier);
+
+            WriteSimplifierIndices(simplifier, lod.Indices.Indices, indices.IndexType);
+        }
+
+        ReleaseSimplifier(simplifier);
+
+        return true;
+    }
+
+    void ReleaseMeshLodChain(MeshLodChain& chain, Allocator* allocator)
+    {
+        for (Uint64 i = 0; i < chain.LodsCount; i++)
+        {
+            allocator->FreeMemory(chain.Lods[i].Indices.Indices);
+            chain.Lods[i].Indices.Indices = nullptr;
+        }
+
+        chain.LodsCount = 0;
+    }
+
+    Float32 GetProjectedError(Float32 error, Float32 distance, Float32 verticalFov, Float32 screenHeight)
+    {
+        // Objects closer than near plane may be still selected with error in front of camera
+        distance = MAX(distance, 1e-4f);
+
+        Float32 projection = screenHeight / (2.0f * std::tan(verticalFov * 0.5f));
+
+        return error / distance * projection;
+    }
+
+    Uint64 SelectMeshLod(const MeshLodChain& chain, Float32 distance, Float32 scale,
+                         Float32 verticalFov, Float32 screenHeight, Float32 maxPixelError)
+    {
+        for (Uint64 i = chain.LodsCount; i > 1; i--)
+        {
+            Float32 error = GetProjectedError(chain.Lods[i - 1].Error * scale, distance, verticalFov, screenHeight);
+
+            if (error <= maxPixelError)
+                return i - 1;
+        }
+
+        return 0;
+    }
+}
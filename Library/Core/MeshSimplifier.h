@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    // Quadric error simplification (Garland & Heckbert) of triangle lists. Edges are collapsed into
+    // one of their existing vertices, so all of the levels of detail use the same vertex buffer.
+    // Borders (it includes attribute seams, where vertices are split) are kept as they are
+
+    static const Uint64 MaxMeshLods = 8;
+
+    struct MeshLod
+    {
+        // Indices are allocated by allocator which was given to GenerateMeshLodChain
+        IndexBuffer::Desc Indices;
+
+        // Maximal distance between simplified and original surface (in units of vertex positions)
+        Float32 Error;
+    };
+
+    struct MeshLodChain
+    {
+        MeshLod Lods[MaxMeshLods];
+        Uint64 LodsCount;
+    };
+
+    struct MeshLodSettings
+    {
+        // Element of vertex layout with positions (it has to be 3 or 4 Float32 components)
+        Uint64 PositionElement = 0;
+
+        Uint64 MaxLods = MaxMeshLods;
+
+        // Every level keeps this part of triangles of the previous one
+        Float32 ReductionRatio = 0.5f;
+
+        // Generation stops when the error becomes larger
+        Float32 MaxError = 1e30f;
+
+        // Generation stops when level has fewer triangles
+        Uint64 MinTriangles = 32;
+    };
+
+    // Writes simplified indices into destination (of the same type and size as source indices).
+    // Returns the count of written indices, the reached error is written into resultError
+    Uint64 SimplifyMesh(void* destination, const IndexBuffer::Desc& indices, const VertexBuffer::Desc& vertices,
+                        Uint64 positionElement, Uint64 targetIndexCount, Float32 targetError,
+                        Float32* resultError, Allocator* allocator);
+
+    // The first level is a copy of source indices. Indices of levels can be given to CreateIndexBuffer
+    // and all of them can be drawn with the same vertex buffer
+    bool GenerateMeshLodChain(MeshLodChain& chain, const IndexBuffer::Desc& indices, const VertexBuffer::Desc& vertices,
+                              const MeshLodSettings& settings, Allocator* allocator);
+
+    void ReleaseMeshLodChain(MeshLodChain& chain, Allocator* allocator);
+
+    // Size of the error in pixels for object at given distance from camera
+    Float32 GetProjectedError(Float32 error, Float32 distance, Float32 verticalFov, Float32 screenHeight);
+
+    // Returns the coarsest level whose projected error is less than maxPixelError.
+    // Scale is the largest scale of object's world transformation
+    Uint64 SelectMeshLod(const MeshLodChain& chain, Float32 distance, Float32 scale,
+                         Float32 verticalFov, Float32 screenHeight, Float32 maxPixelError);
+}
@@ -0,0 +1,464 @@
+#include "Meshlets.h"
+#include "VertexFormat.h"
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        template <typename t>
+        t* AllocateArray(Allocator* allocator, Uint64 count)
+        {
+            return reinterpret_cast<t*>(allocator->AllocateMemory(MAX(count, 1) * sizeof(t)));
+        }
+
+        // Meshlet which is being built
+        struct MeshletBuilder
+        {
+            Uint32 Vertices[MaxMeshletVertices];
+            Uint64 VertexCount;
+            Uint64 TriangleCount;
+            Uint64 FirstIndex;
+        };
+
+        Uint64 CountNewVertices(const Uint32* triangle, const Uint32* vertexMarks, Uint32 mark)
+        {
+            return (vertexMarks[triangle[0]] != mark) + (vertexMarks[triangle[1]] != mark) +
+                   (vertexMarks[triangle[2]] != mark);
+        }
+
+        void ComputeMeshletBounds(Meshlet& meshlet, const Uint32* indices, const Float32* positions)
+        {
+            Float32 minimum[3] = {1e30f, 1e30f, 1e30f};
+            Float32 maximum[3] = {-1e30f, -1e30f, -1e30f};
+
+            for (Uint64 i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i++)
+            {
+                const Float32* position = positions + indices[i] * 3;
+
+                for (Uint64 j = 0; j < 3; j++)
+                {
+                    minimum[j] = MIN(minimum[j], position[j]);
+                    maximum[j] = MAX(maximum[j], position[j]);
+                }
+            }
+
+            Float32 radius = 0.0f;
+
+            for (Uint64 j = 0; j < 3; j++)
+                meshlet.Center[j] = (minimum[j] + maximum[j]) * 0.5f;
+
+            Float32 axis[3] = {0.0f, 0.0f, 0.0f};
+
+            for (Uint64 i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3)
+            {
+                const Float32* p0 = positions + indices[i] * 3;
+                const Float32* p1 = positions + indices[i + 1] * 3;
+                const Float32* p2 = positions + indices[i + 2] * 3;
+
+                for (Uint64 k = 0; k < 3; k++)
+                {
+                    const Float32* p = positions + indices[i + k] * 3;
+
+                    Float32 dx = p[0] - meshlet.Center[0];
+                    Float32 dy = p[1] - meshlet.Center[1];
+                    Float32 dz = p[2] - meshlet.Center[2];
+
+                    radius = MAX(radius, dx * dx + dy * dy + dz * dz);
+                }
+
+                // Normals of different triangles have the same weight in the axis
+                Float32 e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                Float32 e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                Float32 normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                                     e1[0] * e2[1] - e1[1] * e2[0]};
+
+                Float32 length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                if (length == 0.0f)
+                    continue;
+
+                for (Uint64 j = 0; j < 3; j++)
+                    axis[j] += normal[j] / length;
+            }
+
+            meshlet.Radius = std::sqrt(radius);
+
+            Float32 axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+            // Cutoff which is equal to 1.0 never culls meshlet
+            meshlet.ConeAxis[0] = 0.0f;
+            meshlet.ConeAxis[1] = 0.0f;
+            meshlet.ConeAxis[2] = 0.0f;
+            meshlet.ConeCutoff = 1.0f;
+
+            if (axisLength == 0.0f)
+                return;
+
+            for (Uint64 j = 0; j < 3; j++)
+                axis[j] /= axisLength;
+
+            Float32 minimalDot = 1.0f;
+
+            for (Uint64 i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3)
+            {
+                const Float32* p0 = positions + indices[i] * 3;
+                const Float32* p1 = positions + indices[i + 1] * 3;
+                const Float32* p2 = positions + indices[i + 2] * 3;
+
+                Float32 e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                Float32 e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                Float32 normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                                     e1[0] * e2[1] - e1[1] * e2[0]};
+
+                Float32 length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                if (length == 0.0f)
+                    continue;
+
+                Float32 dot = (normal[0] * axis[0] + normal[1] * axis[1] + normal[2] * axis[2]) / length;
+                minimalDot = MIN(minimalDot, dot);
+            }
+
+            // Cone wider than a hemisphere can't be back-facing as a whole
+            if (minimalDot <= 0.0f)
+                return;
+
+            for (Uint64 j = 0; j < 3; j++)
+                meshlet.ConeAxis[j] = axis[j];
+
+            // Sine of cone's angle: view direction inside the cone of complementary angle sees only back faces
+            meshlet.ConeCutoff = std::sqrt(1.0f - minimalDot * minimalDot);
+        }
+    }
+
+    Uint64 GetMeshletBound(Uint64 indexCount)
+    {
+        // Meshlet is closed only when the next triangle doesn't fit it, so it has at least this count of triangles
+        Uint64 minimalTriangles = MIN(MaxMeshletVertices / 3, MaxMeshletTriangles);
+        Uint64 triangleCount = indexCount / 3;
+
+        return (triangleCount + minimalTriangles - 1) / minimalTriangles;
+    }
+
+    Uint64 BuildMeshlets(Meshlet* meshlets, Uint64 maxMeshlets, IndexBuffer::Desc& indices,
+                         const VertexBuffer::Desc& vertices, Uint64 positionElement, Allocator* allocator)
+    {
+        if (meshlets == nullptr || allocator == nullptr || vertices.Vertices == nullptr)
+            return 0;
+
+        if (indices.Indices == nullptr || indices.IndexCount == 0 || indices.IndexCount % 3 != 0)
+            return 0;
+
+        if (maxMeshlets < GetMeshletBound(indices.IndexCount) || positionElement >= vertices.Layout.Count)
+            return 0;
+
+        const VertexInputElement& position = vertices.Layout.Inputs[positionElement];
+
+        if (position.Type != DataTypes::Float32 || position.Count < 3)
+            return 0;
+
+        Uint64 positionOffset = GetVertexElementOffset(vertices.Layout, positionElement);
+        Uint64 vertexSize = (vertices.VertexSize != 0) ? vertices.VertexSize : GetPackedVertexSize(vertices.Layout);
+
+        Uint64 vertexCount = vertices.VertexCount;
+        Uint64 indexCount = indices.IndexCount;
+        Uint64 triangleCount = indexCount / 3;
+
+        auto source = AllocateArray<Uint32>(allocator, indexCount);
+
+        for (Uint64 i = 0; i < indexCount; i++)
+        {
+            source[i] = IndexBuffer::ReadIndex(indices.Indices, indices.IndexType, i);
+
+            if (source[i] >= vertexCount)
+            {
+                allocator->FreeMemory(source);
+                return 0;
+            }
+        }
+
+        auto positions = AllocateArray<Float32>(allocator, vertexCount * 3);
+        auto vertexBytes = reinterpret_cast<const Uint8*>(vertices.Vertices);
+
+        for (Uint64 i = 0; i < vertexCount; i++)
+            memcpy(positions + i * 3, vertexBytes + i * vertexSize + positionOffset, sizeof(Float32) * 3);
+
+        // Triangles around every vertex
+        auto adjacencyOffsets = AllocateArray<Uint32>(allocator, vertexCount + 1);
+        auto adjacency = AllocateArray<Uint32>(allocator, indexCount);
+
+        memset(adjacencyOffsets, 0, sizeof(Uint32) * (vertexCount + 1));
+
+        for (Uint64 i = 0; i < indexCount; i++)
+            adjacencyOffsets[source[i] + 1]++;
+
+        for (Uint64 i = 0; i < vertexCount; i++)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+        for (Uint64 i = 0; i < indexCount; i++)
+            adjacency[adjacencyOffsets[source[i]]++] = static_cast<Uint32>(i / 3);
+
+        for (Uint64 i = vertexCount; i > 0; i--)
+            adjacencyOffsets[i] = adjacencyOffsets[i - 1];
+
+        adjacencyOffsets[0] = 0;
+
+        // Vertex belongs to the current meshlet when its mark is equal to meshlet's number + 1
+        auto vertexMarks = AllocateArray<Uint32>(allocator, vertexCount);
+        auto emitted = AllocateArray<bool>(allocator, triangleCount);
+        auto result = AllocateArray<Uint32>(allocator, indexCount);
+
+        memset(vertexMarks, 0, sizeof(Uint32) * vertexCount);
+        memset(emitted, 0, sizeof(bool) * triangleCount);
+
+        MeshletBuilder builder = {};
+        Uint64 meshletCount = 0;
+        Uint64 writeIndex = 0;
+        Uint64 scanTriangle = 0;
+
+        for (Uint64 emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+        {
+            Uint32 mark = static_cast<Uint32>(meshletCount + 1);
+
+            // The best triangle shares an edge or a vertex with meshlet and adds fewest vertices
+            Uint64 bestTriangle = triangleCount;
+            Uint64 bestNewVertices = 4;
+
+            for (Uint64 i = 0; i < builder.VertexCount && bestNewVertices != 0; i++)
+            {
+                Uint32 vertex = builder.Vertices[i];
+
+                for (Uint32 k = adjacencyOffsets[vertex]; k < adjacencyOffsets[vertex + 1]; k++)
+                {
+                    Uint32 triangle = adjacency[k];
+
+                    if (emitted[triangle])
+                        continue;
+
+                    Uint64 newVertices = CountNewVertices(source + triangle * 3, vertexMarks, mark);
+
+                    if (newVertices < bestNewVertices)
+                    {
+                        bestTriangle = triangle;
+                        bestNewVertices = newVertices;
+
+                        if (newVertices == 0)
+                            break;
+                    }
+                }
+            }
+
+            // Meshlet grows from the next triangle in source order if there are no neighbours
+            if (bestTriangle == triangleCount)
+            {
+                while (emitted[scanTriangle])
+                    scanTriangle++;
+
+                bestTriangle = scanTriangle;
+                bestNewVertices = CountNewVertices(source + bestTriangle * 3, vertexMarks, mark);
+            }
+
+            if (builder.VertexCount + bestNewVertices > MaxMeshletVertices ||
+                builder.TriangleCount + 1 > MaxMeshletTriangles)
+            {
+                Meshlet& meshlet = meshlets[meshletCount++];
+
+                meshlet.FirstIndex = static_cast<Uint32>(builder.FirstIndex);
+                meshlet.IndexCount = static_cast<Uint32>(builder.TriangleCount * 3);
+                meshlet.VertexCount = static_cast<Uint32>(builder.VertexCount);
+
+                builder.VertexCount = 0;
+                builder.TriangleCount = 0;
+                builder.FirstIndex = writeIndex;
+
+                // Triangle is chosen again for the new meshlet
+                emittedCount--;
+                continue;
+            }
+
+            const Uint32* triangle = source + bestTriangle * 3;
+
+            for (Uint64 j = 0; j < 3; j++)
+            {
+                if (vertexMarks[triangle[j]] != mark)
+                {
+                    vertexMarks[triangle[j]] = mark;
+                    builder.Vertices[builder.VertexCount++] = triangle[j];
+                }
+
+                result[writeIndex++] = triangle[j];
+            }
+
+            emitted[bestTriangle] = true;
+            builder.TriangleCount++;
+        }
+
+        if (builder.TriangleCount != 0)
+        {
+            Meshlet& meshlet = meshlets[meshletCount++];
+
+            meshlet.FirstIndex = static_cast<Uint32>(builder.FirstIndex);
+            meshlet.IndexCount = static_cast<Uint32>(builder.TriangleCount * 3);
+            meshlet.VertexCount = static_cast<Uint32>(builder.VertexCount);
+        }
+
+        for (Uint64 i = 0; i < meshletCount; i++)
+            ComputeMeshletBounds(meshlets[i], result, positions);
+
+        for (Uint64 i = 0; i < indexCount; i++)
+            IndexBuffer::WriteIndex(indices.Indices, indices.IndexType, i, result[i]);
+
+        allocator->FreeMemory(source);
+        allocator->FreeMemory(positions);
+        allocator->FreeMemory(adjacencyOffsets);
+        allocator->FreeMemory(adjacency);
+        allocator->FreeMemory(vertexMarks);
+        allocator->FreeMemory(emitted);
+        allocator->FreeMemory(result);
+
+        return meshletCount;
+    }
+
+    bool CreateMeshletCullingData(MeshletCullingData& data, const Meshlet* meshlets, Uint64 count, Allocator* allocator)
+    {
+        if (meshlets == nullptr || count == 0 || allocator == nullptr)
+            return false;
+
+        // Padding meshlets are empty and never visible
+        Uint64 paddedCount = (count + 3) & ~3ull;
+
+        auto block = reinterpret_cast<Uint8*>(allocator->AllocateMemory(paddedCount * 10 * sizeof(Float32)));
+        auto streams = reinterpret_cast<Float32*>(block);
+
+        data.CenterX = streams;
+        data.CenterY = streams + paddedCount;
+        data.CenterZ = streams + paddedCount * 2;
+        data.Radius = streams + paddedCount * 3;
+        data.ConeAxisX = streams + paddedCount * 4;
+        data.ConeAxisY = streams + paddedCount * 5;
+        data.ConeAxisZ = streams + paddedCount * 6;
+        data.ConeCutoff = streams + paddedCount * 7;
+        data.FirstIndex = reinterpret_cast<Uint32*>(streams + paddedCount * 8);
+        data.IndexCount = reinterpret_cast<Uint32*>(streams + paddedCount * 9);
+        data.MeshletsCount = count;
+
+        for (Uint64 i = 0; i < paddedCount; i++)
+        {
+            bool padding = (i >= count);
+            const Meshlet& meshlet = meshlets[padding ? 0 : i];
+
+            data.CenterX[i] = meshlet.Center[0];
+            data.CenterY[i] = meshlet.Center[1];
+            data.CenterZ[i] = meshlet.Center[2];
+            data.Radius[i] = meshlet.Radius;
+            data.ConeAxisX[i] = meshlet.ConeAxis[0];
+            data.ConeAxisY[i] = meshlet.ConeAxis[1];
+            data.ConeAxisZ[i] = meshlet.ConeAxis[2];
+            data.ConeCutoff[i] = meshlet.ConeCutoff;
+            data.FirstIndex[i] = padding ? 0 : meshlet.FirstIndex;
+            data.IndexCount[i] = padding ? 0 : meshlet.IndexCount;
+        }
+
+        return true;
+    }
+
+    void ReleaseMeshletCullingData(MeshletCullingData& data, Allocator* allocator)
+    {
+        // All of the streams are in one block which starts with centers
+        if (data.CenterX != nullptr)
+            allocator->FreeMemory(data.CenterX);
+
+        data = MeshletCullingData{};
+    }
+
+    Uint64 CullMeshlets(IndexBuffer::Range* ranges, Uint64 maxRanges, const MeshletCullingData& data,
+                        const Frustum& frustum, const Float32* cameraPosition)
+    {
+        if (ranges == nullptr || maxRanges == 0 || data.MeshletsCount == 0)
+            return 0;
+
+        Uint64 rangesCount = 0;
+
+        __m128 cameraX = _mm_set1_ps(cameraPosition ? cameraPosition[0] : 0.0f);
+        __m128 cameraY = _mm_set1_ps(cameraPosition ? cameraPosition[1] : 0.0f);
+        __m128 cameraZ = _mm_set1_ps(cameraPosition ? cameraPosition[2] : 0.0f);
+
+        for (Uint64 i = 0; i < data.MeshletsCount; i += 4)
+        {
+            __m128 centerX = _mm_loadu_ps(data.CenterX + i);
+            __m128 centerY = _mm_loadu_ps(data.CenterY + i);
+            __m128 centerZ = _mm_loadu_ps(data.CenterZ + i);
+            __m128 radius = _mm_loadu_ps(data.Radius + i);
+            __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+            __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (Uint64 j = 0; j < Frustum::PlanesCount; j++)
+            {
+                const Plane& plane = frustum.Planes[j];
+
+                __m128 distance = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane.Normal[0])),
+                                             _mm_mul_ps(centerY, _mm_set1_ps(plane.Normal[1])));
+                distance = _mm_add_ps(distance, _mm_mul_ps(centerZ, _mm_set1_ps(plane.Normal[2])));
+                distance = _mm_add_ps(distance, _mm_set1_ps(plane.Distance));
+
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeRadius));
+            }
+
+            if (cameraPosition != nullptr)
+            {
+                __m128 directionX = _mm_sub_ps(centerX, cameraX);
+                __m128 directionY = _mm_sub_ps(centerY, cameraY);
+                __m128 directionZ = _mm_sub_ps(centerZ, cameraZ);
+
+                __m128 dot = _mm_add_ps(_mm_mul_ps(directionX, _mm_loadu_ps(data.ConeAxisX + i)),
+                                        _mm_mul_ps(directionY, _mm_loadu_ps(data.ConeAxisY + i)));
+                dot = _mm_add_ps(dot, _mm_mul_ps(directionZ, _mm_loadu_ps(data.ConeAxisZ + i)));
+
+                __m128 length = _mm_add_ps(_mm_mul_ps(directionX, directionX), _mm_mul_ps(directionY, directionY));
+                length = _mm_sqrt_ps(_mm_add_ps(length, _mm_mul_ps(directionZ, directionZ)));
+
+                __m128 limit = _mm_add_ps(_mm_mul_ps(length, _mm_loadu_ps(data.ConeCutoff + i)), radius);
+
+                visible = _mm_andnot_ps(_mm_cmpge_ps(dot, limit), visible);
+            }
+
+            Int32 mask = _mm_movemask_ps(visible);
+
+            for (Uint64 lane = 0; lane < 4 && mask != 0; lane++)
+            {
+                if ((mask & (1 << lane)) == 0)
+                    continue;
+
+                Uint64 meshlet = i + lane;
+                Uint64 firstIndex = data.FirstIndex[meshlet];
+                Uint64 indexCount = data.IndexCount[meshlet];
+
+                if (indexCount == 0)
+                    continue;
+
+                if (rangesCount != 0)
+                {
+                    IndexBuffer::Range& last = ranges[rangesCount - 1];
+
+                    if (last.FirstIndex + last.IndexCount == firstIndex || rangesCount == maxRanges)
+                    {
+                        last.IndexCount = firstIndex + indexCount - last.FirstIndex;
+                        continue;
+                    }
+                }
+
+                ranges[rangesCount].FirstIndex = firstIndex;
+                ranges[rangesCount].IndexCount = indexCount;
+                ranges[rangesCount].BaseVertex = 0;
+                rangesCount++;
+            }
+        }
+
+        return rangesCount;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Graphics.h"
+#include "Frustum.h"
+
+namespace Tiny3D
+{
+    // Meshlet is a small cluster of triangles with its bounds. Triangles of meshlets lie
+    // one after another in index buffer, so visible meshlets are drawn as ranges of the same buffer
+
+    static const Uint64 MaxMeshletVertices = 64;
+    static const Uint64 MaxMeshletTriangles = 124;
+
+    struct Meshlet
+    {
+        Uint32 FirstIndex;
+        Uint32 IndexCount;
+        Uint32 VertexCount;
+
+        Float32 Center[3];
+        Float32 Radius;
+
+        // Normals of all triangles are inside the cone. Meshlet is back-facing when
+        // Dot(center - camera, axis) >= cutoff * Length(center - camera) + radius
+        Float32 ConeAxis[3];
+        Float32 ConeCutoff;
+    };
+
+    // Maximal count of meshlets for triangle list with given count of indices
+    Uint64 GetMeshletBound(Uint64 indexCount);
+
+    // Reorders triangles of description in place, so each meshlet is a range of indices.
+    // Returns the count of written meshlets or 0 if something is wrong
+    Uint64 BuildMeshlets(Meshlet* meshlets, Uint64 maxMeshlets, IndexBuffer::Desc& indices,
+                         const VertexBuffer::Desc& vertices, Uint64 positionElement, Allocator* allocator);
+
+    // Bounds of meshlets in SoA layout (arrays are padded to 4 elements) for SIMD culling
+    struct MeshletCullingData
+    {
+        Float32* CenterX;
+        Float32* CenterY;
+        Float32* CenterZ;
+        Float32* Radius;
+
+        Float32* ConeAxisX;
+        Float32* ConeAxisY;
+        Float32* ConeAxisZ;
+        Float32* ConeCutoff;
+
+        Uint32* FirstIndex;
+        Uint32* IndexCount;
+
+        Uint64 MeshletsCount;
+    };
+
+    bool CreateMeshletCullingData(MeshletCullingData& data, const Meshlet* meshlets, Uint64 count, Allocator* allocator);
+    void ReleaseMeshletCullingData(MeshletCullingData& data, Allocator* allocator);
+
+    // Frustum and camera position are in object space (frustum of model-view-projection matrix).
+    // Camera position may be nullptr, then back-facing meshlets aren't culled.
+    // Visible meshlets which are neighbours in index buffer are merged into one range. If there are more ranges
+    // than maxRanges, the last range is extended over the rest of visible meshlets. Returns the count of ranges
+    Uint64 CullMeshlets(IndexBuffer::Range* ranges, Uint64 maxRanges, const MeshletCullingData& data,
+                        const Frustum& frustum, const Float32* cameraPosition);
+}
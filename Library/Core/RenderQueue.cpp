@@ -0,0 +1,255 @@
+#include "RenderQueue.h"
+
+namespace Tiny3D
+{
+    namespace
+    {
+        static const Uint64 DepthBits = 24;
+        static const Uint64 MaxDepthValue = (1ull << DepthBits) - 1;
+
+        static const Uint64 RadixPasses = 8;
+        static const Uint64 RadixBuckets = 256;
+
+        Uint64 QuantizeDepth(Float32 depth)
+        {
+            // Written so that NaN goes to zero too
+            if (!(depth > 0.0f))
+                return 0;
+
+            if (depth >= 1.0f)
+                return MaxDepthValue;
+
+            return static_cast<Uint64>(depth * static_cast<Float32>(MaxDepthValue));
+        }
+
+        template <typename t>
+        t* AllocateArray(Allocator* allocator, Uint64 count)
+        {
+            return reinterpret_cast<t*>(allocator->AllocateMemory(count * sizeof(t)));
+        }
+    }
+
+    Uint64 MakeOpaqueSortKey(Uint8 layer, Uint16 shader, Uint16 material, Float32 depth)
+    {
+        return (static_cast<Uint64>(layer) << 56) | (static_cast<Uint64>(shader) << 40) |
+               (static_cast<Uint64>(material) << 24) | QuantizeDepth(depth);
+    }
+
+    Uint64 MakeTransparentSortKey(Uint8 layer, Uint16 shader, Uint16 material, Float32 depth)
+    {
+        return (static_cast<Uint64>(layer) << 56) | ((MaxDepthValue - QuantizeDepth(depth)) << 32) |
+               (static_cast<Uint64>(shader) << 16) | static_cast<Uint64>(material);
+    }
+
+    RenderQueue::RenderQueue(Allocator* allocator, Uint64 capacity)
+    {
+        m_allocator = allocator;
+
+        m_capacity = MAX(capacity, 1);
+        m_itemCount = 0;
+        m_sorted = true;
+
+        m_items = AllocateArray<RenderItem>(m_allocator, m_capacity);
+        m_keys = AllocateArray<Uint64>(m_allocator, m_capacity);
+        m_scratchKeys = AllocateArray<Uint64>(m_allocator, m_capacity);
+        m_order = AllocateArray<Uint32>(m_allocator, m_capacity);
+        m_scratchOrder = AllocateArray<Uint32>(m_allocator, m_capacity);
+    }
+
+    RenderQueue::~RenderQueue()
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        m_allocator->FreeMemory(m_items);
+        m_allocator->FreeMemory(m_keys);
+        m_allocator->FreeMemory(m_scratchKeys);
+        m_allocator->FreeMemory(m_order);
+        m_allocator->FreeMemory(m_scratchOrder);
+    }
+
+    void RenderQueue::Grow()
+    {
+        Uint64 newCapacity = m_capacity * 2;
+
+        auto newItems = AllocateArray<RenderItem>(m_allocator, newCapacity);
+        CopyMemory(newItems, m_items, m_itemCount * sizeof(RenderItem));
+
+        m_allocator->FreeMemory(m_items);
+        m_allocator->FreeMemory(m_keys);
+        m_allocator->FreeMemory(m_scratchKeys);
+        m_allocator->FreeMemory(m_order);
+        m_allocator->FreeMemory(m_scratchOrder);
+
+        // Keys and order are rebuilt by the next sort, so they aren't copied
+        m_items = newItems;
+        m_keys = AllocateArray<Uint64>(m_allocator, newCapacity);
+        m_scratchKeys = AllocateArray<Uint64>(m_allocator, newCapacity);
+        m_order = AllocateArray<Uint32>(m_allocator, newCapacity);
+        m_scratchOrder = AllocateArray<Uint32>(m_allocator, newCapacity);
+
+        m_capacity = newCapacity;
+    }
+
+    void RenderQueue::Push(const RenderItem& item)
+    {
+        if (m_itemCount == m_capacity)
+            Grow();
+
+        m_items[m_itemCount++] = item;
+        m_sorted = false;
+    }
+
+    void RenderQueue::Sort()
+    {
+        if (m_sorted)
+            return;
+
+        Uint32 histograms[RadixPasses][RadixBuckets] = {};
+
+        for (Uint64 i = 0; i < m_itemCount; i++)
+        {
+            Uint64 key = m_items[i].Key;
+
+            m_keys[i] = key;
+            m_order[i] = static_cast<Uint32>(i);
+
+            for (Uint64 pass = 0; pass < RadixPasses; pass++)
+                histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+
+        for (Uint64 pass = 0; pass < RadixPasses; pass++)
+        {
+            Uint32* histogram = histograms[pass];
+            Uint64 shift = pass * 8;
+
+            // Byte which is the same for all of the keys doesn't change the order
+            if (histogram[(m_keys[0] >> shift) & 0xFF] == m_itemCount)
+                continue;
+
+            Uint32 offset = 0;
+
+            for (Uint64 bucket = 0; bucket < RadixBuckets; bucket++)
+            {
+                Uint32 count = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += count;
+            }
+
+            for (Uint64 i = 0; i < m_itemCount; i++)
+            {
+                Uint32 position = histogram[(m_keys[i] >> shift) & 0xFF]++;
+
+                m_scratchKeys[position] = m_keys[i];
+                m_scratchOrder[position] = m_order[i];
+            }
+
+            Uint64* keys = m_keys;
+            m_keys = m_scratchKeys;
+            m_scratchKeys = keys;
+
+            Uint32* order = m_order;
+            m_order = m_scratchOrder;
+            m_scratchOrder = order;
+        }
+
+        m_sorted = true;
+    }
+
+    template <typename target>
+    void RenderQueue::Emit(target* output)
+    {
+        Sort();
+
+        Shader* boundProgram = nullptr;
+        PipelineState* boundPipeline = nullptr;
+        const RenderMaterial* boundMaterial = nullptr;
+
+        for (Uint64 i = 0; i < m_itemCount; i++)
+        {
+            const RenderItem& item = m_items[m_order[i]];
+
+            Shader* program = (item.Pipeline != nullptr) ? item.Pipeline->GetDescription().Shader : item.Program;
+
+            // Item without pipeline isn't drawn with states of the previous one, null pipeline resets them
+            if (item.Pipeline != boundPipeline)
+            {
+                output->BindPipelineState(item.Pipeline);
+                boundPipeline = item.Pipeline;
+            }
+
+            if (item.Pipeline == nullptr && program != boundProgram)
+                output->BindShader(program);
+
+            if (program != boundProgram)
+            {
+                boundProgram = program;
+                boundMaterial = nullptr;
+            }
+
+            // Slots of shader are fixed when it's created, so material is bound only when it changes
+            if (item.Material != boundMaterial)
+            {
+                const RenderMaterial* material = item.Material;
+
+                if (material != nullptr)
+                {
+                    for (Uint64 j = 0; j < MIN(material->TexturesCount, MaxMaterialTextures); j++)
+                        output->BindShaderTexture(program, material->TextureNames[j], material->Textures[j]);
+
+                    if (material->Uniforms != nullptr)
+                        output->BindShaderUniformBuffer(program, material->UniformsName, material->Uniforms);
+                }
+
+                boundMaterial = material;
+            }
+
+            bool instanced = item.Instances != nullptr || item.InstanceCount > 1;
+
+            if (item.Indices == nullptr)
+            {
+                if (instanced)
+                    output->DrawInstanced(item.Topology, item.Vertices, item.Instances, item.InstanceCount);
+                else
+                    output->Draw(item.Topology, item.Vertices);
+            }
+
+            else
+            {
+                if (instanced)
+                    output->DrawIndexedInstanced(item.Topology, item.Vertices, item.Indices, item.Instances,
+                                                 item.InstanceCount);
+                else
+                    output->DrawIndexed(item.Topology, item.Vertices, item.Indices);
+            }
+        }
+    }
+
+    void RenderQueue::Submit(GraphicsContext* context)
+    {
+        if (context != nullptr)
+            Emit(context);
+    }
+
+    void RenderQueue::Submit(CommandList* list)
+    {
+        if (list != nullptr)
+            Emit(list);
+    }
+
+    void RenderQueue::Clear()
+    {
+        m_itemCount = 0;
+        m_sorted = true;
+    }
+
+    Uint64 RenderQueue::GetItemCount() const
+    {
+        return m_itemCount;
+    }
+
+    const RenderItem& RenderQueue::GetSortedItem(Uint64 index) const
+    {
+        return m_items[m_order[index]];
+    }
+}
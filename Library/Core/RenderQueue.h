@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Graphics.h"
+#include "CommandList.h"
+
+namespace Tiny3D
+{
+    static constexpr Uint64 MaxMaterialTextures = 8;
+
+    // Textures and uniform buffer which are bound together. Items with the same material pointer
+    // don't rebind it, so materials have to be shared between items (not copied per item)
+    struct RenderMaterial
+    {
+        const char* TextureNames[MaxMaterialTextures];
+        const Texture2D* Textures[MaxMaterialTextures];
+        Uint64 TexturesCount;
+
+        const char* UniformsName;
+        const UniformBuffer* Uniforms;
+    };
+
+    // One draw of queue. Indices may be nullptr for non-indexed draws, instances may be nullptr
+    // (instance count is still used then). Item with pipeline state is drawn with its shader instead of Program
+    struct RenderItem
+    {
+        Uint64 Key;
+
+        Shader* Program;
+        const RenderMaterial* Material;
+
+        PrimitiveToplogies Topology;
+        VertexBuffer* Vertices;
+        IndexBuffer* Indices;
+
+        VertexBuffer* Instances;
+        Uint64 InstanceCount;
+
+        PipelineState* Pipeline = nullptr;
+    };
+
+    // Sort keys are compared as integers, the highest bits go first:
+    //  opaque:      layer (8) | shader (16) | material (16) | depth (24) - state changes first, then front to back
+    //  transparent: layer (8) | inverted depth (24) | shader (16) | material (16) - back to front
+    // Depth is the view depth normalized into [0; 1] (values out of range are clamped)
+    Uint64 MakeOpaqueSortKey(Uint8 layer, Uint16 shader, Uint16 material, Float32 depth);
+    Uint64 MakeTransparentSortKey(Uint8 layer, Uint16 shader, Uint16 material, Float32 depth);
+
+    // Collects items of a frame, sorts them by key with LSD radix sort (bytes which are equal
+    // for all keys are skipped) and submits them with the fewest shader (or pipeline state) and material bindings
+    class RenderQueue
+    {
+    private:
+        RenderItem* m_items;
+        Uint64 m_itemCount;
+        Uint64 m_capacity;
+
+        // Sorted order of items and scratch memory of radix sort
+        Uint64* m_keys;
+        Uint64* m_scratchKeys;
+        Uint32* m_order;
+        Uint32* m_scratchOrder;
+        bool m_sorted;
+
+        Allocator* m_allocator;
+
+        void Grow();
+
+        template <typename target>
+        void Emit(target* output);
+
+    public:
+        RenderQueue(Allocator* allocator, Uint64 capacity = 1024);
+        ~RenderQueue();
+
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+
+        void Push(const RenderItem& item);
+
+        void Sort();
+
+        // Sorts queue (if it wasn't sorted after the last push) and draws its items in order
+        void Submit(GraphicsContext* context);
+        void Submit(CommandList* list);
+
+        void Clear();
+
+        Uint64 GetItemCount() const;
+
+        // Item at the given position of sorted order (valid after Sort or Submit)
+        const RenderItem& GetSortedItem(Uint64 index) const;
+    };
+}
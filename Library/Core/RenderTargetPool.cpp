@@ -0,0 +1,148 @@
+#include "RenderTargetPool.h"
+
+namespace Tiny3D
+{
+    RenderTargetPool::RenderTargetPool(GraphicsContext* context, Allocator* allocator, Uint64 framesToKeep)
+    {
+        m_context = context;
+        m_allocator = allocator;
+
+        m_entries = nullptr;
+        m_entryCount = 0;
+        m_entryCapacity = 0;
+
+        m_frame = 0;
+        m_framesToKeep = framesToKeep;
+
+        m_createdTargets = 0;
+        m_releasedTargets = 0;
+    }
+
+    RenderTargetPool::~RenderTargetPool()
+    {
+        // Targets which are still taken are released too, they belong to the pool
+        for (Uint64 i = 0; i < m_entryCount; i++)
+            m_context->ReleaseRenderTarget(m_entries[i].Target);
+
+        if (m_entries != nullptr)
+            m_allocator->FreeMemory(m_entries);
+    }
+
+    void RenderTargetPool::RemoveEntry(Uint64 entry)
+    {
+        m_context->ReleaseRenderTarget(m_entries[entry].Target);
+        m_releasedTargets++;
+
+        // Order of entries doesn't matter, so the last one takes place of removed one
+        m_entries[entry] = m_entries[m_entryCount - 1];
+        m_entryCount--;
+    }
+
+    RenderTarget* RenderTargetPool::AcquireTarget(const RenderTarget::Desc& description)
+    {
+        Uint64 hash = HashRenderTargetDesc(description);
+
+        for (Uint64 i = 0; i < m_entryCount; i++)
+        {
+            Entry& entry = m_entries[i];
+
+            if (entry.Used || entry.Hash != hash)
+                continue;
+
+            // Descriptions with the same hash may differ, so target is taken only by equal description
+            if (CompareRenderTargetDescs(entry.Description, description))
+            {
+                entry.Used = true;
+                entry.LastUsedFrame = m_frame;
+
+                return entry.Target;
+            }
+        }
+
+        RenderTarget* target = m_context->CreateRenderTarget(description);
+
+        if (target == nullptr)
+            return nullptr;
+
+        if (m_entryCount == m_entryCapacity)
+        {
+            Uint64 newCapacity = MAX(m_entryCapacity * 2, 8);
+
+            auto newEntries = reinterpret_cast<Entry*>(m_allocator->AllocateMemory(newCapacity * sizeof(Entry)));
+
+            if (m_entries != nullptr)
+            {
+                CopyMemory(newEntries, m_entries, m_entryCount * sizeof(Entry));
+                m_allocator->FreeMemory(m_entries);
+            }
+
+            m_entries = newEntries;
+            m_entryCapacity = newCapacity;
+        }
+
+        m_entries[m_entryCount] = {target, description, hash, m_frame, true};
+        m_entryCount++;
+
+        m_createdTargets++;
+
+        return target;
+    }
+
+    void RenderTargetPool::ReleaseTarget(RenderTarget* target)
+    {
+        for (Uint64 i = 0; i < m_entryCount; i++)
+        {
+            if (m_entries[i].Target == target)
+            {
+                m_entries[i].Used = false;
+                m_entries[i].LastUsedFrame = m_frame;
+                return;
+            }
+        }
+    }
+
+    void RenderTargetPool::Update()
+    {
+        m_frame++;
+
+        Uint64 i = 0;
+
+        while (i < m_entryCount)
+        {
+            const Entry& entry = m_entries[i];
+
+            if (!entry.Used && m_frame - entry.LastUsedFrame > m_framesToKeep)
+                RemoveEntry(i);
+            else
+                i++;
+        }
+    }
+
+    void RenderTargetPool::Trim()
+    {
+        Uint64 i = 0;
+
+        while (i < m_entryCount)
+        {
+            if (!m_entries[i].Used)
+                RemoveEntry(i);
+            else
+                i++;
+        }
+    }
+
+    RenderTargetPool::Report RenderTargetPool::GetReport() const
+    {
+        Report report = {};
+
+        report.TargetCount = m_entryCount;
+
+        for (Uint64 i = 0; i < m_entryCount; i++)
+            report.UsedTargets += m_entries[i].Used ? 1 : 0;
+
+        report.CreatedTargets = m_createdTargets;
+        report.ReleasedTargets = m_releasedTargets;
+
+        return report;
+    }
+}
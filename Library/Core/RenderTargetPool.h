@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    // Gives render targets of transient passes (post-processing, shadows and so on) out of the targets which
+    // were made before. Targets are found by description (hash first), so target which is given back can be taken
+    // by a later pass of the same frame (passes which don't overlap share framebuffer and textures) or by
+    // the next frames. Targets which weren't taken for the given number of frames are released
+    class RenderTargetPool
+    {
+    public:
+        struct Report
+        {
+            Uint64 TargetCount;
+            Uint64 UsedTargets;
+
+            // Targets which were made and released by the pool since it was created
+            Uint64 CreatedTargets;
+            Uint64 ReleasedTargets;
+        };
+
+    private:
+        struct Entry
+        {
+            RenderTarget* Target;
+            RenderTarget::Desc Description;
+            Uint64 Hash;
+            Uint64 LastUsedFrame;
+            bool Used;
+        };
+
+        GraphicsContext* m_context;
+
+        Entry* m_entries;
+        Uint64 m_entryCount;
+        Uint64 m_entryCapacity;
+
+        Uint64 m_frame;
+        Uint64 m_framesToKeep;
+
+        Uint64 m_createdTargets;
+        Uint64 m_releasedTargets;
+
+        Allocator* m_allocator;
+
+        void RemoveEntry(Uint64 entry);
+
+    public:
+        RenderTargetPool(GraphicsContext* context, Allocator* allocator, Uint64 framesToKeep = 3);
+        ~RenderTargetPool();
+
+        RenderTargetPool(const RenderTargetPool&) = delete;
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+        // Returns free target with the same description or makes a new one (nullptr when it can't be made)
+        RenderTarget* AcquireTarget(const RenderTarget::Desc& description);
+
+        // Target may be given by the next AcquireTarget right away, so it isn't read after that
+        void ReleaseTarget(RenderTarget* target);
+
+        // Counts frames (once in a frame) and releases targets which weren't taken for a few of them
+        void Update();
+
+        // Releases all of the free targets (for example, after resizing of window)
+        void Trim();
+
+        Report GetReport() const;
+    };
+}
@@ -0,0 +1,418 @@
+#include "ShaderLibrary.h"
+#include "VertexFormat.h"
+
+#include <cstring>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        template <typename t>
+        t* AllocateArray(Allocator* allocator, Uint64 count)
+        {
+            return reinterpret_cast<t*>(allocator->AllocateMemory(count * sizeof(t)));
+        }
+
+        // Missing string is equal only to missing one
+        bool CompareStrings(const char* first, const char* second)
+        {
+            if (first == nullptr || second == nullptr)
+                return first == second;
+
+            return strcmp(first, second) == 0;
+        }
+
+        bool CompareBlocks(const void* first, const void* second, Uint64 size)
+        {
+            if (size == 0 || first == second)
+                return true;
+
+            return first != nullptr && second != nullptr && memcmp(first, second, size) == 0;
+        }
+
+        bool CompareBinaries(const ShaderBinary& first, const ShaderBinary& second)
+        {
+            if (first.Size != second.Size || first.ConstantsCount != second.ConstantsCount)
+                return false;
+
+            if (!CompareStrings(first.EntryPoint, second.EntryPoint))
+                return false;
+
+            Uint64 constantsSize = first.ConstantsCount * sizeof(Uint32);
+
+            return CompareBlocks(first.Code, second.Code, first.Size) &&
+                   CompareBlocks(first.ConstantIDs, second.ConstantIDs, constantsSize) &&
+                   CompareBlocks(first.ConstantValues, second.ConstantValues, constantsSize);
+        }
+
+        // Binary of stage is used only when stage has no GLSL code, as HashShaderDesc does it
+        bool CompareShaderData(const ShaderData& first, const ShaderData& second)
+        {
+            const char* firstStages[3] = {first.VertexShaderCode, first.GeometryShaderCode, first.PixelShaderCode};
+            const char* secondStages[3] = {second.VertexShaderCode, second.GeometryShaderCode,
+                                           second.PixelShaderCode};
+
+            const ShaderBinary* firstBinaries[3] = {&first.VertexShaderBinary, &first.GeometryShaderBinary,
+                                                    &first.PixelShaderBinary};
+            const ShaderBinary* secondBinaries[3] = {&second.VertexShaderBinary, &second.GeometryShaderBinary,
+                                                     &second.PixelShaderBinary};
+
+            for (Uint64 i = 0; i < 3; i++)
+            {
+                if (!CompareStrings(firstStages[i], secondStages[i]))
+                    return false;
+
+                if (firstStages[i] == nullptr && !CompareBinaries(*firstBinaries[i], *secondBinaries[i]))
+                    return false;
+            }
+
+            return true;
+        }
+
+        Uint64 SkipLine(const char* code, Uint64 length, Uint64 position)
+        {
+            while (position < length && code[position] != '\n')
+                position++;
+
+            return MIN(position + 1, length);
+        }
+
+        // Returns position right after the line of #version directive, or zero when code has no such line.
+        // Only whitespace and comments may go before the directive
+        Uint64 FindVersionLineEnd(const char* code, Uint64 length)
+        {
+            Uint64 position = 0;
+
+            while (position < length)
+            {
+                char symbol = code[position];
+
+                if (symbol == ' ' || symbol == '\t' || symbol == '\r' || symbol == '\n')
+                {
+                    position++;
+                }
+
+                else if (strncmp(code + position, "//", 2) == 0)
+                {
+                    position = SkipLine(code, length, position);
+                }
+
+                else if (strncmp(code + position, "/*", 2) == 0)
+                {
+                    const char* end = strstr(code + position + 2, "*/");
+
+                    if (end == nullptr)
+                        return 0;
+
+                    position = static_cast<Uint64>(end - code) + 2;
+                }
+
+                else
+                {
+                    break;
+                }
+            }
+
+            if (position == length || code[position] != '#')
+                return 0;
+
+            // Preprocessor allows spaces between # and name of directive
+            Uint64 name = position + 1;
+
+            while (name < length && (code[name] == ' ' || code[name] == '\t'))
+                name++;
+
+            if (strncmp(code + name, "version", 7) != 0)
+                return 0;
+
+            return SkipLine(code, length, name);
+        }
+    }
+
+    ShaderLibrary::ShaderLibrary(GraphicsContext* context, Allocator* allocator, const char* const* featureNames,
+                                 Uint64 featureCount)
+    {
+        m_context = context;
+        m_allocator = allocator;
+
+        m_featureNames = featureNames;
+        m_featureCount = MIN(featureCount, MaxShaderFeatures);
+
+        m_programCapacity = 16;
+        m_programCount = 0;
+        m_programs = AllocateArray<ProgramEntry>(m_allocator, m_programCapacity);
+
+        // Capacity is a power of two, so slot is found by mask
+        m_variantCapacity = 64;
+        m_variantCount = 0;
+        m_variants = AllocateArray<VariantEntry>(m_allocator, m_variantCapacity);
+        SetMemory(m_variants, m_variantCapacity * sizeof(VariantEntry), 0);
+    }
+
+    ShaderLibrary::~ShaderLibrary()
+    {
+        if (m_allocator == nullptr)
+            return;
+
+        for (Uint64 i = 0; i < m_variantCapacity; i++)
+        {
+            if (m_variants[i].Variant != nullptr)
+                m_context->ReleaseShader(m_variants[i].Variant);
+        }
+
+        m_allocator->FreeMemory(m_programs);
+        m_allocator->FreeMemory(m_variants);
+    }
+
+    ShaderLibrary::VariantEntry* ShaderLibrary::FindVariant(Uint64 key, Uint64 program, Uint64 features) const
+    {
+        Uint64 mask = m_variantCapacity - 1;
+
+        for (Uint64 slot = key & mask;; slot = (slot + 1) & mask)
+        {
+            VariantEntry* entry = &m_variants[slot];
+
+            if (!entry->Used)
+                return entry;
+
+            if (entry->Key == key && entry->Program == program && entry->Features == features)
+                return entry;
+        }
+    }
+
+    void ShaderLibrary::GrowVariants()
+    {
+        VariantEntry* oldVariants = m_variants;
+        Uint64 oldCapacity = m_variantCapacity;
+
+        m_variantCapacity *= 2;
+        m_variants = AllocateArray<VariantEntry>(m_allocator, m_variantCapacity);
+        SetMemory(m_variants, m_variantCapacity * sizeof(VariantEntry), 0);
+
+        for (Uint64 i = 0; i < oldCapacity; i++)
+        {
+            const VariantEntry& old = oldVariants[i];
+
+            if (old.Used)
+                *FindVariant(old.Key, old.Program, old.Features) = old;
+        }
+
+        m_allocator->FreeMemory(oldVariants);
+    }
+
+    void ShaderLibrary::InsertVariant(Uint64 key, Uint64 program, Uint64 features, Shader* variant)
+    {
+        // Table is kept at most half full, so probing stays short
+        if ((m_variantCount + 1) * 2 > m_variantCapacity)
+            GrowVariants();
+
+        VariantEntry* entry = FindVariant(key, program, features);
+
+        entry->Key = key;
+        entry->Program = program;
+        entry->Features = features;
+        entry->Variant = variant;
+        entry->Used = true;
+
+        m_variantCount++;
+    }
+
+    char* ShaderLibrary::MakeVariantCode(const char* code, Uint64 features) const
+    {
+        if (code == nullptr)
+            return nullptr;
+
+        Uint64 codeLength = strlen(code);
+
+        // Byte order mark isn't accepted by some drivers, so it's dropped
+        if (codeLength >= 3 && memcmp(code, "\xEF\xBB\xBF", 3) == 0)
+        {
+            code += 3;
+            codeLength -= 3;
+        }
+
+        // #version has to go before anything else but comments, so defines go right after its line
+        Uint64 headerLength = FindVersionLineEnd(code, codeLength);
+
+        static const char DefinePrefix[] = "#define ";
+        static const char DefineSuffix[] = " 1\n";
+
+        Uint64 definesLength = 0;
+
+        for (Uint64 i = 0; i < m_featureCount; i++)
+        {
+            if ((features >> i) & 1)
+                definesLength += sizeof(DefinePrefix) - 1 + strlen(m_featureNames[i]) + sizeof(DefineSuffix) - 1;
+        }
+
+        // Line break is added when #version is the only line without it
+        char* variantCode = AllocateArray<char>(m_allocator, codeLength + definesLength + 2);
+        char* cursor = variantCode;
+
+        CopyMemory(cursor, code, headerLength);
+        cursor += headerLength;
+
+        if (headerLength > 0 && code[headerLength - 1] != '\n')
+            *cursor++ = '\n';
+
+        for (Uint64 i = 0; i < m_featureCount; i++)
+        {
+            if (((features >> i) & 1) == 0)
+                continue;
+
+            Uint64 nameLength = strlen(m_featureNames[i]);
+
+            CopyMemory(cursor, DefinePrefix, sizeof(DefinePrefix) - 1);
+            cursor += sizeof(DefinePrefix) - 1;
+
+            CopyMemory(cursor, m_featureNames[i], nameLength);
+            cursor += nameLength;
+
+            CopyMemory(cursor, DefineSuffix, sizeof(DefineSuffix) - 1);
+            cursor += sizeof(DefineSuffix) - 1;
+        }
+
+        CopyMemory(cursor, code + headerLength, codeLength - headerLength);
+        cursor += codeLength - headerLength;
+
+        *cursor = '\0';
+
+        return variantCode;
+    }
+
+    Uint64 ShaderLibrary::ClampFeatures(Uint64 features) const
+    {
+        // Bits of features which don't exist don't make new variants
+        if (m_featureCount < MaxShaderFeatures)
+            features &= (1ull << m_featureCount) - 1;
+
+        return features;
+    }
+
+    Shader* ShaderLibrary::CreateVariant(const ProgramEntry& program, Uint64 features, bool async)
+    {
+        char* vertexCode = MakeVariantCode(program.Data.VertexShaderCode, features);
+        char* geometryCode = MakeVariantCode(program.Data.GeometryShaderCode, features);
+        char* pixelCode = MakeVariantCode(program.Data.PixelShaderCode, features);
+
+        Shader::Desc description = {program.Data, program.Layout};
+
+        description.Data.VertexShaderCode = vertexCode;
+        description.Data.GeometryShaderCode = geometryCode;
+        description.Data.PixelShaderCode = pixelCode;
+
+        // Sources are copied by the driver when shader is created (even the asynchronous one)
+        Shader* variant = async ? m_context->CreateShaderAsync(description) : m_context->CreateShader(description);
+
+        char* stages[3] = {vertexCode, geometryCode, pixelCode};
+
+        for (char* code : stages)
+        {
+            if (code != nullptr)
+                m_allocator->FreeMemory(code);
+        }
+
+        return variant;
+    }
+
+    Uint64 ShaderLibrary::AddProgram(const ShaderData& data, const VertexLayout& layout)
+    {
+        Uint64 hash = HashShaderDesc({data, layout});
+
+        for (Uint64 i = 0; i < m_programCount; i++)
+        {
+            const ProgramEntry& entry = m_programs[i];
+
+            if (entry.Hash == hash && CompareShaderData(entry.Data, data) && CompareVertexLayouts(entry.Layout, layout))
+                return i;
+        }
+
+        if (m_programCount == m_programCapacity)
+        {
+            Uint64 newCapacity = m_programCapacity * 2;
+
+            auto newPrograms = AllocateArray<ProgramEntry>(m_allocator, newCapacity);
+            CopyMemory(newPrograms, m_programs, m_programCount * sizeof(ProgramEntry));
+
+            m_allocator->FreeMemory(m_programs);
+
+            m_programs = newPrograms;
+            m_programCapacity = newCapacity;
+        }
+
+        m_programs[m_programCount] = {hash, data, layout};
+
+        return m_programCount++;
+    }
+
+    Shader* ShaderLibrary::GetVariant(Uint64 program, Uint64 features)
+    {
+        if (program >= m_programCount)
+            return nullptr;
+
+        features = ClampFeatures(features);
+
+        Uint64 key = HashMemory(&features, sizeof(features), m_programs[program].Hash);
+        VariantEntry* entry = FindVariant(key, program, features);
+
+        if (entry->Used)
+        {
+            // Warmed up variant is checked when it's needed for the first time
+            if (entry->Variant != nullptr && !m_context->IsShaderLinked(entry->Variant))
+            {
+                m_context->ReleaseShader(entry->Variant);
+                entry->Variant = nullptr;
+            }
+
+            return entry->Variant;
+        }
+
+        Shader* variant = CreateVariant(m_programs[program], features, false);
+        InsertVariant(key, program, features, variant);
+
+        return variant;
+    }
+
+    void ShaderLibrary::WarmUp(Uint64 program, const Uint64* featureMasks, Uint64 maskCount)
+    {
+        if (program >= m_programCount || featureMasks == nullptr)
+            return;
+
+        for (Uint64 i = 0; i < maskCount; i++)
+        {
+            Uint64 features = ClampFeatures(featureMasks[i]);
+
+            Uint64 key = HashMemory(&features, sizeof(features), m_programs[program].Hash);
+
+            if (FindVariant(key, program, features)->Used)
+                continue;
+
+            Shader* variant = CreateVariant(m_programs[program], features, true);
+            InsertVariant(key, program, features, variant);
+        }
+    }
+
+    bool ShaderLibrary::IsWarmedUp() const
+    {
+        bool ready = true;
+
+        // Every variant is polled, so finished ones are completed even if some other isn't ready
+        for (Uint64 i = 0; i < m_variantCapacity; i++)
+        {
+            if (m_variants[i].Variant != nullptr && !m_context->IsShaderReady(m_variants[i].Variant))
+                ready = false;
+        }
+
+        return ready;
+    }
+
+    Uint64 ShaderLibrary::GetProgramCount() const
+    {
+        return m_programCount;
+    }
+
+    Uint64 ShaderLibrary::GetVariantCount() const
+    {
+        return m_variantCount;
+    }
+}
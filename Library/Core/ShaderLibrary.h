@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Tiny3D
+{
+    static constexpr Uint64 MaxShaderFeatures = 64;
+
+    // Builds variants of shader programs from one set of sources. Bit i of feature mask adds
+    // "#define <name of feature i> 1" right after #version line of every GLSL stage (SPIR-V stages are taken
+    // as they are, their features are given by specialization constants).
+    // Programs with the same sources and layout are added once, variants are compiled on the first use
+    // (or beforehand by WarmUp) and are released together with the library
+    class ShaderLibrary
+    {
+    private:
+        struct ProgramEntry
+        {
+            Uint64 Hash;
+            ShaderData Data;
+            VertexLayout Layout;
+        };
+
+        // Key is only the hash, entry is found by program and features. Variant which failed to compile
+        // is kept as used entry without shader, so it isn't compiled again
+        struct VariantEntry
+        {
+            Uint64 Key;
+            Uint64 Program;
+            Uint64 Features;
+
+            Shader* Variant;
+            bool Used;
+        };
+
+        GraphicsContext* m_context;
+
+        const char* const* m_featureNames;
+        Uint64 m_featureCount;
+
+        ProgramEntry* m_programs;
+        Uint64 m_programCount;
+        Uint64 m_programCapacity;
+
+        // Open addressing by key of program and mask
+        VariantEntry* m_variants;
+        Uint64 m_variantCount;
+        Uint64 m_variantCapacity;
+
+        Allocator* m_allocator;
+
+        // Returns entry of the variant or empty entry where it goes
+        VariantEntry* FindVariant(Uint64 key, Uint64 program, Uint64 features) const;
+        void InsertVariant(Uint64 key, Uint64 program, Uint64 features, Shader* variant);
+        void GrowVariants();
+
+        Uint64 ClampFeatures(Uint64 features) const;
+
+        // Returns stage code with defines of the mask, or nullptr when stage is missing
+        char* MakeVariantCode(const char* code, Uint64 features) const;
+
+        Shader* CreateVariant(const ProgramEntry& program, Uint64 features, bool async);
+
+    public:
+        // Names of features aren't copied, so they have to live as long as the library
+        ShaderLibrary(GraphicsContext* context, Allocator* allocator, const char* const* featureNames,
+                      Uint64 featureCount);
+        ~ShaderLibrary();
+
+        ShaderLibrary(const ShaderLibrary&) = delete;
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+        // Returns index of program. Sources are copied into variants when they are built,
+        // so they have to live as long as the library (inputs of layout too)
+        Uint64 AddProgram(const ShaderData& data, const VertexLayout& layout);
+
+        // Compiles variant right away if it wasn't built or warmed up before.
+        // Returns nullptr for variant which failed to compile or link (it isn't compiled again)
+        Shader* GetVariant(Uint64 program, Uint64 features);
+
+        // Starts asynchronous compilation of the variants which weren't built yet (during loading screens)
+        void WarmUp(Uint64 program, const Uint64* featureMasks, Uint64 maskCount);
+
+        // True when all of the variants which were built or warmed up can be used without waiting
+        bool IsWarmedUp() const;
+
+        Uint64 GetProgramCount() const;
+        Uint64 GetVariantCount() const;
+    };
+}
@@ -0,0 +1,409 @@
+#include "VertexFormat.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace Tiny3D
+{
+    namespace
+    {
+        struct InternedVertexLayout
+        {
+            Uint64 Hash;
+            VertexLayout Layout;
+            VertexInputElement Elements[MaxVertexElements];
+        };
+
+        std::mutex internedLayoutsMutex;
+
+        InternedVertexLayout** internedLayouts = nullptr;
+        Uint64 internedLayoutsCount = 0;
+        Uint64 internedLayoutsCapacity = 0;
+
+        // Layouts can be made during static initialization, so allocator is created on the first use
+        Allocator& GetInternedLayoutsAllocator()
+        {
+            static Allocator allocator = CreateStandardAllocator();
+            return allocator;
+        }
+
+        struct CodeWriter
+        {
+            char* Code;
+            Uint64 Capacity;
+            Uint64 Length;
+        };
+
+        void WriteCode(CodeWriter& writer, const char* format, ...)
+        {
+            char* cursor = nullptr;
+            Uint64 space = 0;
+
+            if (writer.Length < writer.Capacity)
+            {
+                cursor = writer.Code + writer.Length;
+                space = writer.Capacity - writer.Length;
+            }
+
+            va_list arguments;
+            va_start(arguments, format);
+
+            Int32 written = vsnprintf(cursor, space, format, arguments);
+
+            va_end(arguments);
+
+            if (written > 0)
+                writer.Length += written;
+        }
+
+        // Readers of bytes, shorts and words from storage buffer of uints. Aligned ones take one load
+        const char* VertexPullingReadersCode = R"(
+layout(std430, binding = %u) readonly buffer VertexPullingData { uint vertexPullingData[]; };
+
+uint PullByte(uint offset) { return bitfieldExtract(vertexPullingData[offset >> 2u], int(offset & 3u) * 8, 8); }
+uint PullShort(uint offset) { return PullByte(offset) | (PullByte(offset + 1u) << 8u); }
+uint PullWord(uint offset) { return PullShort(offset) | (PullShort(offset + 2u) << 16u); }
+
+uint PullAlignedShort(uint offset) { return bitfieldExtract(vertexPullingData[offset >> 2u], int(offset & 2u) * 8, 16); }
+uint PullAlignedWord(uint offset) { return vertexPullingData[offset >> 2u]; }
+
+)";
+
+        // Component of element as float, the same as fixed-function fetch gives for glVertexAttribPointer
+        void WritePulledComponent(CodeWriter& writer, const VertexInputElement& element, const char* base,
+                                  Uint64 offset, bool aligned)
+        {
+            auto byteOffset = static_cast<unsigned long long>(offset);
+
+            const char* wordReader = aligned ? "PullAlignedWord" : "PullWord";
+
+            if (element.Type == DataTypes::Float32)
+            {
+                WriteCode(writer, "uintBitsToFloat(%s(%s + %lluu))", wordReader, base, byteOffset);
+                return;
+            }
+
+            if (element.Type == DataTypes::Float64)
+            {
+                WriteCode(writer, "float(packDouble2x32(uvec2(%s(%s + %lluu), %s(%s + %lluu))))",
+                          wordReader, base, byteOffset, wordReader, base, byteOffset + 4);
+                return;
+            }
+
+            const char* reader = "PullByte";
+            Uint64 bits = 8;
+
+            if (element.Type == DataTypes::UnsignedShort || element.Type == DataTypes::SignedShort)
+            {
+                reader = aligned ? "PullAlignedShort" : "PullShort";
+                bits = 16;
+            }
+
+            else if (element.Type == DataTypes::UnsignedInt || element.Type == DataTypes::SignedInt)
+            {
+                reader = wordReader;
+                bits = 32;
+            }
+
+            bool signedType = element.Type == DataTypes::SignedByte || element.Type == DataTypes::SignedShort ||
+                              element.Type == DataTypes::SignedInt;
+
+            char value[96];
+
+            if (!signedType)
+                snprintf(value, sizeof(value), "%s(%s + %lluu)", reader, base, byteOffset);
+            else if (bits == 32)
+                snprintf(value, sizeof(value), "int(%s(%s + %lluu))", reader, base, byteOffset);
+            else
+                snprintf(value, sizeof(value), "bitfieldExtract(int(%s(%s + %lluu)), 0, %d)", reader, base,
+                         byteOffset, static_cast<Int32>(bits));
+
+            // Signed values are normalized as in OpenGL 4.2 and later
+            auto unsignedMax = static_cast<unsigned long long>((1ull << bits) - 1);
+            auto signedMax = static_cast<unsigned long long>((1ull << (bits - 1)) - 1);
+
+            if (!element.Normalized)
+                WriteCode(writer, "float(%s)", value);
+            else if (!signedType)
+                WriteCode(writer, "float(%s) / %llu.0", value, unsignedMax);
+            else
+                WriteCode(writer, "max(float(%s) / %llu.0, -1.0)", value, signedMax);
+        }
+
+        bool CompareNames(const char* first, const char* second)
+        {
+            if (first == nullptr || second == nullptr)
+                return first == second;
+
+            return strcmp(first, second) == 0;
+        }
+    }
+
+    Uint64 GetVertexElementOffset(const VertexLayout& layout, Uint64 index)
+    {
+        Uint64 offset = 0;
+
+        for (Uint64 i = 0; i < layout.Count && i <= index; i++)
+        {
+            const VertexInputElement& element = layout.Inputs[i];
+
+            if (element.Offset != VertexElementAutoOffset)
+                offset = element.Offset;
+
+            if (i == index)
+                break;
+
+            offset += element.Count * DataTypeSizes[ENUM_VALUE(element.Type)];
+        }
+
+        return offset;
+    }
+
+    Uint64 GetPackedVertexSize(const VertexLayout& layout)
+    {
+        if (layout.Precomputed)
+            return layout.Stride;
+
+        Uint64 size = 0;
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+        {
+            const VertexInputElement& element = layout.Inputs[i];
+            Uint64 elementEnd = GetVertexElementOffset(layout, i) + element.Count * DataTypeSizes[ENUM_VALUE(element.Type)];
+
+            size = MAX(size, elementEnd);
+        }
+
+        return size;
+    }
+
+    bool ValidateVertexLayout(const VertexLayout& layout, Uint64 vertexSize)
+    {
+        if (layout.Count > MaxVertexElements)
+            return false;
+
+        if (layout.Count != 0 && layout.Inputs == nullptr)
+            return false;
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+        {
+            const VertexInputElement& element = layout.Inputs[i];
+
+            if (ENUM_VALUE(element.Type) > ENUM_VALUE(DataTypes::Float64))
+                return false;
+
+            if (element.Count == 0 || element.Count > 4)
+                return false;
+
+            Uint64 elementEnd = GetVertexElementOffset(layout, i) + element.Count * DataTypeSizes[ENUM_VALUE(element.Type)];
+
+            if (elementEnd > vertexSize)
+                return false;
+        }
+
+        return true;
+    }
+
+    Uint64 HashVertexLayout(const VertexLayout& layout)
+    {
+        Uint64 hash = HashMemory(&layout.Count, sizeof(layout.Count));
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+        {
+            const VertexInputElement& element = layout.Inputs[i];
+
+            Uint64 offset = GetVertexElementOffset(layout, i);
+            Uint64 normalized = element.Normalized;
+
+            hash = HashString(element.Name, hash);
+            hash = HashMemory(&element.Type, sizeof(element.Type), hash);
+            hash = HashMemory(&element.Count, sizeof(element.Count), hash);
+            hash = HashMemory(&normalized, sizeof(normalized), hash);
+            hash = HashMemory(&offset, sizeof(offset), hash);
+            hash = HashMemory(&element.InstanceStepRate, sizeof(element.InstanceStepRate), hash);
+        }
+
+        return hash;
+    }
+
+    bool CompareVertexLayouts(const VertexLayout& first, const VertexLayout& second)
+    {
+        if (first.Count != second.Count)
+            return false;
+
+        if (first.Inputs == second.Inputs)
+            return true;
+
+        for (Uint64 i = 0; i < first.Count; i++)
+        {
+            const VertexInputElement& firstElement = first.Inputs[i];
+            const VertexInputElement& secondElement = second.Inputs[i];
+
+            if (firstElement.Type != secondElement.Type || firstElement.Count != secondElement.Count)
+                return false;
+
+            if (firstElement.Normalized != secondElement.Normalized)
+                return false;
+
+            if (firstElement.InstanceStepRate != secondElement.InstanceStepRate)
+                return false;
+
+            if (GetVertexElementOffset(first, i) != GetVertexElementOffset(second, i))
+                return false;
+
+            if (!CompareNames(firstElement.Name, secondElement.Name))
+                return false;
+        }
+
+        return true;
+    }
+
+    VertexLayout InternVertexLayout(const VertexLayout& layout)
+    {
+        if (layout.Count > MaxVertexElements)
+            return layout;
+
+        Uint64 hash = HashVertexLayout(layout);
+
+        std::lock_guard<std::mutex> lock(internedLayoutsMutex);
+        Allocator& allocator = GetInternedLayoutsAllocator();
+
+        for (Uint64 i = 0; i < internedLayoutsCount; i++)
+        {
+            InternedVertexLayout* interned = internedLayouts[i];
+
+            if (interned->Hash == hash && interned->Layout.Stride == layout.Stride &&
+                CompareVertexLayouts(interned->Layout, layout))
+                return interned->Layout;
+        }
+
+        if (internedLayoutsCount == internedLayoutsCapacity)
+        {
+            Uint64 newCapacity = MAX(internedLayoutsCapacity * 2, 16);
+
+            auto newLayouts = reinterpret_cast<InternedVertexLayout**>(
+                    allocator.AllocateMemory(newCapacity * sizeof(InternedVertexLayout*)));
+            CopyMemory(newLayouts, internedLayouts, internedLayoutsCount * sizeof(InternedVertexLayout*));
+
+            if (internedLayouts != nullptr)
+                allocator.FreeMemory(internedLayouts);
+
+            internedLayouts = newLayouts;
+            internedLayoutsCapacity = newCapacity;
+        }
+
+        auto interned = reinterpret_cast<InternedVertexLayout*>(
+                allocator.AllocateMemory(sizeof(InternedVertexLayout)));
+
+        interned->Hash = hash;
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+        {
+            interned->Elements[i] = layout.Inputs[i];
+            interned->Elements[i].Offset = GetVertexElementOffset(layout, i);
+
+            // Names are copied, so the layout doesn't depend on the strings which were given
+            const char* name = layout.Inputs[i].Name;
+
+            if (name != nullptr)
+            {
+                Uint64 nameSize = strlen(name) + 1;
+
+                auto nameCopy = reinterpret_cast<char*>(allocator.AllocateMemory(nameSize));
+                memcpy(nameCopy, name, nameSize);
+
+                interned->Elements[i].Name = nameCopy;
+            }
+        }
+
+        interned->Layout = layout;
+        interned->Layout.Inputs = interned->Elements;
+
+        internedLayouts[internedLayoutsCount] = interned;
+        internedLayoutsCount++;
+
+        return interned->Layout;
+    }
+
+    Uint64 MakeVertexPullingCode(const VertexLayout& layout, Uint64 vertexSize, char* code, Uint64 capacity)
+    {
+        static const char* VectorTypes[4] = {"float", "vec2", "vec3", "vec4"};
+
+        CodeWriter writer = {code, capacity, 0};
+
+        if (code != nullptr && capacity != 0)
+            code[0] = '\0';
+
+        if (!ValidateVertexLayout(layout, vertexSize))
+            return 0;
+
+        // Unnamed elements are named by their index. Cut name would declare another variable, so long names
+        // aren't accepted
+        char names[MaxVertexElements][MaxPulledNameLength + 1];
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+        {
+            if (layout.Inputs[i].Name != nullptr)
+            {
+                if (strlen(layout.Inputs[i].Name) > MaxPulledNameLength)
+                    return 0;
+
+                strcpy(names[i], layout.Inputs[i].Name);
+            }
+
+            else
+                snprintf(names[i], sizeof(names[i]), "element%llu", static_cast<unsigned long long>(i));
+        }
+
+        WriteCode(writer, VertexPullingReadersCode, VertexPullingBinding);
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+            WriteCode(writer, "%s %s;\n", VectorTypes[layout.Inputs[i].Count - 1], names[i]);
+
+        WriteCode(writer, "\nvoid PullVertex()\n{\n");
+        WriteCode(writer, "    uint vertexOffset = uint(gl_VertexID) * %lluu;\n",
+                  static_cast<unsigned long long>(vertexSize));
+
+        for (Uint64 i = 0; i < layout.Count; i++)
+        {
+            const VertexInputElement& element = layout.Inputs[i];
+
+            Uint64 offset = GetVertexElementOffset(layout, i);
+            Uint64 componentSize = DataTypeSizes[ENUM_VALUE(element.Type)];
+
+            // Doubles are read by words
+            Uint64 alignment = MIN(componentSize, 4);
+            bool aligned = (offset % alignment == 0) && (vertexSize % alignment == 0);
+
+            // Elements with step rate are read by instance from the start of buffer, as divisor does it
+            char base[sizeof("instanceOffset") + 20] = "vertexOffset";
+
+            if (element.InstanceStepRate != 0)
+            {
+                snprintf(base, sizeof(base), "instanceOffset%llu", static_cast<unsigned long long>(i));
+
+                WriteCode(writer, "    uint %s = uint(gl_InstanceID) / %lluu * %lluu;\n", base,
+                          static_cast<unsigned long long>(element.InstanceStepRate),
+                          static_cast<unsigned long long>(vertexSize));
+            }
+
+            WriteCode(writer, "    %s = %s(", names[i], VectorTypes[element.Count - 1]);
+
+            for (Uint64 component = 0; component < element.Count; component++)
+            {
+                if (component != 0)
+                    WriteCode(writer, ", ");
+
+                WritePulledComponent(writer, element, base, offset + component * componentSize, aligned);
+            }
+
+            WriteCode(writer, ");\n");
+        }
+
+        WriteCode(writer, "}\n");
+
+        return writer.Length;
+    }
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "Graphics.h"
+
+#include <type_traits>
+
+namespace Tiny3D
+{
+    // Maximal count of elements in one vertex layout (it's also the minimal count of vertex attributes in OpenGL)
+    static constexpr Uint64 MaxVertexElements = 16;
+
+    // Binding point of storage buffer which vertex pulling code reads vertices from
+    static constexpr Uint32 VertexPullingBinding = 7;
+
+    // Longest name of element which vertex pulling code declares
+    static constexpr Uint64 MaxPulledNameLength = 63;
+
+    // Maps C++ type of vertex member onto element type and element count.
+    // Specialize it for your own math types (vectors, colors) to use them with MakeVertexLayout
+    template <typename t>
+    struct VertexElementTraits;
+
+    template <>
+    struct VertexElementTraits<Uint8>
+    {
+        static constexpr DataTypes Type = DataTypes::UnsignedByte;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Int8>
+    {
+        static constexpr DataTypes Type = DataTypes::SignedByte;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Uint16>
+    {
+        static constexpr DataTypes Type = DataTypes::UnsignedShort;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Int16>
+    {
+        static constexpr DataTypes Type = DataTypes::SignedShort;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Uint32>
+    {
+        static constexpr DataTypes Type = DataTypes::UnsignedInt;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Int32>
+    {
+        static constexpr DataTypes Type = DataTypes::SignedInt;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Float32>
+    {
+        static constexpr DataTypes Type = DataTypes::Float32;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <>
+    struct VertexElementTraits<Float64>
+    {
+        static constexpr DataTypes Type = DataTypes::Float64;
+        static constexpr Uint64 Count = 1;
+    };
+
+    template <typename t, Uint64 count>
+    struct VertexElementTraits<t[count]>
+    {
+        static constexpr DataTypes Type = VertexElementTraits<t>::Type;
+        static constexpr Uint64 Count = VertexElementTraits<t>::Count * count;
+    };
+
+    // Member of vertex struct with a shader attribute name and normalization flag.
+    // Raw member pointers can be given to MakeVertexLayout too, then the element has no name
+    template <typename vertex, typename member>
+    struct VertexAttribute
+    {
+        member vertex::* Member;
+
+        const char* Name;
+        bool Normalized;
+    };
+
+    template <typename vertex, typename member>
+    constexpr VertexAttribute<vertex, member> MakeVertexAttribute(member vertex::* pointer, const char* name,
+                                                                  bool normalized = false)
+    {
+        return {pointer, name, normalized};
+    }
+
+    // Packed offset of element (used for layouts which were made by hand)
+    Uint64 GetVertexElementOffset(const VertexLayout& layout, Uint64 index);
+    Uint64 GetPackedVertexSize(const VertexLayout& layout);
+
+    // Checks layouts made at runtime. Precomputed layouts don't need it
+    bool ValidateVertexLayout(const VertexLayout& layout, Uint64 vertexSize);
+
+    Uint64 HashVertexLayout(const VertexLayout& layout);
+    bool CompareVertexLayouts(const VertexLayout& first, const VertexLayout& second);
+
+    // Writes GLSL code (it needs #version 430) which reads vertices of the layout from storage buffer:
+    // global variable for every element (unnamed ones are called elementN) and PullVertex(), which fills them
+    // for gl_VertexID (elements with step rate use gl_InstanceID). It replaces "in" declarations of vertex shader
+    // and PullVertex() is called at the start of main. Returns length of the code without terminating zero,
+    // the code is cut by capacity (so nullptr and zero capacity give the length only). Invalid layout or name
+    // longer than MaxPulledNameLength give zero
+    Uint64 MakeVertexPullingCode(const VertexLayout& layout, Uint64 vertexSize, char* code, Uint64 capacity);
+
+    // Returns the layout which refers to the shared copy of elements.
+    // Identical layouts always share the same elements (so they can be compared by Inputs pointer)
+    VertexLayout InternVertexLayout(const VertexLayout& layout);
+
+    template <typename vertex, typename member>
+    Uint64 GetVertexMemberOffset(member vertex::* pointer)
+    {
+        // Pointer to member can't be turned into offset in constant expression,
+        // so it's taken from a dummy object (vertex is standard-layout so it's the same as offsetof)
+        alignas(vertex) static const Uint8 dummy[sizeof(vertex)] = {};
+
+        const vertex* object = reinterpret_cast<const vertex*>(dummy);
+        return reinterpret_cast<const Uint8*>(&(object->*pointer)) - dummy;
+    }
+
+    template <typename vertex, typename member>
+    VertexInputElement MakeVertexElement(member vertex::* pointer, const char* name, bool normalized)
+    {
+        using traits = VertexElementTraits<std::remove_cv_t<member>>;
+
+        static_assert(traits::Count >= 1 && traits::Count <= 4, "Vertex element has to contain from 1 to 4 components");
+        static_assert(sizeof(member) == traits::Count * DataTypeSizes[ENUM_VALUE(traits::Type)],
+                      "Vertex element type has padding inside");
+
+        VertexInputElement element = {name, traits::Type, traits::Count, normalized};
+        element.Offset = GetVertexMemberOffset(pointer);
+
+        return element;
+    }
+
+    template <typename vertex, typename member>
+    VertexInputElement MakeVertexElement(member vertex::* pointer)
+    {
+        return MakeVertexElement(pointer, nullptr, false);
+    }
+
+    template <typename vertex, typename member>
+    VertexInputElement MakeVertexElement(VertexAttribute<vertex, member> attribute)
+    {
+        return MakeVertexElement(attribute.Member, attribute.Name, attribute.Normalized);
+    }
+
+    // Builds layout from the members of vertex struct:
+    //  MakeVertexLayout<MyVertex>(&MyVertex::Position, MakeVertexAttribute(&MyVertex::Color, "aColor", true));
+    // Types, counts and stride are deduced at compile time, offsets are the real ones (with padding).
+    // The result is interned (names are copied), the layout of the first call is also cached by the function
+    template <typename vertex, typename... members>
+    VertexLayout MakeVertexLayout(members... attributes)
+    {
+        static_assert(std::is_standard_layout<vertex>::value, "Vertex type has to be standard-layout");
+        static_assert(sizeof...(members) >= 1 && sizeof...(members) <= MaxVertexElements,
+                      "Invalid count of vertex elements");
+
+        VertexInputElement elements[] = {MakeVertexElement<vertex>(attributes)...};
+
+        VertexLayout layout = {elements, sizeof...(members)};
+        layout.Stride = sizeof(vertex);
+        layout.Precomputed = true;
+
+        // Layout of the first call is kept by this instantiation, so the next calls with the same attributes
+        // don't go to the shared table (calls with other names or step rate still do)
+        static const VertexLayout cached = InternVertexLayout(layout);
+
+        if (CompareVertexLayouts(cached, layout))
+            return cached;
+
+        return InternVertexLayout(layout);
+    }
+
+    // The same as MakeVertexLayout, but all of the elements advance once per stepRate instances
+    // (layout of the instance buffer for DrawInstanced/DrawIndexedInstanced)
+    template <typename vertex, typename... members>
+    VertexLayout MakeInstanceLayout(Uint64 stepRate, members... attributes)
+    {
+        static_assert(std::is_standard_layout<vertex>::value, "Instance type has to be standard-layout");
+        static_assert(sizeof...(members) >= 1 && sizeof...(members) <= MaxVertexElements,
+                      "Invalid count of instance elements");
+
+        VertexInputElement elements[] = {MakeVertexElement<vertex>(attributes)...};
+
+        for (VertexInputElement& element : elements)
+            element.InstanceStepRate = MAX(stepRate, 1);
+
+        VertexLayout layout = {elements, sizeof...(members)};
+        layout.Stride = sizeof(vertex);
+        layout.Precomputed = true;
+
+        // Layout of the first call is kept by this instantiation, so the next calls with the same attributes
+        // don't go to the shared table (calls with other names or step rate still do)
+        static const VertexLayout cached = InternVertexLayout(layout);
+
+        if (CompareVertexLayouts(cached, layout))
+            return cached;
+
+        return InternVertexLayout(layout);
+    }
+}